@@ -0,0 +1,124 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Measures computeAngularSpeed latency while another thread hammers makeDiagnosticReport.
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/LocalisationIMUPlugin.hpp"
+
+namespace
+{
+
+const double IMU_RATE = 1000.;
+const size_t NUMBER_OF_SAMPLES = 200000;
+
+std::unique_ptr<romea::core::LocalisationIMUPlugin> makePlugin()
+{
+  auto imu = std::make_unique<romea::core::IMUAHRS>(
+    IMU_RATE,
+    0.0005, 0.02, 10.,
+    3.4907e-04 / 180. * M_PI, 3.4907e-02 / 180. * M_PI, 300. / 180. * M_PI,
+    7.e-09, 1.e-08, 0.000075,
+    0.01745);
+
+  return std::make_unique<romea::core::LocalisationIMUPlugin>(std::move(imu));
+}
+
+void printLatencies(const char * name, std::vector<double> & latencies)
+{
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](const double & p) {
+      return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+
+  std::printf(
+    "%-24s p50 %8.0f ns  p99 %8.0f ns  p99.9 %8.0f ns  max %10.0f ns\n",
+    name, percentile(0.5), percentile(0.99), percentile(0.999), latencies.back());
+}
+
+void run(const char * name, const size_t & numberOfReaders)
+{
+  auto plugin = makePlugin();
+
+  std::default_random_engine generator(0);
+  std::normal_distribution<double> accelerationDistribution(0, 0.0005 * std::sqrt(IMU_RATE));
+  std::normal_distribution<double> angularSpeedDistribution(0, 6.e-06 * std::sqrt(IMU_RATE));
+
+  std::atomic<bool> stop(false);
+  std::atomic<int64_t> lastStamp(0);
+  std::vector<std::thread> readers;
+  for (size_t n = 0; n < numberOfReaders; ++n) {
+    readers.emplace_back(
+      [&]() {
+        while (!stop.load()) {
+          auto report = plugin->makeDiagnosticReport(romea::core::Duration(lastStamp.load()));
+        }
+      });
+  }
+
+  std::vector<double> latencies;
+  latencies.reserve(NUMBER_OF_SAMPLES);
+  romea::core::ObservationAngularSpeed angularSpeed;
+
+  for (size_t n = 0; n < NUMBER_OF_SAMPLES; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / IMU_RATE);
+    if (n % 100 == 0) {
+      plugin->processLinearSpeed(stamp, 0.);
+    }
+
+    double ax = accelerationDistribution(generator);
+    double ay = accelerationDistribution(generator);
+    double az = accelerationDistribution(generator) + 9.81;
+    double wx = angularSpeedDistribution(generator);
+    double wy = angularSpeedDistribution(generator);
+    double wz = angularSpeedDistribution(generator);
+
+    auto start = std::chrono::steady_clock::now();
+    plugin->computeAngularSpeed(stamp, ax, ay, az, wx, wy, wz, angularSpeed);
+    auto end = std::chrono::steady_clock::now();
+
+    latencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    lastStamp.store(stamp.count());
+  }
+
+  stop.store(true);
+  for (auto & reader : readers) {
+    reader.join();
+  }
+
+  printLatencies(name, latencies);
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+int main()
+{
+  run("no reader", 0);
+  run("one reader", 1);
+  run("two readers", 2);
+  return 0;
+}
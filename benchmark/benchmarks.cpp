@@ -0,0 +1,640 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// benchmark
+#include <benchmark/benchmark.h>
+
+// std
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/AllanVariance.hpp"
+#include "romea_core_localisation_imu/AngularSpeedIntegrator.hpp"
+#include "romea_core_localisation_imu/AttitudePropagator.hpp"
+#include "romea_core_localisation_imu/LocalisationIMUPlugin.hpp"
+#include "romea_core_localisation_imu/LocalisationMultiIMUPlugin.hpp"
+#include "romea_core_localisation_imu/SessionReader.hpp"
+#include "romea_core_localisation_imu/SessionWriter.hpp"
+#include "romea_core_localisation_imu/SpikeFilter.hpp"
+
+// local
+#include "allocation_counter.hpp"
+
+namespace
+{
+
+const size_t NUMBER_OF_PRECOMPUTED_SAMPLES = 4096;
+const size_t NUMBER_OF_PRECOMPUTED_BURSTS = 16384;
+
+//-----------------------------------------------------------------------------
+struct Samples
+{
+  explicit Samples(const double & rate)
+  : accelerations(),
+    angularSpeeds(),
+    attitudes()
+  {
+    std::default_random_engine generator(0);
+    std::normal_distribution<double> accelerationDistribution(0, 0.0005 * std::sqrt(rate));
+    std::normal_distribution<double> angularSpeedDistribution(0, 6.e-06 * std::sqrt(rate));
+    std::normal_distribution<double> attitudeDistribution(0, 0.01745);
+
+    for (size_t n = 0; n < NUMBER_OF_PRECOMPUTED_SAMPLES; ++n) {
+      accelerations.push_back(
+        {accelerationDistribution(generator),
+          accelerationDistribution(generator),
+          accelerationDistribution(generator) + 9.81});
+      angularSpeeds.push_back(
+        {angularSpeedDistribution(generator),
+          angularSpeedDistribution(generator),
+          angularSpeedDistribution(generator)});
+      attitudes.push_back(
+        {attitudeDistribution(generator),
+          attitudeDistribution(generator),
+          attitudeDistribution(generator)});
+    }
+  }
+
+  std::vector<romea::core::AccelerationsFrame> accelerations;
+  std::vector<romea::core::AngularSpeedsFrame> angularSpeeds;
+  std::vector<romea::core::RollPitchCourseFrame> attitudes;
+};
+
+// default pipeline with stage timings
+struct TimedStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool LATENCY_HISTOGRAMS = true;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Stages = romea::core::LocalisationIMUPluginStages>
+std::unique_ptr<romea::core::BasicLocalisationIMUPlugin<Stages>> makePlugin(const double & rate)
+{
+  auto imu = std::make_unique<romea::core::IMUAHRS>(
+    rate,
+    0.0005, 0.02, 10.,
+    3.4907e-04 / 180. * M_PI, 3.4907e-02 / 180. * M_PI, 300. / 180. * M_PI,
+    7.e-09, 1.e-08, 0.000075,
+    0.01745);
+
+  return std::make_unique<romea::core::BasicLocalisationIMUPlugin<Stages>>(std::move(imu));
+}
+
+//-----------------------------------------------------------------------------
+// Feeds the plugin with standstill data until angular speed bias is available
+//-----------------------------------------------------------------------------
+template<typename Plugin>
+size_t warmUp(
+  Plugin & plugin,
+  const Samples & samples,
+  const double & rate)
+{
+  romea::core::ObservationAngularSpeed angularSpeed;
+  romea::core::ObservationAttitude attitude;
+
+  size_t n = 0;
+  for (; n < 10 * rate; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / rate);
+    const auto & a = samples.accelerations[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    const auto & w = samples.angularSpeeds[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    const auto & f = samples.attitudes[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+
+    if (n % static_cast<size_t>(rate / 10.) == 0) {
+      plugin.processLinearSpeed(stamp, 0.);
+    }
+
+    plugin.computeAngularSpeed(
+      stamp,
+      a.accelerationAlongXAxis, a.accelerationAlongYAxis, a.accelerationAlongZAxis,
+      w.angularSpeedAroundXAxis, w.angularSpeedAroundYAxis, w.angularSpeedAroundZAxis,
+      angularSpeed);
+
+    plugin.computeAttitude(stamp, f.rollAngle, f.pitchAngle, f.courseAngle, attitude);
+  }
+  return n;
+}
+
+//-----------------------------------------------------------------------------
+void setCounters(
+  benchmark::State & state,
+  const size_t & allocationsBefore,
+  const size_t & samplesPerIteration = 1)
+{
+  size_t numberOfSamples = static_cast<size_t>(state.iterations()) * samplesPerIteration;
+  state.SetItemsProcessed(numberOfSamples);
+  state.counters["allocs_per_sample"] = benchmark::Counter(
+    static_cast<double>(getNumberOfAllocations() - allocationsBefore) / numberOfSamples);
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+static void computeAngularSpeed(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  Samples samples(rate);
+  auto plugin = makePlugin<Stages>(rate);
+  size_t n = warmUp(*plugin, samples, rate);
+  romea::core::ObservationAngularSpeed angularSpeed;
+
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / rate);
+    const auto & a = samples.accelerations[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    const auto & w = samples.angularSpeeds[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    benchmark::DoNotOptimize(
+      plugin->computeAngularSpeed(
+        stamp,
+        a.accelerationAlongXAxis, a.accelerationAlongYAxis, a.accelerationAlongZAxis,
+        w.angularSpeedAroundXAxis, w.angularSpeedAroundYAxis, w.angularSpeedAroundZAxis,
+        angularSpeed));
+    ++n;
+  }
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK_TEMPLATE(computeAngularSpeed, romea::core::LocalisationIMUPluginStages)
+->Name("computeAngularSpeed")->Arg(100)->Arg(400)->Arg(1000);
+
+// cost of stage timings on the sample path
+BENCHMARK_TEMPLATE(computeAngularSpeed, TimedStages)
+->Name("computeAngularSpeedWithLatencyHistograms")->Arg(100)->Arg(1000);
+
+//-----------------------------------------------------------------------------
+// Same sample path with sample rates, heartbeats and report handled by a background thread.
+// Samples are produced faster than real time, the aggregator period is kept short so that
+// its queue does not overflow and samples are not rejected for a missing rate. Allocations
+// are not reported since the aggregator thread allocates the report strings meanwhile.
+//-----------------------------------------------------------------------------
+static void computeAngularSpeedWithDiagnosticAggregation(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  Samples samples(rate);
+  auto plugin = makePlugin(rate);
+  plugin->enableDiagnosticAggregation(romea::core::durationFromSecond(0.0005));
+  size_t n = warmUp(*plugin, samples, rate);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  romea::core::ObservationAngularSpeed angularSpeed;
+
+  size_t numberOfObservations = 0;
+  for (auto _ : state) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / rate);
+    const auto & a = samples.accelerations[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    const auto & w = samples.angularSpeeds[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    if (n % static_cast<size_t>(rate / 10.) == 0) {
+      plugin->processLinearSpeed(stamp, 0.);
+    }
+    numberOfObservations += plugin->computeAngularSpeed(
+      stamp,
+      a.accelerationAlongXAxis, a.accelerationAlongYAxis, a.accelerationAlongZAxis,
+      w.angularSpeedAroundXAxis, w.angularSpeedAroundYAxis, w.angularSpeedAroundZAxis,
+      angularSpeed);
+    ++n;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["observations_per_sample"] = benchmark::Counter(
+    static_cast<double>(numberOfObservations) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(computeAngularSpeedWithDiagnosticAggregation)->Arg(100)->Arg(1000);
+
+//-----------------------------------------------------------------------------
+static void computeAngularSpeeds(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  const size_t burstSize = state.range(1);
+  Samples samples(rate);
+  auto plugin = makePlugin(rate);
+  size_t n = warmUp(*plugin, samples, rate);
+
+  // bursts are generated before the timed loop, stamps keep increasing over every iteration
+  // while values are cycled over precomputed samples
+  std::vector<romea::core::Duration> stamps(NUMBER_OF_PRECOMPUTED_BURSTS * burstSize);
+  for (size_t k = 0; k < stamps.size(); ++k) {
+    stamps[k] = romea::core::durationFromSecond((n + k) / rate);
+  }
+  std::vector<double> channels[6];
+  for (auto & channel : channels) {
+    channel.resize(NUMBER_OF_PRECOMPUTED_SAMPLES);
+  }
+  for (size_t k = 0; k < NUMBER_OF_PRECOMPUTED_SAMPLES; ++k) {
+    const auto & a = samples.accelerations[k];
+    const auto & w = samples.angularSpeeds[k];
+    channels[0][k] = a.accelerationAlongXAxis;
+    channels[1][k] = a.accelerationAlongYAxis;
+    channels[2][k] = a.accelerationAlongZAxis;
+    channels[3][k] = w.angularSpeedAroundXAxis;
+    channels[4][k] = w.angularSpeedAroundYAxis;
+    channels[5][k] = w.angularSpeedAroundZAxis;
+  }
+  std::vector<romea::core::ObservationAngularSpeed> angularSpeeds(burstSize);
+  std::unique_ptr<bool[]> validities(new bool[burstSize]);
+
+  romea::core::InertialMeasurementsBatch measurements;
+  measurements.size = burstSize;
+
+  size_t offset = 0;
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    // burst sizes divide the number of precomputed samples
+    const size_t channelOffset = offset % NUMBER_OF_PRECOMPUTED_SAMPLES;
+    measurements.stamps = stamps.data() + offset;
+    measurements.accelerationsAlongXAxis = channels[0].data() + channelOffset;
+    measurements.accelerationsAlongYAxis = channels[1].data() + channelOffset;
+    measurements.accelerationsAlongZAxis = channels[2].data() + channelOffset;
+    measurements.angularSpeedsAroundXAxis = channels[3].data() + channelOffset;
+    measurements.angularSpeedsAroundYAxis = channels[4].data() + channelOffset;
+    measurements.angularSpeedsAroundZAxis = channels[5].data() + channelOffset;
+    offset += burstSize;
+
+    benchmark::DoNotOptimize(
+      plugin->computeAngularSpeeds(measurements, angularSpeeds.data(), validities.get()));
+  }
+  setCounters(state, allocationsBefore, burstSize);
+}
+BENCHMARK(computeAngularSpeeds)->ArgsProduct({{1000}, {8, 16, 32}})
+->Iterations(NUMBER_OF_PRECOMPUTED_BURSTS);
+
+//-----------------------------------------------------------------------------
+// One thread per IMU feeding a shared plugin, items per second should scale with the number
+// of threads as long as per IMU states do not share cache lines
+//-----------------------------------------------------------------------------
+namespace
+{
+
+const size_t MAXIMAL_NUMBER_OF_IMU_THREADS = 8;
+
+// shared by benchmark threads, built by setup before they start
+std::unique_ptr<Samples> multiIMUSamples;
+std::unique_ptr<romea::core::BasicLocalisationMultiIMUPlugin<TimedStages>> multiIMUPlugin;
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+static void setupMultiIMUPlugin(const benchmark::State & state)
+{
+  const double rate = state.range(0);
+  std::vector<std::unique_ptr<romea::core::IMUAHRS>> imus;
+  for (size_t k = 0; k < MAXIMAL_NUMBER_OF_IMU_THREADS; ++k) {
+    imus.push_back(
+      std::make_unique<romea::core::IMUAHRS>(
+        rate,
+        0.0005, 0.02, 10.,
+        3.4907e-04 / 180. * M_PI, 3.4907e-02 / 180. * M_PI, 300. / 180. * M_PI,
+        7.e-09, 1.e-08, 0.000075,
+        0.01745));
+  }
+  multiIMUSamples = std::make_unique<Samples>(rate);
+  multiIMUPlugin = std::make_unique<romea::core::BasicLocalisationMultiIMUPlugin<TimedStages>>(
+    std::move(imus));
+
+  // standstill data until angular speed bias is available for every IMU
+  romea::core::ObservationAngularSpeed angularSpeed;
+  for (size_t n = 0; n < 10 * rate; ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / rate);
+    const auto & a = multiIMUSamples->accelerations[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    const auto & w = multiIMUSamples->angularSpeeds[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    if (n % static_cast<size_t>(rate / 10.) == 0) {
+      multiIMUPlugin->processLinearSpeed(stamp, 0.);
+    }
+    for (size_t k = 0; k < MAXIMAL_NUMBER_OF_IMU_THREADS; ++k) {
+      multiIMUPlugin->computeAngularSpeed(
+        k, stamp,
+        a.accelerationAlongXAxis, a.accelerationAlongYAxis, a.accelerationAlongZAxis,
+        w.angularSpeedAroundXAxis, w.angularSpeedAroundYAxis, w.angularSpeedAroundZAxis,
+        angularSpeed);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+static void teardownMultiIMUPlugin(const benchmark::State &)
+{
+  multiIMUPlugin.reset();
+  multiIMUSamples.reset();
+}
+
+//-----------------------------------------------------------------------------
+static void computeAngularSpeedPerIMUThread(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  const size_t imuIndex = static_cast<size_t>(state.thread_index());
+  const Samples & samples = *multiIMUSamples;
+  romea::core::ObservationAngularSpeed angularSpeed;
+
+  // stamps go on from warm up, each thread owns its IMU stamps
+  size_t n = static_cast<size_t>(10 * rate);
+  for (auto _ : state) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / rate);
+    const auto & a = samples.accelerations[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    const auto & w = samples.angularSpeeds[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    benchmark::DoNotOptimize(
+      multiIMUPlugin->computeAngularSpeed(
+        imuIndex, stamp,
+        a.accelerationAlongXAxis, a.accelerationAlongYAxis, a.accelerationAlongZAxis,
+        w.angularSpeedAroundXAxis, w.angularSpeedAroundYAxis, w.angularSpeedAroundZAxis,
+        angularSpeed));
+    ++n;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(computeAngularSpeedPerIMUThread)->Arg(1000)
+->Setup(setupMultiIMUPlugin)->Teardown(teardownMultiIMUPlugin)
+->ThreadRange(1, MAXIMAL_NUMBER_OF_IMU_THREADS)->UseRealTime();
+
+//-----------------------------------------------------------------------------
+static void computeAttitude(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  Samples samples(rate);
+  auto plugin = makePlugin(rate);
+  size_t n = warmUp(*plugin, samples, rate);
+  romea::core::ObservationAttitude attitude;
+
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / rate);
+    const auto & f = samples.attitudes[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    benchmark::DoNotOptimize(
+      plugin->computeAttitude(stamp, f.rollAngle, f.pitchAngle, f.courseAngle, attitude));
+    ++n;
+  }
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(computeAttitude)->Arg(100)->Arg(400)->Arg(1000);
+
+//-----------------------------------------------------------------------------
+static void processLinearSpeed(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  auto plugin = makePlugin(1000.);
+
+  size_t n = 0;
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    plugin->processLinearSpeed(romea::core::durationFromSecond(n / rate), 0.);
+    ++n;
+  }
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(processLinearSpeed)->Arg(10)->Arg(100);
+
+//-----------------------------------------------------------------------------
+static void makeDiagnosticReport(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  Samples samples(rate);
+  auto plugin = makePlugin(rate);
+  size_t n = warmUp(*plugin, samples, rate);
+  romea::core::Duration stamp = romea::core::durationFromSecond(n / rate);
+
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(plugin->makeDiagnosticReport(stamp));
+  }
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(makeDiagnosticReport)->Arg(1000);
+
+//-----------------------------------------------------------------------------
+// Reports interleaved with inertial measurements, only the sections they update are rebuilt.
+// Both calls are timed, pausing timers around each sample would cost more than the report:
+// report cost is the difference with computeAngularSpeed at the same rate.
+//-----------------------------------------------------------------------------
+static void makeDiagnosticReportAfterInertialMeasurement(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  Samples samples(rate);
+  auto plugin = makePlugin(rate);
+  size_t n = warmUp(*plugin, samples, rate);
+  romea::core::ObservationAngularSpeed angularSpeed;
+
+  for (auto _ : state) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(n / rate);
+    const auto & a = samples.accelerations[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    const auto & w = samples.angularSpeeds[n % NUMBER_OF_PRECOMPUTED_SAMPLES];
+    plugin->computeAngularSpeed(
+      stamp,
+      a.accelerationAlongXAxis, a.accelerationAlongYAxis, a.accelerationAlongZAxis,
+      w.angularSpeedAroundXAxis, w.angularSpeedAroundYAxis, w.angularSpeedAroundZAxis,
+      angularSpeed);
+    ++n;
+
+    benchmark::DoNotOptimize(plugin->makeDiagnosticReport(stamp));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(makeDiagnosticReportAfterInertialMeasurement)->Arg(1000);
+
+//-----------------------------------------------------------------------------
+static void checkupAttitudeEvaluate(benchmark::State & state)
+{
+  Samples samples(1000.);
+  romea::core::CheckupAttitude checkup;
+
+  size_t n = 0;
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      checkup.evaluate(samples.attitudes[n++ % NUMBER_OF_PRECOMPUTED_SAMPLES]));
+  }
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(checkupAttitudeEvaluate);
+
+//-----------------------------------------------------------------------------
+static void checkupInertialMeasurementsEvaluate(benchmark::State & state)
+{
+  Samples samples(1000.);
+  romea::core::CheckupInertialMeasurements checkup(10., 300. / 180. * M_PI);
+
+  size_t n = 0;
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    size_t index = n++ % NUMBER_OF_PRECOMPUTED_SAMPLES;
+    benchmark::DoNotOptimize(
+      checkup.evaluate(samples.accelerations[index], samples.angularSpeeds[index]));
+  }
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(checkupInertialMeasurementsEvaluate);
+
+//-----------------------------------------------------------------------------
+// float windows halve the memory traffic of the estimator
+template<typename Scalar>
+static void angularSpeedBiasEvaluate(benchmark::State & state)
+{
+  const double rate = state.range(0);
+  Samples samples(rate);
+  romea::core::BasicAngularSpeedBias<Scalar> angularSpeedBias(
+    rate, 0.0005 * std::sqrt(rate), 6.e-06 * std::sqrt(rate));
+
+  size_t n = 0;
+  for (; n < 10 * rate; ++n) {
+    size_t index = n % NUMBER_OF_PRECOMPUTED_SAMPLES;
+    angularSpeedBias.evaluate(0., samples.accelerations[index], samples.angularSpeeds[index]);
+  }
+
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    size_t index = n++ % NUMBER_OF_PRECOMPUTED_SAMPLES;
+    benchmark::DoNotOptimize(
+      angularSpeedBias.evaluate(0., samples.accelerations[index], samples.angularSpeeds[index]));
+  }
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK_TEMPLATE(angularSpeedBiasEvaluate, double)->Arg(100)->Arg(400)->Arg(1000);
+BENCHMARK_TEMPLATE(angularSpeedBiasEvaluate, float)->Arg(100)->Arg(400)->Arg(1000);
+
+//-----------------------------------------------------------------------------
+static void allanVarianceUpdate(benchmark::State & state)
+{
+  Samples samples(100);
+  romea::core::AllanVariance allanVariance(0.01);
+
+  size_t n = 0;
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    size_t index = n++ % NUMBER_OF_PRECOMPUTED_SAMPLES;
+    allanVariance.update(samples.angularSpeeds[index].angularSpeedAroundZAxis);
+  }
+  benchmark::DoNotOptimize(allanVariance.getVariance(0));
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(allanVarianceUpdate);
+
+//-----------------------------------------------------------------------------
+static void attitudePropagatorPropagate(benchmark::State & state)
+{
+  Samples samples(100);
+  romea::core::AttitudePropagator attitudePropagator(100., 1.e-4, 1.e-6);
+
+  // attitude frame every ten samples
+  size_t n = 0;
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    size_t index = n % NUMBER_OF_PRECOMPUTED_SAMPLES;
+    if (n % 10 == 0) {
+      attitudePropagator.setAttitude(
+        romea::core::durationFromSecond(n * 0.01),
+        samples.attitudes[index].rollAngle,
+        samples.attitudes[index].pitchAngle);
+    }
+    benchmark::DoNotOptimize(attitudePropagator.propagate(
+        romea::core::durationFromSecond(++n * 0.01), samples.angularSpeeds[index], 0.));
+  }
+  benchmark::DoNotOptimize(attitudePropagator.getRollAngle());
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(attitudePropagatorPropagate);
+
+//-----------------------------------------------------------------------------
+static void angularSpeedIntegratorIntegrate(benchmark::State & state)
+{
+  Samples samples(100);
+  romea::core::AngularSpeedIntegrator angularSpeedIntegrator(100., 1.e-6);
+
+  size_t n = 0;
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    size_t index = n % NUMBER_OF_PRECOMPUTED_SAMPLES;
+    angularSpeedIntegrator.integrate(
+      romea::core::durationFromSecond(++n * 0.01), samples.angularSpeeds[index], 0.);
+  }
+  romea::core::DeltaAngles deltaAngles;
+  benchmark::DoNotOptimize(angularSpeedIntegrator.pop(deltaAngles));
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(angularSpeedIntegratorIntegrate);
+
+//-----------------------------------------------------------------------------
+static void spikeFilterFilter(benchmark::State & state)
+{
+  Samples samples(100);
+  romea::core::SpikeFilter spikeFilter(0.0005 * std::sqrt(100.), 6.e-06 * std::sqrt(100.));
+
+  size_t n = 0;
+  size_t allocationsBefore = getNumberOfAllocations();
+  for (auto _ : state) {
+    size_t index = n++ % NUMBER_OF_PRECOMPUTED_SAMPLES;
+    romea::core::AccelerationsFrame accelerations = samples.accelerations[index];
+    romea::core::AngularSpeedsFrame angularSpeeds = samples.angularSpeeds[index];
+    benchmark::DoNotOptimize(spikeFilter.filter(accelerations, angularSpeeds));
+    benchmark::DoNotOptimize(angularSpeeds);
+  }
+  setCounters(state, allocationsBefore);
+}
+BENCHMARK(spikeFilterFilter);
+
+//-----------------------------------------------------------------------------
+const std::string & sessionFilename()
+{
+  // written once, 2^20 inertial measurements (56 MB of columns)
+  static const std::string filename = [] {
+      std::string name = "/tmp/romea_core_localisation_imu_benchmark_session.bin";
+      romea::core::SessionWriter writer(name);
+      for (size_t n = 0; n < (size_t(1) << 20); ++n) {
+        writer.addInertialMeasurements(
+          romea::core::durationFromSecond(n * 0.001), 0., 0., 9.81, 0., 0., 0.001);
+      }
+      writer.close();
+      return name;
+    }();
+  return filename;
+}
+
+//-----------------------------------------------------------------------------
+static void sessionOpen(benchmark::State & state)
+{
+  const std::string & filename = sessionFilename();
+  for (auto _ : state) {
+    romea::core::SessionReader reader(filename);
+    benchmark::DoNotOptimize(reader.getNumberOfInertialMeasurements());
+  }
+}
+BENCHMARK(sessionOpen);
+
+//-----------------------------------------------------------------------------
+static void sessionScan(benchmark::State & state)
+{
+  romea::core::SessionReader reader(sessionFilename());
+  auto measurements = reader.getInertialMeasurements();
+  const double * channels[6] = {
+    measurements.accelerationsAlongXAxis,
+    measurements.accelerationsAlongYAxis,
+    measurements.accelerationsAlongZAxis,
+    measurements.angularSpeedsAroundXAxis,
+    measurements.angularSpeedsAroundYAxis,
+    measurements.angularSpeedsAroundZAxis};
+
+  for (auto _ : state) {
+    double sum = 0.;
+    for (const double * channel : channels) {
+      for (size_t n = 0; n < measurements.size; ++n) {
+        sum += channel[n];
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * measurements.size * 6 * sizeof(double));
+}
+BENCHMARK(sessionScan);
+
+BENCHMARK_MAIN();
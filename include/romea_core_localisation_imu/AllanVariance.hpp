@@ -0,0 +1,97 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__ALLANVARIANCE_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__ALLANVARIANCE_HPP_
+
+// std
+#include <array>
+#include <cstddef>
+#include <optional>
+
+namespace romea
+{
+namespace core
+{
+
+// Streaming Allan variance of a sensor output, for octave spaced cluster durations.
+// Level k estimates Allan variance for clusters of 2^k samples. Clusters of each level are
+// built by averaging pairs of clusters of the level below, so that memory is bounded by the
+// number of levels and a sample costs two level updates on average. Clusters of level k > 0
+// overlap by half of their duration: fully overlapping clusters would require to keep the
+// last 2^(k+1) samples.
+// Samples are expected to be contiguous, interrupt() has to be called when some are missing
+// or not representative (for instance when vehicle is moving), accumulated differences are
+// kept but no cluster spans the gap.
+class AllanVariance
+{
+public:
+  static constexpr size_t NUMBER_OF_LEVELS = 20;
+
+  // differences required before using a level, relative error is about 20 percents
+  static constexpr size_t MINIMAL_NUMBER_OF_DIFFERENCES = 16;
+
+public:
+  explicit AllanVariance(const double & samplingPeriod);
+
+  void update(const double & value);
+
+  void interrupt();
+
+  void reset();
+
+  double getSamplingPeriod()const;
+
+  // cluster duration of given level (tau), in seconds
+  double getClusterDuration(const size_t & level)const;
+
+  size_t getNumberOfDifferences(const size_t & level)const;
+
+  // NaN when level has not accumulated any difference yet
+  double getVariance(const size_t & level)const;
+
+  double getDeviation(const size_t & level)const;
+
+  // white noise density in value unit per square root of second (angle random walk of a gyro,
+  // velocity random walk of an accelerometer), estimated at the shortest cluster duration
+  std::optional<double> getRandomWalk()const;
+
+  // flicker floor of the Allan deviation curve divided by 0.664, nullopt until the minimum
+  // of the curve has been reached by a level with enough differences
+  std::optional<double> getBiasInstability()const;
+
+private:
+  struct Level
+  {
+    std::array<double, 4> clusters;  // last cluster averages, oldest first
+    size_t numberOfClusters;  // since last interruption, saturated to 4
+    double pendingCluster;  // first half of next cluster of level above
+    bool hasPendingCluster;
+    double sumOfSquaredDifferences;
+    size_t numberOfDifferences;
+  };
+
+  bool isReliable_(const size_t & level)const;
+
+private:
+  double samplingPeriod_;
+  std::array<Level, NUMBER_OF_LEVELS> levels_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__ALLANVARIANCE_HPP_
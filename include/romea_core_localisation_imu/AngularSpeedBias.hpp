@@ -17,15 +17,23 @@
 #define ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDBIAS_HPP_
 
 // romea
-#include <romea_core_imu/algorithms/ZeroVelocityEstimator.hpp>
 #include <romea_core_imu/AccelerationsFrame.hpp>
 #include <romea_core_imu/AngularSpeedsFrame.hpp>
 #include <romea_core_common/diagnostic/DiagnosticReport.hpp>
 
 // std
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <optional>
 #include <string>
-#include <mutex>
+
+// local
+#include "romea_core_localisation_imu/AllanVariance.hpp"
+#include "romea_core_localisation_imu/AngularSpeedBiasPrior.hpp"
+#include "romea_core_localisation_imu/AngularSpeedBiasTable.hpp"
+#include "romea_core_localisation_imu/MovingStatistics.hpp"
+#include "romea_core_localisation_imu/SeqLock.hpp"
 
 
 namespace romea
@@ -33,24 +41,107 @@ namespace romea
 namespace core
 {
 
-class AngularSpeedBias
+struct AngularSpeedBiasEstimation
+{
+  enum Mode : uint32_t
+  {
+    // mean of the last 5 s of standstill samples, no bias until window is full
+    MOVING_AVERAGE = 0,
+    // one Kalman filter per axis with a random walk bias model, bias is available after a
+    // fraction of a second of standstill and then keeps drifting with a growing variance
+    RECURSIVE_FILTER = 1
+  };
+};
+
+// Estimates gyro biases from standstill samples.
+// Sliding windows are stored and accumulated as Scalar, inputs, outputs and reports stay in
+// double. Only float and double are instantiated, in the library.
+// Noise of every axis is also characterized online with Allan variances, from samples taken
+// while odometry reports a null speed and only gated by a loose bound on their standard
+// deviations. Once enough samples have been gathered, measured white noises replace the
+// datasheet standard deviations in zero velocity thresholds, which can thus be raised as well
+// as lowered.
+// When sensor temperature is given, standstill samples also feed a bias versus temperature
+// table, whose bin at current temperature is used as prior whenever no bias is estimated.
+template<typename Scalar>
+class BasicAngularSpeedBias
 {
 public:
-  AngularSpeedBias(
+  BasicAngularSpeedBias(
     const double & imuRate,
     const double & accelerationSpeedStd,
-    const double & angularSpeedStd);
+    const double & angularSpeedStd,
+    const AngularSpeedBiasEstimation::Mode & mode = AngularSpeedBiasEstimation::MOVING_AVERAGE);
 
   std::optional<double> evaluate(
     const double & linearSpeed,
     const AccelerationsFrame & accelerations,
     const AngularSpeedsFrame & angularSpeeds);
 
+  // bias variances are filled when not null, they are zero with moving average. Biases of the
+  // three axes in effect at each sample are filled when not null, zero when bias is unknown.
+  void evaluate(
+    const double * linearSpeeds,
+    const AccelerationsFrame * accelerations,
+    const AngularSpeedsFrame * angularSpeeds,
+    const size_t & numberOfSamples,
+    std::optional<double> * angularSpeedBiases,
+    double * angularSpeedBiasVariances = nullptr,
+    AngularSpeedsFrame * angularSpeedBiasFrames = nullptr);
+
+  // biases of the three gyro axes, to be called from the thread calling evaluate
+  std::optional<AngularSpeedsFrame> getAngularSpeedBiases()const;
+
+  // warm start from a previously converged bias, to be called before first evaluation.
+  // Prior is used until bias window is full, weighted by the number of missing samples.
+  // It is kept when only linear speed is reset, and dropped by an inertial reset.
+  void setPrior(const AngularSpeedBiasPrior & prior);
+
+  // can be called from any thread, prior is dropped at next evaluation
+  void clearPrior();
+
+  // nullopt until a bias has been estimated from a full window of standstill samples
+  std::optional<AngularSpeedBiasPrior> makePrior()const;
+
+  // can be called from any thread, NaN when temperature is unknown
+  void setTemperature(const double & temperature);
+
+  // bins can be read from any thread, table should only be loaded before first evaluation
+  const AngularSpeedBiasTable & getTemperatureTable()const;
+
+  AngularSpeedBiasTable & getTemperatureTable();
+
   DiagnosticReport getReport()const;
 
+  // changes each time report values are updated, used to cache reports
+  uint32_t getReportVersion()const;
+
   void reset(bool resetZeroVelocityEstimator);
 
 private:
+  // latest evaluated values, string report is only built on demand
+  struct ReportValues
+  {
+    DiagnosticStatus status;  // STALE until first evaluation or reset
+    double accelerationStd;  // NaN when not available
+    double angularSpeedStd;
+    double linearSpeed;
+    double angularSpeedBias;
+    double angularSpeedBiasAroundXAxis;
+    double angularSpeedBiasAroundYAxis;
+    double angularSpeedBiasStd;  // NaN with moving average
+    bool isAngularSpeedBiasEstimated;  // false when bias still relies on prior
+    double velocityRandomWalk;  // NaN until estimated from standstill samples
+    double angleRandomWalk;
+    double angularSpeedBiasInstability;
+    double temperature;  // NaN when unknown
+  };
+
+  // acceleration and angular speed along x, y and z axes, two padding lanes
+  using ZeroVelocityStatistics = MovingStatistics<8, Scalar>;
+  // angular speed around x, y and z axes, one padding lane
+  using AngularSpeedBiasStatistics = MovingStatistics<4, Scalar>;
+
   bool hasNullLinearSpeed_(const double & linearSpeed)const;
 
   bool hasZeroVelocity_(
@@ -62,16 +153,71 @@ private:
     const AccelerationsFrame & accelerations,
     const AngularSpeedsFrame & angularSpeeds);
 
-  void setDiagnostic_(const DiagnosticStatus & status, const std::string & message);
+  void updateAllanVariances_(
+    const AccelerationsFrame & accelerations,
+    const AngularSpeedsFrame & angularSpeeds);
 
-private:
-  ZeroVelocityEstimator zeroVelocity_;
-  OnlineAverage imuAngularSpeedBiasEstimator_;
+  void interruptAllanVariances_();
+
+  void updateNoiseParameters_();
+
+  void resetNoiseParameters_();
+
+  void filterAngularSpeedBias_(const AngularSpeedsFrame & angularSpeeds);
+
+  bool isAngularSpeedBiasEstimated_()const;
 
-  mutable std::mutex mutex_;
-  DiagnosticReport report_;
+  std::optional<AngularSpeedsFrame> computeAngularSpeedBiases_()const;
+
+  void applyRequestedReset_();
+
+  void applyTemperaturePrior_();
+
+  void initializeFilterFromPrior_();
+
+  static DiagnosticReport makeReport_(const ReportValues & values);
+
+private:
+  double imuRate_;
+  double accelerationStd_;
+  double angularSpeedStd_;
+  AngularSpeedBiasEstimation::Mode mode_;
+
+  ZeroVelocityStatistics zeroVelocityStatistics_;
+  AngularSpeedBiasStatistics angularSpeedBiasStatistics_;
+  double measuredAccelerationStd_;
+  double measuredAngularSpeedStd_;
+  std::optional<AngularSpeedBiasPrior> prior_;
+  bool isTemperaturePrior_;  // prior looked up in temperature table rather than loaded
+
+  // recursive filter state of x, y and z axes, variances are infinite until initialization
+  std::array<double, 3> filteredAngularSpeedBiases_;
+  std::array<double, 3> filteredAngularSpeedBiasVariances_;
+  size_t numberOfFilteredSamples_;  // standstill samples since reset
+
+  std::atomic<double> temperature_;
+  AngularSpeedBiasTable temperatureTable_;
+
+  // acceleration along and angular speed around x, y and z axes
+  std::array<AllanVariance, 6> allanVariances_;
+  bool isStandingStill_;
+  size_t numberOfStandstillSamples_;
+  double zeroVelocityAccelerationStd_;  // datasheet values until noise is estimated
+  double zeroVelocityAngularSpeedStd_;
+  double velocityRandomWalk_;
+  double angleRandomWalk_;
+  double angularSpeedBiasInstability_;
+
+  std::atomic<bool> isResetRequested_;
+  std::atomic<bool> isZeroVelocityResetRequested_;
+  std::atomic<bool> isPriorClearRequested_;
+  SeqLock<ReportValues> reportValues_;
 };
 
+extern template class BasicAngularSpeedBias<double>;
+extern template class BasicAngularSpeedBias<float>;
+using AngularSpeedBias = BasicAngularSpeedBias<double>;
+
 }  // namespace core
 }  // namespace romea
 
@@ -0,0 +1,63 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDBIASPRIOR_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDBIASPRIOR_HPP_
+
+// romea
+#include <romea_core_imu/AngularSpeedsFrame.hpp>
+
+// std
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace romea
+{
+namespace core
+{
+
+// Converged angular speed bias saved at shutdown and reloaded at startup to warm start
+// AngularSpeedBias. Sensor parameters are stored to reject a file written for another IMU.
+struct AngularSpeedBiasPrior
+{
+  double imuRate;
+  double accelerationStd;
+  double angularSpeedStd;
+
+  AngularSpeedsFrame angularSpeedBiases;
+  uint64_t numberOfSamples;
+
+  // standard deviations measured during standstill
+  double measuredAccelerationStd;
+  double measuredAngularSpeedStd;
+};
+
+// throw std::runtime_error if file cannot be written
+void saveAngularSpeedBiasPrior(
+  const std::string & filename,
+  const AngularSpeedBiasPrior & prior);
+
+// nullopt if file is missing, corrupted, from another version or written for another sensor
+std::optional<AngularSpeedBiasPrior> loadAngularSpeedBiasPrior(
+  const std::string & filename,
+  const double & imuRate,
+  const double & accelerationStd,
+  const double & angularSpeedStd);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDBIASPRIOR_HPP_
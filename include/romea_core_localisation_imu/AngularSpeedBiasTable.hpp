@@ -0,0 +1,108 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDBIASTABLE_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDBIASTABLE_HPP_
+
+// romea
+#include <romea_core_imu/AngularSpeedsFrame.hpp>
+
+// std
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Gyro biases learnt against sensor temperature, one bin per degree.
+// Each bin averages the standstill angular speeds seen at its temperature, the number of
+// averaged samples stands for the confidence of the bin. Once this number reaches its maximum,
+// bin turns into an exponential average so that it follows sensor aging. Updates and lookups
+// cost O(1), bins can be read from any thread while sample thread updates them.
+class AngularSpeedBiasTable
+{
+public:
+  static constexpr double MINIMAL_TEMPERATURE = -40.;
+  static constexpr double MAXIMAL_TEMPERATURE = 85.;
+  static constexpr size_t NUMBER_OF_BINS = 125;
+
+  struct Bin
+  {
+    AngularSpeedsFrame angularSpeedBiases;
+    uint64_t numberOfSamples;
+  };
+
+public:
+  // bins are only looked up once they have averaged minimalNumberOfSamples samples
+  AngularSpeedBiasTable(
+    const uint64_t & minimalNumberOfSamples,
+    const uint64_t & maximalNumberOfSamples);
+
+  AngularSpeedBiasTable(const AngularSpeedBiasTable &) = delete;
+  AngularSpeedBiasTable & operator=(const AngularSpeedBiasTable &) = delete;
+
+  // ignored when temperature is not finite or out of table range
+  void update(
+    const double & temperature,
+    const AngularSpeedsFrame & angularSpeeds);
+
+  // nullopt when bin is out of range or not confident enough
+  std::optional<Bin> lookup(const double & temperature)const;
+
+  Bin getBin(const size_t & index)const;
+
+  void setBin(const size_t & index, const Bin & bin);
+
+  void reset();
+
+private:
+  static std::optional<size_t> binIndex_(const double & temperature);
+
+private:
+  uint64_t minimalNumberOfSamples_;
+  uint64_t maximalNumberOfSamples_;
+  std::array<SeqLock<Bin>, NUMBER_OF_BINS> bins_;
+};
+
+// Bins are saved along sensor parameters to reject a file written for another IMU,
+// throw std::runtime_error if file cannot be written
+void saveAngularSpeedBiasTable(
+  const std::string & filename,
+  const double & imuRate,
+  const double & accelerationStd,
+  const double & angularSpeedStd,
+  const AngularSpeedBiasTable & table);
+
+// false if file is missing, corrupted, from another version or written for another sensor,
+// table is left unchanged in that case
+bool loadAngularSpeedBiasTable(
+  const std::string & filename,
+  const double & imuRate,
+  const double & accelerationStd,
+  const double & angularSpeedStd,
+  AngularSpeedBiasTable & table);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDBIASTABLE_HPP_
@@ -0,0 +1,110 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDDECIMATOR_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDDECIMATOR_HPP_
+
+// romea
+#include <romea_core_common/diagnostic/DiagnosticReport.hpp>
+#include <romea_core_common/time/Time.hpp>
+
+// std
+#include <cstddef>
+#include <cstdint>
+
+// local
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Averages accepted angular speed observations over groups of samples.
+// A group is complete once it holds the given number of samples or once it spans the given
+// window duration since previous group, whichever comes first. Averages are computed from
+// running sums: white noise variance is divided by the number of samples while bias variance
+// is kept, since the same bias error affects every sample of the group. Rejected samples are
+// only counted. A partial group is dropped after a gap or a run of rejected samples longer
+// than a few sampling periods, its samples are then counted as rejected.
+class AngularSpeedDecimator
+{
+public:
+  AngularSpeedDecimator(
+    const double & imuRate,
+    const size_t & numberOfSamples,
+    const Duration & windowDuration);
+
+  // return true when sample completes a group, its average is then available
+  bool add(
+    const Duration & stamp,
+    const double & angularSpeed,
+    const double & angularSpeedNoiseVariance,
+    const double & angularSpeedBiasVariance);
+
+  void reject();
+
+  double getAngularSpeed()const;
+
+  double getAngularSpeedVariance()const;
+
+  DiagnosticReport getReport()const;
+
+  // changes each time report values are updated, used to cache reports
+  uint32_t getReportVersion()const;
+
+private:
+  // published when a group is complete or dropped and when a sample is rejected
+  struct ReportValues
+  {
+    uint64_t numberOfObservations;
+    uint64_t numberOfAveragedSamples;
+    uint64_t numberOfRejectedSamples;
+  };
+
+  void clear_();
+
+  void drop_();
+
+  static DiagnosticReport makeReport_(const ReportValues & values);
+
+private:
+  double samplingPeriod_;
+  size_t maximalNumberOfSamples_;
+  double windowDuration_;
+  double maximalGapDuration_;
+
+  // current group
+  bool hasWindowStart_;
+  Duration windowStart_;
+  Duration lastStamp_;
+  size_t numberOfConsecutiveRejectedSamples_;
+  size_t numberOfSamples_;
+  double angularSpeedSum_;
+  double angularSpeedNoiseVarianceSum_;
+
+  // last complete group
+  double angularSpeed_;
+  double angularSpeedVariance_;
+
+  ReportValues counters_;
+  SeqLock<ReportValues> reportValues_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDDECIMATOR_HPP_
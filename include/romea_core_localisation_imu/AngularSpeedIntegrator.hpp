@@ -0,0 +1,122 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDINTEGRATOR_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDINTEGRATOR_HPP_
+
+// eigen
+#include <Eigen/Core>
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+#include <romea_core_imu/AngularSpeedsFrame.hpp>
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// local
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Angles swept around x, y and z axes between two instants, to be used as a single
+// observation in place of every angular speed observation received meanwhile
+struct DeltaAngles
+{
+  Duration startStamp;
+  Duration stopStamp;
+  double duration;  // seconds actually integrated, shorter than stamp difference after gaps
+  uint64_t numberOfSamples;
+  Eigen::Vector3d Y;
+  Eigen::Matrix3d R;
+};
+
+// Pre-integrates bias corrected angular speeds.
+// Each sample is held over the interval elapsed since the previous one, intervals longer than
+// ten sampling periods are gaps and only count for one period. Running totals are published
+// after each sample, so delta angles can be popped from another thread without stopping
+// integration: they are the difference between current totals and those of previous pop.
+// Covariance is diagonal: angular speed white noise integrated over each interval, plus bias
+// variance of last sample times squared window duration since bias error is the same for
+// every sample of the window.
+// Totals after each sample of the last second are kept, so delta angles can also be cut at an
+// instant chosen by the caller: the sample whose interval straddles it is split in proportion
+// of time, its remaining part and the sample itself go to next delta angles.
+class AngularSpeedIntegrator
+{
+public:
+  AngularSpeedIntegrator(
+    const double & imuRate,
+    const double & angularSpeedVariance);
+
+  void integrate(
+    const Duration & stamp,
+    const AngularSpeedsFrame & angularSpeeds,
+    const double & angularSpeedBiasVariance);
+
+  // must only be called from one thread at a time, return false when no sample has been
+  // integrated since previous pop
+  bool pop(DeltaAngles & deltaAngles);
+
+  // delta angles from previous pop to stamp, return false until a sample stamped at or after
+  // stamp has been integrated or when stamp is not after previous pop. Delta angles stop at the
+  // oldest kept sample when stamp is older, stop stamp then tells where they were cut.
+  bool pop(const Duration & stamp, DeltaAngles & deltaAngles);
+
+private:
+  struct Totals
+  {
+    int64_t stamp;  // nanoseconds, last integrated sample or cut instant
+    uint64_t numberOfSamples;
+    double duration;
+    std::array<double, 3> angles;
+    double angleNoiseVariance;
+    double angularSpeedBiasVariance;  // last sample, not accumulated
+    std::array<double, 3> angularSpeeds;  // last sample, used to cut it
+    double step;
+  };
+
+  // false when sample has been overwritten by newer ones
+  bool loadTotals_(const uint64_t & numberOfSamples, Totals & totals)const;
+
+  Totals cut_(const Totals & totals, const Duration & stamp)const;
+
+  void pop_(const Totals & totals, DeltaAngles & deltaAngles);
+
+private:
+  double samplingPeriod_;
+  double angularSpeedVariance_;
+
+  // written by integrating thread only, totals after sample n are kept in slot (n - 1) % size
+  Totals totals_;
+  std::vector<SeqLock<Totals>> history_;
+  std::atomic<uint64_t> numberOfPublishedSamples_;
+
+  // owned by popping thread
+  bool hasPoppedTotals_;
+  Totals poppedTotals_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__ANGULARSPEEDINTEGRATOR_HPP_
@@ -0,0 +1,112 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__ATTITUDEPROPAGATOR_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__ATTITUDEPROPAGATOR_HPP_
+
+// eigen
+#include <Eigen/Geometry>
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+#include <romea_core_imu/AngularSpeedsFrame.hpp>
+
+// std
+#include <cstdint>
+
+// local
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Propagates roll and pitch angles between attitude frames by integrating bias corrected
+// angular speeds into an orientation quaternion.
+// Attitude frames can be set from any thread, the thread propagating angular speeds restarts
+// from the last one at its next sample. Course angle is not needed: roll and pitch only depend
+// on gravity direction in body frame. Roll and pitch errors are considered independent, with
+// the same variance: attitude frame variance, plus angular speed noise integrated over each
+// step, plus bias variance times squared propagation duration.
+class AttitudePropagator
+{
+public:
+  AttitudePropagator(
+    const double & imuRate,
+    const double & angleVariance,
+    const double & angularSpeedVariance);
+
+  // can be called from any thread
+  void setAttitude(
+    const Duration & stamp,
+    const double & rollAngle,
+    const double & pitchAngle);
+
+  // return false until a first attitude frame is set, for samples older than it and after
+  // a gap in angular speeds or a too long propagation, until next attitude frame
+  bool propagate(
+    const Duration & stamp,
+    const AngularSpeedsFrame & angularSpeeds,
+    const double & angularSpeedBiasVariance);
+
+  // propagation is stopped until next attitude frame
+  void interrupt();
+
+  // state of the last propagated sample, to be read from the thread calling propagate
+  bool isAvailable()const;
+
+  Duration getStamp()const;
+
+  double getRollAngle()const;
+
+  double getPitchAngle()const;
+
+  double getAngleVariance()const;
+
+  // seconds elapsed since attitude frame
+  double getPropagationDuration()const;
+
+private:
+  struct AttitudeFrame
+  {
+    int64_t stamp;  // nanoseconds, minimal value until first frame
+    double rollAngle;
+    double pitchAngle;
+  };
+
+  void restart_(const AttitudeFrame & attitudeFrame);
+
+private:
+  double samplingPeriod_;
+  double angleVariance_;
+  double angularSpeedVariance_;
+
+  SeqLock<AttitudeFrame> attitudeFrame_;
+
+  Eigen::Quaterniond orientation_;
+  Duration attitudeFrameStamp_;
+  Duration stamp_;
+  double angularSpeedNoiseVariance_;
+  double angularSpeedBiasVariance_;
+  bool isPropagating_;
+  bool isAvailable_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__ATTITUDEPROPAGATOR_HPP_
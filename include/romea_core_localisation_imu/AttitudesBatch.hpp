@@ -0,0 +1,44 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__ATTITUDESBATCH_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__ATTITUDESBATCH_HPP_
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+
+// std
+#include <cstddef>
+
+namespace romea
+{
+namespace core
+{
+
+// Structure of arrays view on attitude angles, data are not owned.
+// Each pointer must reference at least size elements.
+struct AttitudesBatch
+{
+  size_t size;
+  const Duration * stamps;
+  const double * rollAngles;
+  const double * pitchAngles;
+  const double * courseAngles;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__ATTITUDESBATCH_HPP_
@@ -21,9 +21,11 @@
 #include <romea_core_imu/RollPitchCourseFrame.hpp>
 
 // std
-#include <mutex>
 #include <string>
 
+// local
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
 
 namespace romea
 {
@@ -39,18 +41,26 @@ public:
 
   DiagnosticReport getReport()const;
 
+  // changes each time report values are updated, used to cache reports
+  uint32_t getReportVersion()const;
+
   void reset();
 
 private:
+  // latest evaluated values, string report is only built on demand
+  struct ReportValues
+  {
+    DiagnosticStatus status;  // STALE until first evaluation
+    double rollAngle;
+    double pitchAngle;
+  };
+
   bool checkAttitudeAngles_(const RollPitchCourseFrame & frame);
 
-  void declareReportInfos_();
-  void setReportInfos_(const RollPitchCourseFrame & frame);
-  void setDiagnostic_(const DiagnosticStatus & status, const std::string & message);
+  static DiagnosticReport makeReport_(const ReportValues & values);
 
 private:
-  mutable std::mutex mutex_;
-  DiagnosticReport report_;
+  SeqLock<ReportValues> reportValues_;
 };
 
 }  // namespace core
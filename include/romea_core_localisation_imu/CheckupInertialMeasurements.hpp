@@ -21,9 +21,12 @@
 #include <romea_core_common/diagnostic/DiagnosticReport.hpp>
 
 // std
-#include <mutex>
+#include <cstddef>
 #include <string>
 
+// local
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
 namespace romea
 {
 namespace core
@@ -40,25 +43,39 @@ public:
     const AccelerationsFrame & accelerations,
     const AngularSpeedsFrame & angularSpeeds);
 
+  void evaluate(
+    const AccelerationsFrame * accelerations,
+    const AngularSpeedsFrame * angularSpeeds,
+    const size_t & numberOfSamples,
+    DiagnosticStatus * statuses);
+
   DiagnosticReport getReport() const;
 
+  // changes each time report values are updated, used to cache reports
+  uint32_t getReportVersion()const;
+
   void reset();
 
 private:
-  void checkAccelerations_(const AccelerationsFrame & accelerationFrame);
-  void checkAngularSpeeds_(const AngularSpeedsFrame & angularSpeedFrame);
+  // latest evaluated values, string report is only built on demand
+  struct ReportValues
+  {
+    DiagnosticStatus accelerationStatus;  // STALE until first evaluation
+    DiagnosticStatus angularSpeedStatus;
+    AccelerationsFrame accelerations;
+    AngularSpeedsFrame angularSpeeds;
+  };
+
+  bool isOutOfRange_(const AccelerationsFrame & accelerationFrame)const;
+  bool isOutOfRange_(const AngularSpeedsFrame & angularSpeedFrame)const;
 
-  void declareReportInfos_();
-  void setReportInfos_(const AccelerationsFrame & accelarations);
-  void setReportInfos_(const AngularSpeedsFrame & angularSpeeds);
-  void addDiagnostic_(const DiagnosticStatus & status, const std::string & message);
+  static DiagnosticReport makeReport_(const ReportValues & values);
 
 private:
   double accelerationRange_;
   double angularSpeedRange_;
 
-  mutable std::mutex mutex_;
-  DiagnosticReport report_;
+  SeqLock<ReportValues> reportValues_;
 };
 
 }  // namespace core
@@ -0,0 +1,88 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__CHECKUPSAMPLERATE_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__CHECKUPSAMPLERATE_HPP_
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+#include <romea_core_common/diagnostic/DiagnosticReport.hpp>
+
+// std
+#include <atomic>
+#include <string>
+#include <vector>
+
+// local
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Checks that samples are received at a rate greater than minimalRate - epsilon.
+// Same diagnostic messages, report info and heartbeat timeout as CheckupGreaterThanRate from
+// romea_core_common: rate is estimated over a sliding window of two seconds of samples and
+// heartbeats fail one second after the last sample. Stamps are stored in a buffer allocated
+// at construction and report strings are only built by getReport, so evaluate never
+// allocates.
+class CheckupSampleRate
+{
+public:
+  CheckupSampleRate(
+    const std::string & name,
+    const double & minimalRate,
+    const double & epsilon);
+
+  DiagnosticStatus evaluate(const Duration & stamp);
+
+  bool heartBeatCallback(const Duration & stamp);
+
+  DiagnosticReport getReport()const;
+
+  // changes each time report values are updated, used to cache reports
+  uint32_t getReportVersion()const;
+
+  void reset();
+
+private:
+  struct ReportValues
+  {
+    DiagnosticStatus status;
+    double rate;  // NaN when not available
+  };
+
+  void applyRequestedReset_();
+
+private:
+  std::string name_;
+  double minimalRate_;
+  double epsilon_;
+
+  std::vector<Duration> stamps_;
+  size_t stampIndex_;
+  size_t numberOfStamps_;
+
+  std::atomic<bool> hasStamp_;
+  std::atomic<Duration::rep> lastStamp_;
+  std::atomic<bool> isResetRequested_;
+  SeqLock<ReportValues> reportValues_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__CHECKUPSAMPLERATE_HPP_
@@ -0,0 +1,118 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__DEBUGLOG_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__DEBUGLOG_HPP_
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+
+// local
+#include "romea_core_localisation_imu/MPSCQueue.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Fixed size binary record, values not used by a record type are NaN
+struct DebugLogRecord
+{
+  enum Type : uint32_t
+  {
+    INERTIAL_MEASUREMENTS = 1,  // accelerations and angular speeds along x, y, z
+    LINEAR_SPEED = 2,  // linear speed
+    ANGULAR_SPEED_BIAS = 3,  // interpolated linear speed, angular speed bias around z axis
+    ANGULAR_SPEED = 4,  // angular speed observation Y and R
+    ATTITUDE_ANGLES = 5,  // roll, pitch and course angles
+    ATTITUDE = 6,  // attitude observation roll, pitch and angle variance
+    DROPPED_RECORDS = 7  // number of records dropped since previous DROPPED_RECORDS
+  };
+
+  static constexpr size_t NUMBER_OF_VALUES = 6;
+
+  uint32_t type;
+  uint32_t source;  // index of the IMU which produced the record, 0 for linear speeds
+  int64_t stamp;  // nanoseconds
+  double values[NUMBER_OF_VALUES];
+};
+
+// Binary log of plugin sample stream written by a background thread.
+// Producers copy records into a bounded lock free ring and never wait: when the ring is full
+// because the disk cannot keep up, records are dropped and counted. Records which cannot be
+// written (disk full, I/O error) are counted as dropped too. Drops are also written in the
+// file as DROPPED_RECORDS records so gaps can be located offline.
+//
+// File layout: magic "RIDL", version (uint32), record size (uint32), then records.
+class DebugLog
+{
+public:
+  static constexpr char MAGIC[4] = {'R', 'I', 'D', 'L'};
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t HEADER_SIZE = sizeof(MAGIC) + sizeof(VERSION) + sizeof(uint32_t);
+  static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+public:
+  // throw std::runtime_error if file cannot be opened, capacity is rounded to a power of two
+  explicit DebugLog(const std::string & filename, const size_t & capacity = DEFAULT_CAPACITY);
+
+  // remaining records are written before file is closed
+  ~DebugLog();
+
+  DebugLog(const DebugLog &) = delete;
+  DebugLog & operator=(const DebugLog &) = delete;
+
+  // can be called concurrently from several threads, return false when record is dropped
+  bool log(
+    const DebugLogRecord::Type & type,
+    const uint32_t & source,
+    const Duration & stamp,
+    const double & value0,
+    const double & value1 = std::numeric_limits<double>::quiet_NaN(),
+    const double & value2 = std::numeric_limits<double>::quiet_NaN(),
+    const double & value3 = std::numeric_limits<double>::quiet_NaN(),
+    const double & value4 = std::numeric_limits<double>::quiet_NaN(),
+    const double & value5 = std::numeric_limits<double>::quiet_NaN());
+
+  uint64_t getNumberOfLoggedRecords()const;
+  uint64_t getNumberOfDroppedRecords()const;
+
+private:
+  void write_();
+
+private:
+  std::string filename_;
+  std::ofstream file_;
+  MPSCQueue<DebugLogRecord> records_;
+
+  std::atomic<uint64_t> numberOfLoggedRecords_;
+  std::atomic<uint64_t> numberOfDroppedRecords_;
+
+  std::atomic<bool> isRunning_;
+  std::thread writer_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__DEBUGLOG_HPP_
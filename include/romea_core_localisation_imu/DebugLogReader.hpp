@@ -0,0 +1,48 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__DEBUGLOGREADER_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__DEBUGLOGREADER_HPP_
+
+// std
+#include <fstream>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/DebugLog.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Sequential reader of files written by DebugLog
+class DebugLogReader
+{
+public:
+  // throw std::runtime_error if file cannot be opened or has not been written by DebugLog
+  explicit DebugLogReader(const std::string & filename);
+
+  // false at end of file, a truncated last record is ignored
+  bool read(DebugLogRecord & record);
+
+private:
+  std::ifstream file_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__DEBUGLOGREADER_HPP_
@@ -0,0 +1,112 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICAGGREGATOR_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICAGGREGATOR_HPP_
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+#include <romea_core_common/diagnostic/DiagnosticReport.hpp>
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// local
+#include "romea_core_localisation_imu/MPSCQueue.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Compact event pushed by sample threads, its meaning is left to the event callback
+struct DiagnosticEvent
+{
+  uint32_t type;
+  uint32_t source;
+  int64_t stamp;  // nanoseconds
+};
+
+// Maintains a diagnostic report from a background thread.
+// Sample threads push events into a bounded lock free queue and never wait, events are
+// dropped and counted when the queue is full. Every period, the aggregator thread hands
+// queued events to the event callback, then rebuilds the report with the report callback.
+// The aggregator has no clock of its own: time only moves forward through event stamps, so
+// users willing to detect timeouts of silent sensors push heart beat events stamped by the
+// caller in the sample time base.
+class DiagnosticAggregator
+{
+public:
+  using EventCallback = std::function<void(const DiagnosticEvent &)>;
+  using ReportCallback = std::function<DiagnosticReport()>;
+
+  static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+public:
+  // capacity is rounded to a power of two, callbacks are only called from aggregator thread
+  DiagnosticAggregator(
+    EventCallback eventCallback,
+    ReportCallback reportCallback,
+    const Duration & period,
+    const size_t & capacity = DEFAULT_CAPACITY);
+
+  // remaining events are handed to event callback before thread is stopped
+  ~DiagnosticAggregator();
+
+  DiagnosticAggregator(const DiagnosticAggregator &) = delete;
+  DiagnosticAggregator & operator=(const DiagnosticAggregator &) = delete;
+
+  // can be called concurrently from several threads, return false when event is dropped
+  bool push(
+    const uint32_t & type,
+    const uint32_t & source,
+    const Duration & stamp);
+
+  // last report built by aggregator thread, empty until first period elapsed
+  DiagnosticReport getReport()const;
+
+  uint64_t getNumberOfDroppedEvents()const;
+
+private:
+  void aggregate_();
+
+  void drain_();
+
+private:
+  EventCallback eventCallback_;
+  ReportCallback reportCallback_;
+  Duration period_;
+
+  MPSCQueue<DiagnosticEvent> events_;
+  std::atomic<uint64_t> numberOfDroppedEvents_;
+
+  mutable std::mutex reportMutex_;
+  DiagnosticReport report_;
+
+  std::mutex runningMutex_;
+  std::condition_variable runningCondition_;
+  bool isRunning_;
+  std::thread aggregator_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICAGGREGATOR_HPP_
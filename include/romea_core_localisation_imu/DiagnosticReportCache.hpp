@@ -0,0 +1,73 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICREPORTCACHE_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICREPORTCACHE_HPP_
+
+// romea
+#include <romea_core_common/diagnostic/DiagnosticReport.hpp>
+
+// std
+#include <cstdint>
+#include <vector>
+
+namespace romea
+{
+namespace core
+{
+
+// Diagnostic report assembled from a fixed number of sections.
+// Each section remembers the version of the values it was built from and is only rebuilt
+// when this version changes, the assembled report is only rebuilt when a section changed.
+// Sections never updated are left out of the assembled report.
+class DiagnosticReportCache
+{
+public:
+  explicit DiagnosticReportCache(const size_t & numberOfSections);
+
+  // builder is only called when section is new or its version changed, version must be
+  // read before the values the builder uses
+  template<typename Builder>
+  void updateSection(const size_t & index, const uint64_t & version, Builder && builder)
+  {
+    Section & section = sections_[index];
+    if (!section.isBuilt || section.version != version) {
+      section.report = builder();
+      section.version = version;
+      section.isBuilt = true;
+      isAssembled_ = false;
+    }
+  }
+
+  const DiagnosticReport & getReport();
+
+private:
+  struct Section
+  {
+    bool isBuilt;
+    uint64_t version;
+    DiagnosticReport report;
+  };
+
+private:
+  std::vector<Section> sections_;
+  bool isAssembled_;
+  DiagnosticReport report_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICREPORTCACHE_HPP_
@@ -0,0 +1,119 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICSTATUSMONITOR_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICSTATUSMONITOR_HPP_
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+#include <romea_core_common/diagnostic/DiagnosticStatus.hpp>
+
+// std
+#include <atomic>
+#include <cstdint>
+
+// local
+#include "romea_core_localisation_imu/FixedArray.hpp"
+#include "romea_core_localisation_imu/MPSCQueue.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+struct DiagnosticStatusTransition
+{
+  enum Checkup : uint32_t
+  {
+    LINEAR_SPEED_RATE = 0,  // not related to an IMU, reported with IMU index 0
+    ATTITUDE_RATE = 1,
+    ATTITUDE = 2,
+    INERTIAL_MEASUREMENT_RATE = 3,
+    INERTIAL_MEASUREMENTS = 4,  // acceleration and angular speed ranges
+    ANGULAR_SPEED_BIAS = 5
+  };
+
+  static constexpr size_t NUMBER_OF_CHECKUPS = 6;
+
+  Checkup checkup;
+  uint32_t imuIndex;
+  DiagnosticStatus previousStatus;
+  DiagnosticStatus status;
+  Duration stamp;  // stamp of the sample or heartbeat which changed status
+};
+
+// Records status transitions of plugin checkups so that supervisors do not have to poll and
+// diff diagnostic reports. Statuses start STALE. Updating a status to its current value is a
+// single relaxed load, transitions bump a generation counter and are queued in a bounded
+// lock free queue, they are dropped and counted when nobody drains the queue.
+class DiagnosticStatusMonitor
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 256;
+
+public:
+  explicit DiagnosticStatusMonitor(
+    const size_t & numberOfIMUs,
+    const size_t & capacity = DEFAULT_CAPACITY);
+
+  // can be called concurrently from several threads
+  void update(
+    const DiagnosticStatusTransition::Checkup & checkup,
+    const size_t & imuIndex,
+    const DiagnosticStatus & status,
+    const Duration & stamp)
+  {
+    if (statuses_[index_(checkup, imuIndex)].load(std::memory_order_relaxed) != status) {
+      recordTransition_(checkup, imuIndex, status, stamp);
+    }
+  }
+
+  DiagnosticStatus getStatus(
+    const DiagnosticStatusTransition::Checkup & checkup,
+    const size_t & imuIndex)const;
+
+  // incremented after each transition is queued
+  uint64_t getGeneration()const;
+
+  // must only be called from one thread at a time, return false when no transition is queued
+  bool popTransition(DiagnosticStatusTransition & transition);
+
+  uint64_t getNumberOfDroppedTransitions()const;
+
+private:
+  static size_t index_(
+    const DiagnosticStatusTransition::Checkup & checkup,
+    const size_t & imuIndex)
+  {
+    return imuIndex * DiagnosticStatusTransition::NUMBER_OF_CHECKUPS + checkup;
+  }
+
+  void recordTransition_(
+    const DiagnosticStatusTransition::Checkup & checkup,
+    const size_t & imuIndex,
+    const DiagnosticStatus & status,
+    const Duration & stamp);
+
+private:
+  FixedArray<std::atomic<DiagnosticStatus>> statuses_;
+  MPSCQueue<DiagnosticStatusTransition> transitions_;
+  std::atomic<uint64_t> generation_;
+  std::atomic<uint64_t> numberOfDroppedTransitions_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__DIAGNOSTICSTATUSMONITOR_HPP_
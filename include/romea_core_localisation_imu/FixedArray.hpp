@@ -0,0 +1,164 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__FIXEDARRAY_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__FIXEDARRAY_HPP_
+
+// std
+#include <cstddef>
+#include <new>
+
+namespace romea
+{
+namespace core
+{
+
+// Size of the cache lines elements are padded to
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Contiguous array whose size is set at construction, elements are built in place from
+// factory(index) so that they do not need to be copyable nor movable (checkups and
+// estimators publish their reports through atomics).
+// Each element is aligned and padded to a cache line, elements are per IMU states updated by
+// different threads which must not invalidate each other cache lines (false sharing).
+template<typename T>
+class FixedArray
+{
+  struct alignas(alignof(T) > CACHE_LINE_SIZE ? alignof(T) : CACHE_LINE_SIZE) Slot
+  {
+    T value;
+  };
+
+  template<typename Value, typename SlotPointer>
+  class Iterator
+  {
+public:
+    explicit Iterator(SlotPointer slot)
+    : slot_(slot)
+    {
+    }
+
+    Value & operator*()const
+    {
+      return slot_->value;
+    }
+
+    Value * operator->()const
+    {
+      return &slot_->value;
+    }
+
+    Iterator & operator++()
+    {
+      ++slot_;
+      return *this;
+    }
+
+    bool operator==(const Iterator & other)const
+    {
+      return slot_ == other.slot_;
+    }
+
+    bool operator!=(const Iterator & other)const
+    {
+      return slot_ != other.slot_;
+    }
+
+private:
+    SlotPointer slot_;
+  };
+
+public:
+  using iterator = Iterator<T, Slot *>;
+  using const_iterator = Iterator<const T, const Slot *>;
+
+public:
+  template<typename Factory>
+  FixedArray(const size_t & size, Factory && factory)
+  : data_(static_cast<Slot *>(
+        ::operator new(size * sizeof(Slot), std::align_val_t(alignof(Slot))))),
+    size_(0)
+  {
+    try {
+      for (; size_ < size; ++size_) {
+        new (data_ + size_) Slot{factory(size_)};
+      }
+    } catch (...) {
+      destroy_();
+      throw;
+    }
+  }
+
+  ~FixedArray()
+  {
+    destroy_();
+  }
+
+  FixedArray(const FixedArray &) = delete;
+  FixedArray & operator=(const FixedArray &) = delete;
+
+  size_t size()const
+  {
+    return size_;
+  }
+
+  T & operator[](const size_t & index)
+  {
+    return data_[index].value;
+  }
+
+  const T & operator[](const size_t & index)const
+  {
+    return data_[index].value;
+  }
+
+  iterator begin()
+  {
+    return iterator(data_);
+  }
+
+  iterator end()
+  {
+    return iterator(data_ + size_);
+  }
+
+  const_iterator begin()const
+  {
+    return const_iterator(data_);
+  }
+
+  const_iterator end()const
+  {
+    return const_iterator(data_ + size_);
+  }
+
+private:
+  void destroy_()
+  {
+    while (size_ > 0) {
+      data_[--size_].~Slot();
+    }
+    ::operator delete(data_, std::align_val_t(alignof(Slot)));
+  }
+
+private:
+  Slot * data_;
+  size_t size_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__FIXEDARRAY_HPP_
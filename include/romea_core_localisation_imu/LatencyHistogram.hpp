@@ -0,0 +1,109 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__LATENCYHISTOGRAM_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__LATENCYHISTOGRAM_HPP_
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+
+// std
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace romea
+{
+namespace core
+{
+
+struct LatencyStage
+{
+  enum Stage : uint32_t
+  {
+    // recorded per IMU, once per call or per chunk of a batch
+    INERTIAL_MEASUREMENT_RATE_CHECKUP = 0,
+    INERTIAL_MEASUREMENT_FRAMES = 1,  // acceleration and angular speed frame creation
+    INERTIAL_MEASUREMENT_CHECKUP = 2,
+    ANGULAR_SPEED_BIAS_ESTIMATION = 3,
+    ATTITUDE_RATE_CHECKUP = 4,
+    ATTITUDE_CHECKUP = 5,  // includes frame creation
+    ATTITUDE_PROPAGATION = 6,
+    ANGULAR_SPEED_INTEGRATION = 7,
+    SPIKE_REJECTION = 8,
+    // recorded once per report, not related to an IMU
+    HEART_BEATS = 9,
+    REPORT = 10  // report sections update and assembly
+  };
+
+  static constexpr size_t NUMBER_OF_IMU_STAGES = 9;
+  static constexpr size_t NUMBER_OF_STAGES = 11;
+
+  // snake case name used in diagnostic reports
+  static const char * toString(const Stage & stage);
+};
+
+// Latency histogram with fixed power of two buckets.
+// Bucket k counts latencies from 2^k to 2^(k+1) nanoseconds, the first bucket also counts
+// latencies below 1 ns and the last one every latency above. Recording costs a few relaxed
+// loads and stores: it must only be done from one thread at a time, but histogram can be read
+// from any thread meanwhile.
+class LatencyHistogram
+{
+public:
+  static constexpr size_t NUMBER_OF_BUCKETS = 32;
+
+public:
+  LatencyHistogram();
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram & operator=(const LatencyHistogram &) = delete;
+
+  void record(const Duration & latency)
+  {
+    const int64_t nanoseconds = latency.count();
+    size_t bucket = 0;
+    while (bucket + 1 < NUMBER_OF_BUCKETS && (nanoseconds >> (bucket + 1)) != 0) {
+      ++bucket;
+    }
+
+    std::atomic<uint64_t> & counter = buckets_[bucket];
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (nanoseconds > maximum_.load(std::memory_order_relaxed)) {
+      maximum_.store(nanoseconds, std::memory_order_relaxed);
+    }
+    count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  uint64_t getCount()const;
+
+  uint64_t getBucketCount(const size_t & bucket)const;
+
+  // upper bound of the bucket holding given percentile (0 to 100), bounded by maximum latency
+  Duration getPercentile(const double & percentile)const;
+
+  Duration getMaximum()const;
+
+private:
+  std::array<std::atomic<uint64_t>, NUMBER_OF_BUCKETS> buckets_;
+  std::atomic<int64_t> maximum_;
+  std::atomic<uint64_t> count_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__LATENCYHISTOGRAM_HPP_
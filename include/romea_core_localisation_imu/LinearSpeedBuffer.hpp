@@ -0,0 +1,74 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__LINEARSPEEDBUFFER_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__LINEARSPEEDBUFFER_HPP_
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace romea
+{
+namespace core
+{
+
+// Lock free single producer / single consumer ring of stamped linear speeds.
+// The producer (odometry thread) never waits and overwrites the oldest speeds,
+// the consumer (IMU thread) interpolates speed at IMU stamps from the latest ones.
+class LinearSpeedBuffer
+{
+public:
+  static constexpr size_t CAPACITY = 64;
+
+public:
+  explicit LinearSpeedBuffer(const Duration & maximalAge);
+
+  void push(const Duration & stamp, const double & linearSpeed);
+
+  // NaN when no speed close enough to stamp is available, when speeds around stamp are
+  // further apart than maximal age or when they have already been overwritten
+  double interpolate(const Duration & stamp)const;
+
+private:
+  struct Slot
+  {
+    std::atomic<uint64_t> sequence;
+    std::atomic<Duration::rep> stamp;
+    std::atomic<double> linearSpeed;
+  };
+
+  struct Entry
+  {
+    Duration stamp;
+    double linearSpeed;
+  };
+
+  bool read_(const uint64_t & index, Entry & entry)const;
+
+private:
+  Duration maximalAge_;
+  std::atomic<uint64_t> head_;
+  std::array<Slot, CAPACITY> slots_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__LINEARSPEEDBUFFER_HPP_
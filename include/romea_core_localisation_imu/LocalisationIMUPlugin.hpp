@@ -19,32 +19,46 @@
 
 // romea
 #include <romea_core_imu/IMUAHRS.hpp>
-#include <romea_core_common/log/SimpleFileLogger.hpp>
-#include <romea_core_common/diagnostic/CheckupRate.hpp>
 #include <romea_core_localisation/ObservationAngularSpeed.hpp>
 #include <romea_core_localisation/ObservationAttitude.hpp>
 
 // std
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 // local
-#include "romea_core_localisation_imu/CheckupInertialMeasurements.hpp"
-#include "romea_core_localisation_imu/CheckupAttitude.hpp"
-#include "romea_core_localisation_imu/AngularSpeedBias.hpp"
+#include "romea_core_localisation_imu/InertialMeasurementsBatch.hpp"
+#include "romea_core_localisation_imu/LocalisationIMUPluginStages.hpp"
+#include "romea_core_localisation_imu/LocalisationMultiIMUPlugin.hpp"
 
 namespace romea
 {
 namespace core
 {
 
-class LocalisationIMUPlugin
+// Plugin for vehicles carrying a single IMU, stages are selected by the Stages policy
+template<typename Stages>
+class BasicLocalisationIMUPlugin
 {
 public:
-  explicit LocalisationIMUPlugin(std::unique_ptr<IMUAHRS> imu);
+  explicit BasicLocalisationIMUPlugin(std::unique_ptr<IMUAHRS> imu);
 
+  // record sample stream in a binary log, to be called before processing samples
   void enableDebugLog(const std::string & logFilename);
 
+  // move diagnostics to a background thread, to be called before processing samples
+  void enableDiagnosticAggregation(const Duration & period = durationFromSecond(0.1));
+
+  // emit one angular speed observation per group of numberOfSamples accepted samples, or per
+  // window duration when shorter, averaged with a variance scaled accordingly. Rejected
+  // samples are left out of averages and counted in diagnostic report. To be called before
+  // processing samples
+  void enableDecimation(
+    const size_t & numberOfSamples,
+    const Duration & windowDuration = Duration::max());
+
   void processLinearSpeed(
     const Duration & stamp,
     const double & linearSpeed);
@@ -59,6 +73,16 @@ public:
     const double & angularSpeedAroundZAxis,
     ObservationAngularSpeed & angularSpeed);
 
+  // when attitude propagation stage is enabled, roll and pitch are propagated from attitude
+  // frames with bias corrected angular speeds and filled at each sample if attitudes are given,
+  // attitude validities are filled if given as well
+  size_t computeAngularSpeeds(
+    const InertialMeasurementsBatch & measurements,
+    ObservationAngularSpeed * angularSpeeds,
+    bool * validities,
+    ObservationAttitude * attitudes = nullptr,
+    bool * attitudeValidities = nullptr);
+
   bool computeAttitude(
     const Duration & stamp,
     const double & rollAngle,
@@ -66,28 +90,260 @@ public:
     const double & courseAngle,
     ObservationAttitude & attitude);
 
+  // attitude propagated up to last inertial measurement, return false when it is not available
+  bool getPropagatedAttitude(ObservationAttitude & attitude)const;
+
+  // when angular speed integration stage is enabled, angles swept by bias corrected angular
+  // speeds since previous call, with their covariance. Must only be called from one thread at
+  // a time, return false when no sample has been integrated meanwhile
+  bool popDeltaAngles(DeltaAngles & deltaAngles);
+
+  // same as above but cut at stamp, return false until a sample stamped at or after stamp has
+  // been integrated
+  bool popDeltaAngles(
+    const Duration & stamp,
+    DeltaAngles & deltaAngles);
+
+  // timeouts are detected at stamp, when diagnostics are aggregated they are detected by
+  // background thread and the last report it built is returned
   DiagnosticReport makeDiagnosticReport(const Duration & stamp);
 
-private:
-  void checkHeartBeats_(const Duration & stamp);
+  // incremented each time a checkup status changes
+  uint64_t getDiagnosticStatusGeneration()const;
 
-  DiagnosticReport makeDiagnosticReport_();
+  // must only be called from one thread at a time, return false when no transition is queued
+  bool popDiagnosticStatusTransition(DiagnosticStatusTransition & transition);
 
-private:
-  std::unique_ptr<IMUAHRS> imu_;
-  AngularSpeedBias imuAngularSpeedBias_;
-  std::atomic<double> linearSpeed_;
+  DiagnosticStatus getDiagnosticStatus(const DiagnosticStatusTransition::Checkup & checkup)const;
+
+  // warm start angular speed bias from a file saved for the same sensor, return false
+  // if file is missing, corrupted or written for another sensor. Prior is written without
+  // synchronisation, so it must be loaded before any sample is processed
+  bool loadAngularSpeedBias(const std::string & filename);
+
+  // return false if no angular speed bias has been estimated yet
+  bool saveAngularSpeedBias(const std::string & filename)const;
+
+  // optional sensor temperature, standstill biases are then learnt per degree and used
+  // whenever no bias is estimated, can be called from any thread
+  void setTemperature(const double & temperature);
 
-  CheckupGreaterThanRate attitudeRateDiagnostic_;
-  CheckupGreaterThanRate linearSpeedRateDiagnostic_;
-  CheckupGreaterThanRate inertialMeasurementRateDiagnostic_;
+  // bias versus temperature table, to be loaded before first sample, return false if file is
+  // missing, corrupted or written for another sensor
+  bool loadAngularSpeedBiasTable(const std::string & filename);
 
-  CheckupAttitude attitudeDiagnostic_;
-  CheckupInertialMeasurements inertialMeasurementDiagnostic_;
+  // throw std::runtime_error if file cannot be written
+  void saveAngularSpeedBiasTable(const std::string & filename)const;
 
-  SimpleFileLogger debugLogger_;
+  const LatencyHistogram & getLatencyHistogram(const LatencyStage::Stage & stage)const;
+
+private:
+  static std::vector<std::unique_ptr<IMUAHRS>> makeIMUs_(std::unique_ptr<IMUAHRS> imu);
+
+private:
+  BasicLocalisationMultiIMUPlugin<Stages> plugin_;
 };
 
+//-----------------------------------------------------------------------------
+template<typename Stages>
+BasicLocalisationIMUPlugin<Stages>::BasicLocalisationIMUPlugin(std::unique_ptr<IMUAHRS> imu)
+: plugin_(makeIMUs_(std::move(imu)))
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationIMUPlugin<Stages>::enableDebugLog(const std::string & logFilename)
+{
+  plugin_.enableDebugLog(logFilename);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationIMUPlugin<Stages>::enableDiagnosticAggregation(const Duration & period)
+{
+  plugin_.enableDiagnosticAggregation(period);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationIMUPlugin<Stages>::enableDecimation(
+  const size_t & numberOfSamples,
+  const Duration & windowDuration)
+{
+  plugin_.enableDecimation(numberOfSamples, windowDuration);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationIMUPlugin<Stages>::processLinearSpeed(
+  const Duration & stamp,
+  const double & linearSpeed)
+{
+  plugin_.processLinearSpeed(stamp, linearSpeed);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::computeAngularSpeed(
+  const Duration & stamp,
+  const double & accelerationAlongXAxis,
+  const double & accelerationAlongYAxis,
+  const double & accelerationAlongZAxis,
+  const double & angularSpeedAroundXAxis,
+  const double & angularSpeedAroundYAxis,
+  const double & angularSpeedAroundZAxis,
+  ObservationAngularSpeed & angularSpeed)
+{
+  return plugin_.computeAngularSpeed(
+    0,
+    stamp,
+    accelerationAlongXAxis,
+    accelerationAlongYAxis,
+    accelerationAlongZAxis,
+    angularSpeedAroundXAxis,
+    angularSpeedAroundYAxis,
+    angularSpeedAroundZAxis,
+    angularSpeed);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+size_t BasicLocalisationIMUPlugin<Stages>::computeAngularSpeeds(
+  const InertialMeasurementsBatch & measurements,
+  ObservationAngularSpeed * angularSpeeds,
+  bool * validities,
+  ObservationAttitude * attitudes,
+  bool * attitudeValidities)
+{
+  return plugin_.computeAngularSpeeds(
+    0, measurements, angularSpeeds, validities, attitudes, attitudeValidities);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::computeAttitude(
+  const Duration & stamp,
+  const double & rollAngle,
+  const double & pitchAngle,
+  const double & courseAngle,
+  ObservationAttitude & attitude)
+{
+  return plugin_.computeAttitude(0, stamp, rollAngle, pitchAngle, courseAngle, attitude);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::getPropagatedAttitude(
+  ObservationAttitude & attitude)const
+{
+  return plugin_.getPropagatedAttitude(0, attitude);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::popDeltaAngles(DeltaAngles & deltaAngles)
+{
+  return plugin_.popDeltaAngles(0, deltaAngles);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::popDeltaAngles(
+  const Duration & stamp,
+  DeltaAngles & deltaAngles)
+{
+  return plugin_.popDeltaAngles(0, stamp, deltaAngles);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+DiagnosticReport BasicLocalisationIMUPlugin<Stages>::makeDiagnosticReport(const Duration & stamp)
+{
+  return plugin_.makeDiagnosticReport(stamp);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+uint64_t BasicLocalisationIMUPlugin<Stages>::getDiagnosticStatusGeneration()const
+{
+  return plugin_.getDiagnosticStatusGeneration();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::popDiagnosticStatusTransition(
+  DiagnosticStatusTransition & transition)
+{
+  return plugin_.popDiagnosticStatusTransition(transition);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+DiagnosticStatus BasicLocalisationIMUPlugin<Stages>::getDiagnosticStatus(
+  const DiagnosticStatusTransition::Checkup & checkup)const
+{
+  return plugin_.getDiagnosticStatus(checkup, 0);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::loadAngularSpeedBias(const std::string & filename)
+{
+  return plugin_.loadAngularSpeedBias(0, filename);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::saveAngularSpeedBias(const std::string & filename)const
+{
+  return plugin_.saveAngularSpeedBias(0, filename);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationIMUPlugin<Stages>::setTemperature(const double & temperature)
+{
+  plugin_.setTemperature(0, temperature);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationIMUPlugin<Stages>::loadAngularSpeedBiasTable(const std::string & filename)
+{
+  return plugin_.loadAngularSpeedBiasTable(0, filename);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationIMUPlugin<Stages>::saveAngularSpeedBiasTable(
+  const std::string & filename)const
+{
+  plugin_.saveAngularSpeedBiasTable(0, filename);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+const LatencyHistogram & BasicLocalisationIMUPlugin<Stages>::getLatencyHistogram(
+  const LatencyStage::Stage & stage)const
+{
+  return plugin_.getLatencyHistogram(stage, 0);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+std::vector<std::unique_ptr<IMUAHRS>> BasicLocalisationIMUPlugin<Stages>::makeIMUs_(
+  std::unique_ptr<IMUAHRS> imu)
+{
+  std::vector<std::unique_ptr<IMUAHRS>> imus;
+  imus.push_back(std::move(imu));
+  return imus;
+}
+
+// fully featured plugin, instantiated once in the library
+extern template class BasicLocalisationIMUPlugin<LocalisationIMUPluginStages>;
+using LocalisationIMUPlugin = BasicLocalisationIMUPlugin<LocalisationIMUPluginStages>;
+
 }  // namespace core
 }  // namespace romea
 
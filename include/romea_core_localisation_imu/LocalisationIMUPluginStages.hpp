@@ -0,0 +1,80 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__LOCALISATIONIMUPLUGINSTAGES_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__LOCALISATIONIMUPLUGINSTAGES_HPP_
+
+namespace romea
+{
+namespace core
+{
+
+// Processing stages of IMU plugins, selected at compile time.
+// Main stages are enabled by default, a reduced pipeline is declared by deriving from this
+// policy and hiding the flags of the stages to remove or the scalar type, for instance:
+//
+//   struct RawAngularSpeedStages : LocalisationIMUPluginStages
+//   {
+//     static constexpr bool ANGULAR_SPEED_BIAS_ESTIMATION = false;
+//     static constexpr bool DEBUG_LOG = false;
+//   };
+//
+// Disabled stages neither hold state nor cost anything on the sample path, their checkup
+// statuses stay stale and they are left out of diagnostic reports.
+struct LocalisationIMUPluginStages
+{
+  // attitude angles within vehicle limits
+  static constexpr bool ATTITUDE_CHECKUP = true;
+  static constexpr bool ATTITUDE_RATE_CHECKUP = true;
+
+  // single sample spikes of accelerations and angular speeds replaced by window medians before
+  // range checkup and bias estimation, off by default since it costs more than both
+  static constexpr bool SPIKE_REJECTION = false;
+
+  // accelerations and angular speeds within sensor ranges
+  static constexpr bool INERTIAL_MEASUREMENT_CHECKUP = true;
+  static constexpr bool INERTIAL_MEASUREMENT_RATE_CHECKUP = true;
+
+  static constexpr bool LINEAR_SPEED_RATE_CHECKUP = true;
+
+  // when disabled, raw angular speeds around z axis are used as observations
+  static constexpr bool ANGULAR_SPEED_BIAS_ESTIMATION = true;
+
+  // recursive bias filter instead of moving average, observation variances are then inflated
+  // by bias variance
+  static constexpr bool RECURSIVE_ANGULAR_SPEED_BIAS_ESTIMATION = false;
+
+  // roll and pitch propagated at inertial measurement rate between attitude frames, off by
+  // default since it needs the three gyro axes at each sample
+  static constexpr bool ATTITUDE_PROPAGATION = false;
+
+  // bias corrected angular speeds pre-integrated into delta angles, to be popped at filter
+  // update rate instead of using every angular speed observation
+  static constexpr bool ANGULAR_SPEED_INTEGRATION = false;
+
+  static constexpr bool DEBUG_LOG = true;
+
+  // steady clock timing of each processing stage, off by default since reading the clock
+  // costs more than some of the stages it measures
+  static constexpr bool LATENCY_HISTOGRAMS = false;
+
+  // storage and accumulation type of bias estimator windows, float or double
+  using Scalar = double;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__LOCALISATIONIMUPLUGINSTAGES_HPP_
@@ -0,0 +1,1364 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__LOCALISATIONMULTIIMUPLUGIN_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__LOCALISATIONMULTIIMUPLUGIN_HPP_
+
+
+// romea
+#include <romea_core_imu/IMUAHRS.hpp>
+#include <romea_core_localisation/ObservationAngularSpeed.hpp>
+#include <romea_core_localisation/ObservationAttitude.hpp>
+
+// std
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// local
+#include "romea_core_localisation_imu/AngularSpeedBias.hpp"
+#include "romea_core_localisation_imu/AngularSpeedBiasPrior.hpp"
+#include "romea_core_localisation_imu/AngularSpeedDecimator.hpp"
+#include "romea_core_localisation_imu/AngularSpeedIntegrator.hpp"
+#include "romea_core_localisation_imu/AttitudePropagator.hpp"
+#include "romea_core_localisation_imu/CheckupAttitude.hpp"
+#include "romea_core_localisation_imu/CheckupInertialMeasurements.hpp"
+#include "romea_core_localisation_imu/CheckupSampleRate.hpp"
+#include "romea_core_localisation_imu/DebugLog.hpp"
+#include "romea_core_localisation_imu/DiagnosticAggregator.hpp"
+#include "romea_core_localisation_imu/DiagnosticReportCache.hpp"
+#include "romea_core_localisation_imu/DiagnosticStatusMonitor.hpp"
+#include "romea_core_localisation_imu/FixedArray.hpp"
+#include "romea_core_localisation_imu/InertialMeasurementsBatch.hpp"
+#include "romea_core_localisation_imu/LatencyHistogram.hpp"
+#include "romea_core_localisation_imu/LinearSpeedBuffer.hpp"
+#include "romea_core_localisation_imu/LocalisationIMUPluginStages.hpp"
+#include "romea_core_localisation_imu/SpikeFilter.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Plugin for vehicles carrying several IMUs sharing the same odometry.
+// Each kind of per IMU state (bias estimator, checkups) is stored in its own contiguous
+// array indexed by IMU. IMUs share no mutable state except buffered linear speeds, which
+// are read without lock, so each IMU can be processed from its own thread.
+// Diagnostics of all IMUs are gathered in one report, prefixed by imu<index> when
+// there are several IMUs. The report is cached section by section, only sections whose
+// values changed since previous report are rebuilt. Status transitions of every checkup are
+// also recorded, so that supervisors can poll a generation counter instead of reports.
+//
+// When diagnostics are aggregated, sample threads only create frames, apply range checks and
+// bias correction: sample rates, heartbeats and report are handled by a background thread fed
+// with sample stamps, and samples are gated with the last rate statuses it published.
+//
+// Processing stages are selected at compile time by the Stages policy, see
+// LocalisationIMUPluginStages. Stages that are disabled are removed by if constexpr and
+// their per IMU arrays are left empty. When latency histograms are enabled, the time spent
+// in each stage is recorded per IMU and summarized in the diagnostic report.
+template<typename Stages>
+class BasicLocalisationMultiIMUPlugin
+{
+public:
+  explicit BasicLocalisationMultiIMUPlugin(std::vector<std::unique_ptr<IMUAHRS>> imus);
+
+  size_t getNumberOfIMUs()const;
+
+  // record sample stream in a binary log, to be called before processing samples
+  void enableDebugLog(const std::string & logFilename);
+
+  // move diagnostics to a background thread, to be called before processing samples
+  void enableDiagnosticAggregation(const Duration & period = durationFromSecond(0.1));
+
+  // average angular speed observations of every IMU over groups of accepted samples, see
+  // AngularSpeedDecimator, to be called before processing samples
+  void enableDecimation(
+    const size_t & numberOfSamples,
+    const Duration & windowDuration = Duration::max());
+
+  void processLinearSpeed(
+    const Duration & stamp,
+    const double & linearSpeed);
+
+  bool computeAngularSpeed(
+    const size_t & imuIndex,
+    const Duration & stamp,
+    const double & accelerationAlongXAxis,
+    const double & accelerationAlongYAxis,
+    const double & accelerationAlongZAxis,
+    const double & angularSpeedAroundXAxis,
+    const double & angularSpeedAroundYAxis,
+    const double & angularSpeedAroundZAxis,
+    ObservationAngularSpeed & angularSpeed);
+
+  // attitudes propagated at each sample and their own validities are each filled when not
+  // null and attitude propagation stage is enabled
+  size_t computeAngularSpeeds(
+    const size_t & imuIndex,
+    const InertialMeasurementsBatch & measurements,
+    ObservationAngularSpeed * angularSpeeds,
+    bool * validities,
+    ObservationAttitude * attitudes = nullptr,
+    bool * attitudeValidities = nullptr);
+
+  bool computeAttitude(
+    const size_t & imuIndex,
+    const Duration & stamp,
+    const double & rollAngle,
+    const double & pitchAngle,
+    const double & courseAngle,
+    ObservationAttitude & attitude);
+
+  // attitude propagated up to last inertial measurement, to be called from the thread
+  // computing angular speeds, return false when it is not available or stage is disabled
+  bool getPropagatedAttitude(
+    const size_t & imuIndex,
+    ObservationAttitude & attitude)const;
+
+  // angles swept by bias corrected angular speeds since previous call, must only be called
+  // from one thread at a time for a given IMU, return false when no sample has been integrated
+  // meanwhile or stage is disabled
+  bool popDeltaAngles(
+    const size_t & imuIndex,
+    DeltaAngles & deltaAngles);
+
+  // same as above but cut at stamp, return false until a sample stamped at or after stamp has
+  // been integrated
+  bool popDeltaAngles(
+    const size_t & imuIndex,
+    const Duration & stamp,
+    DeltaAngles & deltaAngles);
+
+  // timeouts are detected at stamp, when diagnostics are aggregated they are detected by
+  // background thread and the last report it built is returned
+  DiagnosticReport makeDiagnosticReport(const Duration & stamp);
+
+  // incremented each time a checkup status changes
+  uint64_t getDiagnosticStatusGeneration()const;
+
+  // must only be called from one thread at a time, return false when no transition is queued
+  bool popDiagnosticStatusTransition(DiagnosticStatusTransition & transition);
+
+  DiagnosticStatus getDiagnosticStatus(
+    const DiagnosticStatusTransition::Checkup & checkup,
+    const size_t & imuIndex)const;
+
+  // prior is written without synchronisation, it must be loaded before any sample of this
+  // IMU is processed. Return false if file is missing, corrupted or written for another sensor
+  bool loadAngularSpeedBias(
+    const size_t & imuIndex,
+    const std::string & filename);
+
+  bool saveAngularSpeedBias(
+    const size_t & imuIndex,
+    const std::string & filename)const;
+
+  // optional sensor temperature, can be called from any thread
+  void setTemperature(
+    const size_t & imuIndex,
+    const double & temperature);
+
+  bool loadAngularSpeedBiasTable(
+    const size_t & imuIndex,
+    const std::string & filename);
+
+  void saveAngularSpeedBiasTable(
+    const size_t & imuIndex,
+    const std::string & filename)const;
+
+  // imuIndex is ignored for stages not related to an IMU, histograms stay empty when latency
+  // histograms are disabled
+  const LatencyHistogram & getLatencyHistogram(
+    const LatencyStage::Stage & stage,
+    const size_t & imuIndex)const;
+
+private:
+  static constexpr double LINEAR_SPEED_MAXIMAL_AGE = 0.3;
+  static constexpr size_t BATCH_CHUNK_SIZE = 32;
+
+  // linear speed rate, debug log and diagnostic aggregator drops, report latencies
+  static constexpr size_t NUMBER_OF_PLUGIN_REPORT_SECTIONS = 4;
+  // attitude rate, attitude, inertial measurement rate, inertial measurements, angular speed bias,
+  // latencies, decimation and spikes
+  static constexpr size_t NUMBER_OF_IMU_REPORT_SECTIONS = 8;
+
+  // diagnostic events carry the checkup of the sample rate to evaluate or a heartbeat
+  static constexpr uint32_t HEART_BEAT_EVENT = DiagnosticStatusTransition::NUMBER_OF_CHECKUPS;
+
+  bool hasDebugLog_()const;
+
+  // current time when latency histograms are enabled, clock is not read otherwise
+  static std::chrono::steady_clock::time_point startLatency_();
+
+  // record time elapsed since start, return current time so that stages can be chained
+  std::chrono::steady_clock::time_point recordLatency_(
+    const LatencyStage::Stage & stage,
+    const size_t & imuIndex,
+    const std::chrono::steady_clock::time_point & start);
+
+  size_t latencyIndex_(
+    const LatencyStage::Stage & stage,
+    const size_t & imuIndex)const;
+
+  uint64_t countLatencies_(
+    const size_t & firstStage,
+    const size_t & lastStage,
+    const size_t & imuIndex)const;
+
+  DiagnosticReport makeLatencyReport_(
+    const size_t & firstStage,
+    const size_t & lastStage,
+    const size_t & imuIndex)const;
+
+  bool checkSampleRate_(
+    const DiagnosticStatusTransition::Checkup & checkup,
+    const size_t & imuIndex,
+    const Duration & stamp,
+    CheckupSampleRate & rateDiagnostic,
+    const std::atomic<DiagnosticStatus> & rateStatus);
+
+  DiagnosticStatus evaluateSampleRate_(
+    const DiagnosticStatusTransition::Checkup & checkup,
+    const size_t & imuIndex,
+    const Duration & stamp,
+    CheckupSampleRate & rateDiagnostic);
+
+  // biases of the three axes once estimated, null otherwise
+  size_t computeAngularSpeeds_(
+    const size_t & imuIndex,
+    const InertialMeasurementsBatch & measurements,
+    const size_t & begin,
+    const size_t & end,
+    ObservationAngularSpeed * angularSpeeds,
+    bool * validities,
+    ObservationAttitude * attitudes,
+    bool * attitudeValidities);
+
+  void checkHeartBeats_(const Duration & stamp);
+
+  DiagnosticReport makeDiagnosticReport_();
+
+  void processDiagnosticEvent_(const DiagnosticEvent & event);
+
+  DiagnosticReport makeIMUReport_(
+    const size_t & imuIndex,
+    DiagnosticReport imuReport)const;
+
+private:
+  std::vector<std::unique_ptr<IMUAHRS>> imus_;
+  FixedArray<BasicAngularSpeedBias<typename Stages::Scalar>> imuAngularSpeedBiases_;
+  FixedArray<CheckupSampleRate> attitudeRateDiagnostics_;
+  FixedArray<CheckupSampleRate> inertialMeasurementRateDiagnostics_;
+  FixedArray<CheckupAttitude> attitudeDiagnostics_;
+  FixedArray<CheckupInertialMeasurements> inertialMeasurementDiagnostics_;
+  FixedArray<SpikeFilter> spikeFilters_;
+  FixedArray<AttitudePropagator> attitudePropagators_;
+  FixedArray<AngularSpeedIntegrator> angularSpeedIntegrators_;
+
+  LinearSpeedBuffer linearSpeeds_;
+  CheckupSampleRate linearSpeedRateDiagnostic_;
+
+  // rate statuses published by diagnostic aggregator
+  FixedArray<std::atomic<DiagnosticStatus>> attitudeRateStatuses_;
+  FixedArray<std::atomic<DiagnosticStatus>> inertialMeasurementRateStatuses_;
+  std::atomic<DiagnosticStatus> linearSpeedRateStatus_;
+
+  std::unique_ptr<DebugLog> debugLog_;
+  std::unique_ptr<FixedArray<AngularSpeedDecimator>> angularSpeedDecimators_;
+
+  // per IMU stages of each IMU followed by report stages, empty when disabled
+  FixedArray<LatencyHistogram> latencyHistograms_;
+
+  // heart beat checks, report cache and their latency histograms have a single writer at a
+  // time, reports may be asked from several threads
+  std::mutex diagnosticReportMutex_;
+  DiagnosticReportCache diagnosticReport_;
+  DiagnosticStatusMonitor diagnosticStatuses_;
+
+  // declared last so that aggregator thread is stopped before the state it reads is destroyed
+  std::unique_ptr<DiagnosticAggregator> diagnosticAggregator_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+BasicLocalisationMultiIMUPlugin<Stages>::BasicLocalisationMultiIMUPlugin(
+  std::vector<std::unique_ptr<IMUAHRS>> imus)
+: imus_(std::move(imus)),
+  imuAngularSpeedBiases_(
+    Stages::ANGULAR_SPEED_BIAS_ESTIMATION ? imus_.size() : 0, [this](const size_t & n) {
+      return BasicAngularSpeedBias<typename Stages::Scalar>(imus_[n]->getRate(),
+        imus_[n]->getAccelerationStd(),
+        imus_[n]->getAngularSpeedStd(),
+        Stages::RECURSIVE_ANGULAR_SPEED_BIAS_ESTIMATION ?
+        AngularSpeedBiasEstimation::RECURSIVE_FILTER :
+        AngularSpeedBiasEstimation::MOVING_AVERAGE);
+    }),
+  attitudeRateDiagnostics_(
+    Stages::ATTITUDE_RATE_CHECKUP ? imus_.size() : 0, [this](const size_t & n) {
+      return CheckupSampleRate("attitude",
+        imus_[n]->getRate(),
+        imus_[n]->getRate() * 0.1);
+    }),
+  inertialMeasurementRateDiagnostics_(
+    Stages::INERTIAL_MEASUREMENT_RATE_CHECKUP ? imus_.size() : 0, [this](const size_t & n) {
+      return CheckupSampleRate("inertial_measurements",
+        imus_[n]->getRate(),
+        imus_[n]->getRate() * 0.1);
+    }),
+  attitudeDiagnostics_(
+    Stages::ATTITUDE_CHECKUP ? imus_.size() : 0, [](const size_t &) {
+      return CheckupAttitude();
+    }),
+  inertialMeasurementDiagnostics_(
+    Stages::INERTIAL_MEASUREMENT_CHECKUP ? imus_.size() : 0, [this](const size_t & n) {
+      return CheckupInertialMeasurements(imus_[n]->getAccelerationRange(),
+        imus_[n]->getAngularSpeedRange());
+    }),
+  spikeFilters_(
+    Stages::SPIKE_REJECTION ? imus_.size() : 0, [this](const size_t & n) {
+      return SpikeFilter(imus_[n]->getAccelerationStd(), imus_[n]->getAngularSpeedStd());
+    }),
+  attitudePropagators_(
+    Stages::ATTITUDE_PROPAGATION ? imus_.size() : 0, [this](const size_t & n) {
+      return AttitudePropagator(imus_[n]->getRate(),
+        imus_[n]->getAngleVariance(),
+        imus_[n]->getAngularSpeedVariance());
+    }),
+  angularSpeedIntegrators_(
+    Stages::ANGULAR_SPEED_INTEGRATION ? imus_.size() : 0, [this](const size_t & n) {
+      return AngularSpeedIntegrator(imus_[n]->getRate(), imus_[n]->getAngularSpeedVariance());
+    }),
+  linearSpeeds_(romea::core::durationFromSecond(LINEAR_SPEED_MAXIMAL_AGE)),
+  linearSpeedRateDiagnostic_("linear_speed", 10.0, 1.),
+  attitudeRateStatuses_(
+    Stages::ATTITUDE_RATE_CHECKUP ? imus_.size() : 0, [](const size_t &) {
+      return std::atomic<DiagnosticStatus>(DiagnosticStatus::ERROR);
+    }),
+  inertialMeasurementRateStatuses_(
+    Stages::INERTIAL_MEASUREMENT_RATE_CHECKUP ? imus_.size() : 0, [](const size_t &) {
+      return std::atomic<DiagnosticStatus>(DiagnosticStatus::ERROR);
+    }),
+  linearSpeedRateStatus_(DiagnosticStatus::ERROR),
+  debugLog_(),
+  angularSpeedDecimators_(),
+  latencyHistograms_(
+    Stages::LATENCY_HISTOGRAMS ?
+    LatencyStage::NUMBER_OF_IMU_STAGES * imus_.size() +
+    LatencyStage::NUMBER_OF_STAGES - LatencyStage::NUMBER_OF_IMU_STAGES : 0,
+    [](const size_t &) {
+      return LatencyHistogram();
+    }),
+  diagnosticReportMutex_(),
+  diagnosticReport_(
+    NUMBER_OF_PLUGIN_REPORT_SECTIONS + NUMBER_OF_IMU_REPORT_SECTIONS * imus_.size()),
+  diagnosticStatuses_(imus_.size()),
+  diagnosticAggregator_()
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+size_t BasicLocalisationMultiIMUPlugin<Stages>::getNumberOfIMUs()const
+{
+  return imus_.size();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationMultiIMUPlugin<Stages>::enableDebugLog(const std::string & logFilename)
+{
+  static_assert(Stages::DEBUG_LOG, "debug log stage is disabled");
+  debugLog_ = std::make_unique<DebugLog>(logFilename);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationMultiIMUPlugin<Stages>::enableDiagnosticAggregation(
+  const Duration & period)
+{
+  diagnosticAggregator_ = std::make_unique<DiagnosticAggregator>(
+    [this](const DiagnosticEvent & event) {
+      processDiagnosticEvent_(event);
+    },
+    [this]() {
+      std::lock_guard<std::mutex> lock(diagnosticReportMutex_);
+      return makeDiagnosticReport_();
+    },
+    period);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationMultiIMUPlugin<Stages>::enableDecimation(
+  const size_t & numberOfSamples,
+  const Duration & windowDuration)
+{
+  angularSpeedDecimators_ = std::make_unique<FixedArray<AngularSpeedDecimator>>(
+    imus_.size(), [this, numberOfSamples, windowDuration](const size_t & n) {
+      return AngularSpeedDecimator(imus_[n]->getRate(), numberOfSamples, windowDuration);
+    });
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationMultiIMUPlugin<Stages>::processLinearSpeed(
+  const Duration & stamp,
+  const double & linearSpeed)
+{
+  if (hasDebugLog_()) {
+    debugLog_->log(DebugLogRecord::LINEAR_SPEED, 0, stamp, linearSpeed);
+  }
+
+  if constexpr (Stages::LINEAR_SPEED_RATE_CHECKUP) {
+    if (!checkSampleRate_(
+        DiagnosticStatusTransition::LINEAR_SPEED_RATE,
+        0,
+        stamp,
+        linearSpeedRateDiagnostic_,
+        linearSpeedRateStatus_))
+    {
+      return;
+    }
+  }
+
+  linearSpeeds_.push(stamp, linearSpeed);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::hasDebugLog_()const
+{
+  // folded to false when debug log stage is disabled
+  return Stages::DEBUG_LOG && debugLog_ != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+std::chrono::steady_clock::time_point BasicLocalisationMultiIMUPlugin<Stages>::startLatency_()
+{
+  if constexpr (Stages::LATENCY_HISTOGRAMS) {
+    return std::chrono::steady_clock::now();
+  } else {
+    return std::chrono::steady_clock::time_point();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+std::chrono::steady_clock::time_point BasicLocalisationMultiIMUPlugin<Stages>::recordLatency_(
+  const LatencyStage::Stage & stage,
+  const size_t & imuIndex,
+  const std::chrono::steady_clock::time_point & start)
+{
+  if constexpr (Stages::LATENCY_HISTOGRAMS) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    latencyHistograms_[latencyIndex_(stage, imuIndex)].record(
+      std::chrono::duration_cast<Duration>(now - start));
+    return now;
+  } else {
+    return start;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+size_t BasicLocalisationMultiIMUPlugin<Stages>::latencyIndex_(
+  const LatencyStage::Stage & stage,
+  const size_t & imuIndex)const
+{
+  if (stage < LatencyStage::NUMBER_OF_IMU_STAGES) {
+    return imuIndex * LatencyStage::NUMBER_OF_IMU_STAGES + stage;
+  }
+  return imus_.size() * LatencyStage::NUMBER_OF_IMU_STAGES + stage -
+         LatencyStage::NUMBER_OF_IMU_STAGES;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::checkSampleRate_(
+  const DiagnosticStatusTransition::Checkup & checkup,
+  const size_t & imuIndex,
+  const Duration & stamp,
+  CheckupSampleRate & rateDiagnostic,
+  const std::atomic<DiagnosticStatus> & rateStatus)
+{
+  if (diagnosticAggregator_) {
+    diagnosticAggregator_->push(checkup, static_cast<uint32_t>(imuIndex), stamp);
+    return rateStatus.load(std::memory_order_relaxed) == DiagnosticStatus::OK;
+  }
+  return evaluateSampleRate_(checkup, imuIndex, stamp, rateDiagnostic) == DiagnosticStatus::OK;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+DiagnosticStatus BasicLocalisationMultiIMUPlugin<Stages>::evaluateSampleRate_(
+  const DiagnosticStatusTransition::Checkup & checkup,
+  const size_t & imuIndex,
+  const Duration & stamp,
+  CheckupSampleRate & rateDiagnostic)
+{
+  DiagnosticStatus status = rateDiagnostic.evaluate(stamp);
+  diagnosticStatuses_.update(checkup, imuIndex, status, stamp);
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::computeAngularSpeed(
+  const size_t & imuIndex,
+  const Duration & stamp,
+  const double & accelerationAlongXAxis,
+  const double & accelerationAlongYAxis,
+  const double & accelerationAlongZAxis,
+  const double & angularSpeedAroundXAxis,
+  const double & angularSpeedAroundYAxis,
+  const double & angularSpeedAroundZAxis,
+  ObservationAngularSpeed & angularSpeed)
+{
+  InertialMeasurementsBatch measurements;
+  measurements.size = 1;
+  measurements.stamps = &stamp;
+  measurements.accelerationsAlongXAxis = &accelerationAlongXAxis;
+  measurements.accelerationsAlongYAxis = &accelerationAlongYAxis;
+  measurements.accelerationsAlongZAxis = &accelerationAlongZAxis;
+  measurements.angularSpeedsAroundXAxis = &angularSpeedAroundXAxis;
+  measurements.angularSpeedsAroundYAxis = &angularSpeedAroundYAxis;
+  measurements.angularSpeedsAroundZAxis = &angularSpeedAroundZAxis;
+
+  bool validity;
+  computeAngularSpeeds(imuIndex, measurements, &angularSpeed, &validity);
+  return validity;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+size_t BasicLocalisationMultiIMUPlugin<Stages>::computeAngularSpeeds(
+  const size_t & imuIndex,
+  const InertialMeasurementsBatch & measurements,
+  ObservationAngularSpeed * angularSpeeds,
+  bool * validities,
+  ObservationAttitude * attitudes,
+  bool * attitudeValidities)
+{
+  size_t numberOfObservations = 0;
+  for (size_t begin = 0; begin < measurements.size; begin += BATCH_CHUNK_SIZE) {
+    size_t end = std::min(begin + BATCH_CHUNK_SIZE, measurements.size);
+    numberOfObservations += computeAngularSpeeds_(
+      imuIndex, measurements, begin, end, angularSpeeds, validities, attitudes,
+      attitudeValidities);
+  }
+  return numberOfObservations;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+size_t BasicLocalisationMultiIMUPlugin<Stages>::computeAngularSpeeds_(
+  const size_t & imuIndex,
+  const InertialMeasurementsBatch & measurements,
+  const size_t & begin,
+  const size_t & end,
+  ObservationAngularSpeed * angularSpeeds,
+  bool * validities,
+  ObservationAttitude * attitudes,
+  bool * attitudeValidities)
+{
+  const IMUAHRS & imu = *imus_[imuIndex];
+  const uint32_t source = static_cast<uint32_t>(imuIndex);
+
+  std::array<size_t, BATCH_CHUNK_SIZE> indexes;
+  std::array<AccelerationsFrame, BATCH_CHUNK_SIZE> accelerations;
+  std::array<AngularSpeedsFrame, BATCH_CHUNK_SIZE> imuAngularSpeeds;
+  std::array<DiagnosticStatus, BATCH_CHUNK_SIZE> statuses;
+  std::array<double, BATCH_CHUNK_SIZE> linearSpeeds;
+  std::array<std::optional<double>, BATCH_CHUNK_SIZE> angularSpeedBiases;
+  std::array<double, BATCH_CHUNK_SIZE> angularSpeedBiasVariances;
+  std::array<AngularSpeedsFrame, BATCH_CHUNK_SIZE> angularSpeedBiasFrames;
+
+  if (hasDebugLog_()) {
+    for (size_t n = begin; n < end; ++n) {
+      debugLog_->log(
+        DebugLogRecord::INERTIAL_MEASUREMENTS,
+        source,
+        measurements.stamps[n],
+        measurements.accelerationsAlongXAxis[n],
+        measurements.accelerationsAlongYAxis[n],
+        measurements.accelerationsAlongZAxis[n],
+        measurements.angularSpeedsAroundXAxis[n],
+        measurements.angularSpeedsAroundYAxis[n],
+        measurements.angularSpeedsAroundZAxis[n]);
+    }
+  }
+
+  // keep only samples received at the expected rate
+  std::chrono::steady_clock::time_point time = startLatency_();
+  size_t size = 0;
+  for (size_t n = begin; n < end; ++n) {
+    validities[n] = false;
+    if (attitudeValidities != nullptr) {
+      attitudeValidities[n] = false;
+    }
+    if constexpr (Stages::INERTIAL_MEASUREMENT_RATE_CHECKUP) {
+      if (!checkSampleRate_(
+          DiagnosticStatusTransition::INERTIAL_MEASUREMENT_RATE,
+          imuIndex,
+          measurements.stamps[n],
+          inertialMeasurementRateDiagnostics_[imuIndex],
+          inertialMeasurementRateStatuses_[imuIndex]))
+      {
+        continue;
+      }
+    }
+    indexes[size++] = n;
+  }
+  if constexpr (Stages::INERTIAL_MEASUREMENT_RATE_CHECKUP) {
+    time = recordLatency_(LatencyStage::INERTIAL_MEASUREMENT_RATE_CHECKUP, imuIndex, time);
+  }
+
+  for (size_t k = 0; k < size; ++k) {
+    const size_t n = indexes[k];
+    accelerations[k] = imu.createAccelerationsFrame(
+      measurements.accelerationsAlongXAxis[n],
+      measurements.accelerationsAlongYAxis[n],
+      measurements.accelerationsAlongZAxis[n]);
+    imuAngularSpeeds[k] = imu.createAngularSpeedsFrame(
+      measurements.angularSpeedsAroundXAxis[n],
+      measurements.angularSpeedsAroundYAxis[n],
+      measurements.angularSpeedsAroundZAxis[n]);
+  }
+  time = recordLatency_(LatencyStage::INERTIAL_MEASUREMENT_FRAMES, imuIndex, time);
+
+  // spikes are replaced before range checkup and bias estimation see them
+  if constexpr (Stages::SPIKE_REJECTION) {
+    for (size_t k = 0; k < size; ++k) {
+      spikeFilters_[imuIndex].filter(accelerations[k], imuAngularSpeeds[k]);
+    }
+    time = recordLatency_(LatencyStage::SPIKE_REJECTION, imuIndex, time);
+  }
+
+  // keep only samples within sensor ranges
+  size_t numberOfValidSamples = size;
+  if constexpr (Stages::INERTIAL_MEASUREMENT_CHECKUP) {
+    inertialMeasurementDiagnostics_[imuIndex].evaluate(
+      accelerations.data(), imuAngularSpeeds.data(), size, statuses.data());
+
+    numberOfValidSamples = 0;
+    for (size_t k = 0; k < size; ++k) {
+      diagnosticStatuses_.update(
+        DiagnosticStatusTransition::INERTIAL_MEASUREMENTS,
+        imuIndex,
+        statuses[k],
+        measurements.stamps[indexes[k]]);
+
+      if (statuses[k] == DiagnosticStatus::OK) {
+        indexes[numberOfValidSamples] = indexes[k];
+        accelerations[numberOfValidSamples] = accelerations[k];
+        imuAngularSpeeds[numberOfValidSamples] = imuAngularSpeeds[k];
+        ++numberOfValidSamples;
+      }
+    }
+    time = recordLatency_(LatencyStage::INERTIAL_MEASUREMENT_CHECKUP, imuIndex, time);
+  }
+
+  if constexpr (Stages::ANGULAR_SPEED_BIAS_ESTIMATION) {
+    // linear speed seen by odometry at each inertial measurement stamp
+    for (size_t k = 0; k < numberOfValidSamples; ++k) {
+      linearSpeeds[k] = linearSpeeds_.interpolate(measurements.stamps[indexes[k]]);
+    }
+
+    imuAngularSpeedBiases_[imuIndex].evaluate(
+      linearSpeeds.data(),
+      accelerations.data(),
+      imuAngularSpeeds.data(),
+      numberOfValidSamples,
+      angularSpeedBiases.data(),
+      angularSpeedBiasVariances.data(),
+      angularSpeedBiasFrames.data());
+    recordLatency_(LatencyStage::ANGULAR_SPEED_BIAS_ESTIMATION, imuIndex, time);
+
+    if (hasDebugLog_()) {
+      for (size_t k = 0; k < numberOfValidSamples; ++k) {
+        debugLog_->log(
+          DebugLogRecord::ANGULAR_SPEED_BIAS,
+          source,
+          measurements.stamps[indexes[k]],
+          linearSpeeds[k],
+          angularSpeedBiases[k].value_or(std::numeric_limits<double>::quiet_NaN()));
+      }
+    }
+  }
+
+  if constexpr (Stages::ATTITUDE_PROPAGATION) {
+    // each sample is corrected by the biases in effect when it was evaluated
+    time = startLatency_();
+    AttitudePropagator & attitudePropagator = attitudePropagators_[imuIndex];
+
+    for (size_t k = 0; k < numberOfValidSamples; ++k) {
+      AngularSpeedsFrame biases = {0., 0., 0.};
+      double angularSpeedBiasVariance = 0.;
+      if constexpr (Stages::ANGULAR_SPEED_BIAS_ESTIMATION) {
+        if (!angularSpeedBiases[k].has_value()) {
+          attitudePropagator.interrupt();
+          continue;
+        }
+        biases = angularSpeedBiasFrames[k];
+        angularSpeedBiasVariance = angularSpeedBiasVariances[k];
+      }
+
+      const AngularSpeedsFrame angularSpeedsFrame = {
+        imuAngularSpeeds[k].angularSpeedAroundXAxis - biases.angularSpeedAroundXAxis,
+        imuAngularSpeeds[k].angularSpeedAroundYAxis - biases.angularSpeedAroundYAxis,
+        imuAngularSpeeds[k].angularSpeedAroundZAxis - biases.angularSpeedAroundZAxis};
+      if (!attitudePropagator.propagate(
+          measurements.stamps[indexes[k]], angularSpeedsFrame, angularSpeedBiasVariance))
+      {
+        continue;
+      }
+
+      // attitudes and their validities are optional outputs, each one may be given alone
+      if (attitudes != nullptr) {
+        ObservationAttitude & attitude = attitudes[indexes[k]];
+        attitude.Y(ObservationAttitude::ROLL) = attitudePropagator.getRollAngle();
+        attitude.Y(ObservationAttitude::PITCH) = attitudePropagator.getPitchAngle();
+        attitude.R() = Eigen::Matrix2d::Identity() * attitudePropagator.getAngleVariance();
+      }
+      if (attitudeValidities != nullptr) {
+        attitudeValidities[indexes[k]] = true;
+      }
+    }
+    recordLatency_(LatencyStage::ATTITUDE_PROPAGATION, imuIndex, time);
+  }
+
+  if constexpr (Stages::ANGULAR_SPEED_INTEGRATION) {
+    // same per sample biases as attitude propagation, samples without bias are left out as gaps
+    time = startLatency_();
+    AngularSpeedIntegrator & angularSpeedIntegrator = angularSpeedIntegrators_[imuIndex];
+
+    for (size_t k = 0; k < numberOfValidSamples; ++k) {
+      AngularSpeedsFrame biases = {0., 0., 0.};
+      double angularSpeedBiasVariance = 0.;
+      if constexpr (Stages::ANGULAR_SPEED_BIAS_ESTIMATION) {
+        if (!angularSpeedBiases[k].has_value()) {
+          continue;
+        }
+        biases = angularSpeedBiasFrames[k];
+        angularSpeedBiasVariance = angularSpeedBiasVariances[k];
+      }
+
+      angularSpeedIntegrator.integrate(
+        measurements.stamps[indexes[k]],
+        {imuAngularSpeeds[k].angularSpeedAroundXAxis - biases.angularSpeedAroundXAxis,
+          imuAngularSpeeds[k].angularSpeedAroundYAxis - biases.angularSpeedAroundYAxis,
+          imuAngularSpeeds[k].angularSpeedAroundZAxis - biases.angularSpeedAroundZAxis},
+        angularSpeedBiasVariance);
+    }
+    recordLatency_(LatencyStage::ANGULAR_SPEED_INTEGRATION, imuIndex, time);
+  }
+
+  size_t numberOfObservations = 0;
+  const double angularSpeedVariance = imu.getAngularSpeedVariance();
+  for (size_t k = 0; k < numberOfValidSamples; ++k) {
+    double angularSpeedBias = 0.;
+    double angularSpeedBiasVariance = 0.;
+    if constexpr (Stages::ANGULAR_SPEED_BIAS_ESTIMATION) {
+      // bias estimator warns until bias is available
+      diagnosticStatuses_.update(
+        DiagnosticStatusTransition::ANGULAR_SPEED_BIAS,
+        imuIndex,
+        angularSpeedBiases[k].has_value() ? DiagnosticStatus::OK : DiagnosticStatus::WARN,
+        measurements.stamps[indexes[k]]);
+
+      if (!angularSpeedBiases[k].has_value()) {
+        continue;
+      }
+      angularSpeedBias = angularSpeedBiases[k].value();
+      angularSpeedBiasVariance = angularSpeedBiasVariances[k];
+    }
+
+    ObservationAngularSpeed & angularSpeed = angularSpeeds[indexes[k]];
+    angularSpeed.Y() = imuAngularSpeeds[k].angularSpeedAroundZAxis - angularSpeedBias;
+    angularSpeed.R() = angularSpeedVariance + angularSpeedBiasVariance;
+    validities[indexes[k]] = true;
+    ++numberOfObservations;
+
+    if (hasDebugLog_()) {
+      debugLog_->log(
+        DebugLogRecord::ANGULAR_SPEED,
+        source,
+        measurements.stamps[indexes[k]],
+        angularSpeed.Y(),
+        angularSpeed.R());
+    }
+  }
+
+  if (angularSpeedDecimators_) {
+    // averages replace the observation of the last sample of each group, samples without
+    // observation are counted as rejected
+    AngularSpeedDecimator & angularSpeedDecimator = (*angularSpeedDecimators_)[imuIndex];
+    numberOfObservations = 0;
+    for (size_t n = begin; n < end; ++n) {
+      if (!validities[n]) {
+        angularSpeedDecimator.reject();
+        continue;
+      }
+
+      ObservationAngularSpeed & angularSpeed = angularSpeeds[n];
+      validities[n] = angularSpeedDecimator.add(
+        measurements.stamps[n],
+        angularSpeed.Y(),
+        angularSpeedVariance,
+        angularSpeed.R() - angularSpeedVariance);
+      if (validities[n]) {
+        angularSpeed.Y() = angularSpeedDecimator.getAngularSpeed();
+        angularSpeed.R() = angularSpeedDecimator.getAngularSpeedVariance();
+        ++numberOfObservations;
+      }
+    }
+  }
+
+  return numberOfObservations;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::computeAttitude(
+  const size_t & imuIndex,
+  const Duration & stamp,
+  const double & rollAngle,
+  const double & pitchAngle,
+  const double & courseAngle,
+  ObservationAttitude & attitude)
+{
+  const IMUAHRS & imu = *imus_[imuIndex];
+  const uint32_t source = static_cast<uint32_t>(imuIndex);
+
+  if (hasDebugLog_()) {
+    debugLog_->log(
+      DebugLogRecord::ATTITUDE_ANGLES, source, stamp, rollAngle, pitchAngle, courseAngle);
+  }
+
+  std::chrono::steady_clock::time_point time = startLatency_();
+  if constexpr (Stages::ATTITUDE_RATE_CHECKUP) {
+    bool isRateOk = checkSampleRate_(
+      DiagnosticStatusTransition::ATTITUDE_RATE,
+      imuIndex,
+      stamp,
+      attitudeRateDiagnostics_[imuIndex],
+      attitudeRateStatuses_[imuIndex]);
+    time = recordLatency_(LatencyStage::ATTITUDE_RATE_CHECKUP, imuIndex, time);
+    if (!isRateOk) {
+      return false;
+    }
+  }
+
+  if constexpr (Stages::ATTITUDE_CHECKUP) {
+    RollPitchCourseFrame frame = imu.createFrame(
+      rollAngle,
+      pitchAngle,
+      courseAngle);
+
+    DiagnosticStatus status = attitudeDiagnostics_[imuIndex].evaluate(frame);
+    diagnosticStatuses_.update(DiagnosticStatusTransition::ATTITUDE, imuIndex, status, stamp);
+    recordLatency_(LatencyStage::ATTITUDE_CHECKUP, imuIndex, time);
+    if (status != DiagnosticStatus::OK) {
+      return false;
+    }
+  }
+
+  attitude.Y(ObservationAttitude::ROLL) = rollAngle;
+  attitude.Y(ObservationAttitude::PITCH) = pitchAngle;
+  attitude.R() = Eigen::Matrix2d::Identity() * imu.getAngleVariance();
+
+  if constexpr (Stages::ATTITUDE_PROPAGATION) {
+    attitudePropagators_[imuIndex].setAttitude(stamp, rollAngle, pitchAngle);
+  }
+
+  if (hasDebugLog_()) {
+    debugLog_->log(
+      DebugLogRecord::ATTITUDE,
+      source,
+      stamp,
+      rollAngle,
+      pitchAngle,
+      imu.getAngleVariance());
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::getPropagatedAttitude(
+  const size_t & imuIndex,
+  ObservationAttitude & attitude)const
+{
+  if constexpr (Stages::ATTITUDE_PROPAGATION) {
+    const AttitudePropagator & attitudePropagator = attitudePropagators_[imuIndex];
+    if (!attitudePropagator.isAvailable()) {
+      return false;
+    }
+
+    attitude.Y(ObservationAttitude::ROLL) = attitudePropagator.getRollAngle();
+    attitude.Y(ObservationAttitude::PITCH) = attitudePropagator.getPitchAngle();
+    attitude.R() = Eigen::Matrix2d::Identity() * attitudePropagator.getAngleVariance();
+    return true;
+  } else {
+    return false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::popDeltaAngles(
+  const size_t & imuIndex,
+  DeltaAngles & deltaAngles)
+{
+  if constexpr (Stages::ANGULAR_SPEED_INTEGRATION) {
+    return angularSpeedIntegrators_[imuIndex].pop(deltaAngles);
+  } else {
+    return false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::popDeltaAngles(
+  const size_t & imuIndex,
+  const Duration & stamp,
+  DeltaAngles & deltaAngles)
+{
+  if constexpr (Stages::ANGULAR_SPEED_INTEGRATION) {
+    return angularSpeedIntegrators_[imuIndex].pop(stamp, deltaAngles);
+  } else {
+    return false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+DiagnosticReport BasicLocalisationMultiIMUPlugin<Stages>::makeDiagnosticReport(
+  const Duration & stamp)
+{
+  if (diagnosticAggregator_) {
+    diagnosticAggregator_->push(HEART_BEAT_EVENT, 0, stamp);
+    return diagnosticAggregator_->getReport();
+  }
+
+  std::lock_guard<std::mutex> lock(diagnosticReportMutex_);
+  checkHeartBeats_(stamp);
+  return makeDiagnosticReport_();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+uint64_t BasicLocalisationMultiIMUPlugin<Stages>::getDiagnosticStatusGeneration()const
+{
+  return diagnosticStatuses_.getGeneration();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::popDiagnosticStatusTransition(
+  DiagnosticStatusTransition & transition)
+{
+  return diagnosticStatuses_.popTransition(transition);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+DiagnosticStatus BasicLocalisationMultiIMUPlugin<Stages>::getDiagnosticStatus(
+  const DiagnosticStatusTransition::Checkup & checkup,
+  const size_t & imuIndex)const
+{
+  return diagnosticStatuses_.getStatus(checkup, imuIndex);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+const LatencyHistogram & BasicLocalisationMultiIMUPlugin<Stages>::getLatencyHistogram(
+  const LatencyStage::Stage & stage,
+  const size_t & imuIndex)const
+{
+  if constexpr (Stages::LATENCY_HISTOGRAMS) {
+    return latencyHistograms_[latencyIndex_(stage, imuIndex)];
+  } else {
+    static const LatencyHistogram disabledHistogram;
+    return disabledHistogram;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::loadAngularSpeedBias(
+  const size_t & imuIndex,
+  const std::string & filename)
+{
+  static_assert(Stages::ANGULAR_SPEED_BIAS_ESTIMATION, "bias estimation stage is disabled");
+
+  const IMUAHRS & imu = *imus_[imuIndex];
+  auto prior = loadAngularSpeedBiasPrior(
+    filename,
+    imu.getRate(),
+    imu.getAccelerationStd(),
+    imu.getAngularSpeedStd());
+
+  if (prior.has_value()) {
+    imuAngularSpeedBiases_[imuIndex].setPrior(prior.value());
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::saveAngularSpeedBias(
+  const size_t & imuIndex,
+  const std::string & filename)const
+{
+  static_assert(Stages::ANGULAR_SPEED_BIAS_ESTIMATION, "bias estimation stage is disabled");
+
+  auto prior = imuAngularSpeedBiases_[imuIndex].makePrior();
+  if (prior.has_value()) {
+    saveAngularSpeedBiasPrior(filename, prior.value());
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationMultiIMUPlugin<Stages>::setTemperature(
+  const size_t & imuIndex,
+  const double & temperature)
+{
+  static_assert(Stages::ANGULAR_SPEED_BIAS_ESTIMATION, "bias estimation stage is disabled");
+  imuAngularSpeedBiases_[imuIndex].setTemperature(temperature);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+bool BasicLocalisationMultiIMUPlugin<Stages>::loadAngularSpeedBiasTable(
+  const size_t & imuIndex,
+  const std::string & filename)
+{
+  static_assert(Stages::ANGULAR_SPEED_BIAS_ESTIMATION, "bias estimation stage is disabled");
+
+  const IMUAHRS & imu = *imus_[imuIndex];
+  return romea::core::loadAngularSpeedBiasTable(
+    filename,
+    imu.getRate(),
+    imu.getAccelerationStd(),
+    imu.getAngularSpeedStd(),
+    imuAngularSpeedBiases_[imuIndex].getTemperatureTable());
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationMultiIMUPlugin<Stages>::saveAngularSpeedBiasTable(
+  const size_t & imuIndex,
+  const std::string & filename)const
+{
+  static_assert(Stages::ANGULAR_SPEED_BIAS_ESTIMATION, "bias estimation stage is disabled");
+
+  const IMUAHRS & imu = *imus_[imuIndex];
+  romea::core::saveAngularSpeedBiasTable(
+    filename,
+    imu.getRate(),
+    imu.getAccelerationStd(),
+    imu.getAngularSpeedStd(),
+    imuAngularSpeedBiases_[imuIndex].getTemperatureTable());
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationMultiIMUPlugin<Stages>::checkHeartBeats_(const Duration & stamp)
+{
+  // rate statuses are only read by sample threads when diagnostics are aggregated
+  std::chrono::steady_clock::time_point time = startLatency_();
+  bool hasLinearSpeeds = true;
+  if constexpr (Stages::LINEAR_SPEED_RATE_CHECKUP) {
+    hasLinearSpeeds = linearSpeedRateDiagnostic_.heartBeatCallback(stamp);
+    if (!hasLinearSpeeds) {
+      linearSpeedRateStatus_.store(DiagnosticStatus::ERROR, std::memory_order_relaxed);
+      diagnosticStatuses_.update(
+        DiagnosticStatusTransition::LINEAR_SPEED_RATE, 0, DiagnosticStatus::ERROR, stamp);
+    }
+  }
+
+  for (size_t n = 0; n < imus_.size(); ++n) {
+    if constexpr (Stages::ATTITUDE_RATE_CHECKUP) {
+      if (!attitudeRateDiagnostics_[n].heartBeatCallback(stamp)) {
+        attitudeRateStatuses_[n].store(DiagnosticStatus::ERROR, std::memory_order_relaxed);
+        diagnosticStatuses_.update(
+          DiagnosticStatusTransition::ATTITUDE_RATE, n, DiagnosticStatus::ERROR, stamp);
+        if constexpr (Stages::ATTITUDE_CHECKUP) {
+          attitudeDiagnostics_[n].reset();
+          diagnosticStatuses_.update(
+            DiagnosticStatusTransition::ATTITUDE, n, DiagnosticStatus::STALE, stamp);
+        }
+      }
+    }
+
+    if constexpr (Stages::ANGULAR_SPEED_BIAS_ESTIMATION) {
+      if (!hasLinearSpeeds) {
+        imuAngularSpeedBiases_[n].reset(false);
+        diagnosticStatuses_.update(
+          DiagnosticStatusTransition::ANGULAR_SPEED_BIAS, n, DiagnosticStatus::WARN, stamp);
+      }
+    }
+
+    if constexpr (Stages::INERTIAL_MEASUREMENT_RATE_CHECKUP) {
+      if (!inertialMeasurementRateDiagnostics_[n].heartBeatCallback(stamp)) {
+        inertialMeasurementRateStatuses_[n].store(
+          DiagnosticStatus::ERROR, std::memory_order_relaxed);
+        diagnosticStatuses_.update(
+          DiagnosticStatusTransition::INERTIAL_MEASUREMENT_RATE, n, DiagnosticStatus::ERROR, stamp);
+        if constexpr (Stages::INERTIAL_MEASUREMENT_CHECKUP) {
+          inertialMeasurementDiagnostics_[n].reset();
+          diagnosticStatuses_.update(
+            DiagnosticStatusTransition::INERTIAL_MEASUREMENTS, n, DiagnosticStatus::STALE, stamp);
+        }
+        if constexpr (Stages::SPIKE_REJECTION) {
+          spikeFilters_[n].reset();
+        }
+        if constexpr (Stages::ANGULAR_SPEED_BIAS_ESTIMATION) {
+          imuAngularSpeedBiases_[n].reset(true);
+          diagnosticStatuses_.update(
+            DiagnosticStatusTransition::ANGULAR_SPEED_BIAS, n, DiagnosticStatus::WARN, stamp);
+        }
+      }
+    }
+  }
+  recordLatency_(LatencyStage::HEART_BEATS, 0, time);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+DiagnosticReport BasicLocalisationMultiIMUPlugin<Stages>::makeDiagnosticReport_()
+{
+  // sections of disabled stages are never built and thus left out of report
+  std::chrono::steady_clock::time_point time = startLatency_();
+  if constexpr (Stages::LINEAR_SPEED_RATE_CHECKUP) {
+    diagnosticReport_.updateSection(
+      0, linearSpeedRateDiagnostic_.getReportVersion(), [this]() {
+        return linearSpeedRateDiagnostic_.getReport();
+      });
+  }
+
+  for (size_t n = 0; n < imus_.size(); ++n) {
+    const size_t section = 1 + n * NUMBER_OF_IMU_REPORT_SECTIONS;
+    if constexpr (Stages::ATTITUDE_RATE_CHECKUP) {
+      diagnosticReport_.updateSection(
+        section, attitudeRateDiagnostics_[n].getReportVersion(), [this, n]() {
+          return makeIMUReport_(n, attitudeRateDiagnostics_[n].getReport());
+        });
+    }
+    if constexpr (Stages::ATTITUDE_CHECKUP) {
+      diagnosticReport_.updateSection(
+        section + 1, attitudeDiagnostics_[n].getReportVersion(), [this, n]() {
+          return makeIMUReport_(n, attitudeDiagnostics_[n].getReport());
+        });
+    }
+    if constexpr (Stages::INERTIAL_MEASUREMENT_RATE_CHECKUP) {
+      diagnosticReport_.updateSection(
+        section + 2, inertialMeasurementRateDiagnostics_[n].getReportVersion(), [this, n]() {
+          return makeIMUReport_(n, inertialMeasurementRateDiagnostics_[n].getReport());
+        });
+    }
+    if constexpr (Stages::INERTIAL_MEASUREMENT_CHECKUP) {
+      diagnosticReport_.updateSection(
+        section + 3, inertialMeasurementDiagnostics_[n].getReportVersion(), [this, n]() {
+          return makeIMUReport_(n, inertialMeasurementDiagnostics_[n].getReport());
+        });
+    }
+    if constexpr (Stages::ANGULAR_SPEED_BIAS_ESTIMATION) {
+      diagnosticReport_.updateSection(
+        section + 4, imuAngularSpeedBiases_[n].getReportVersion(), [this, n]() {
+          return makeIMUReport_(n, imuAngularSpeedBiases_[n].getReport());
+        });
+    }
+    if constexpr (Stages::LATENCY_HISTOGRAMS) {
+      diagnosticReport_.updateSection(
+        section + 5, countLatencies_(0, LatencyStage::NUMBER_OF_IMU_STAGES, n), [this, n]() {
+          return makeIMUReport_(
+            n, makeLatencyReport_(0, LatencyStage::NUMBER_OF_IMU_STAGES, n));
+        });
+    }
+    if (angularSpeedDecimators_) {
+      const AngularSpeedDecimator & angularSpeedDecimator = (*angularSpeedDecimators_)[n];
+      diagnosticReport_.updateSection(
+        section + 6, angularSpeedDecimator.getReportVersion(), [this, n, &angularSpeedDecimator]() {
+          return makeIMUReport_(n, angularSpeedDecimator.getReport());
+        });
+    }
+    if constexpr (Stages::SPIKE_REJECTION) {
+      diagnosticReport_.updateSection(
+        section + 7, spikeFilters_[n].getReportVersion(), [this, n]() {
+          return makeIMUReport_(n, spikeFilters_[n].getReport());
+        });
+    }
+  }
+
+  // drop counters are stored in last sections so that report order is kept
+  const size_t section = 1 + NUMBER_OF_IMU_REPORT_SECTIONS * imus_.size();
+  if (hasDebugLog_()) {
+    uint64_t numberOfDroppedRecords = debugLog_->getNumberOfDroppedRecords();
+    diagnosticReport_.updateSection(section, numberOfDroppedRecords, [numberOfDroppedRecords]() {
+        DiagnosticReport report;
+        setReportInfo(report, "debug_log_dropped_records", numberOfDroppedRecords);
+        return report;
+      });
+  }
+  if (diagnosticAggregator_) {
+    uint64_t numberOfDroppedEvents = diagnosticAggregator_->getNumberOfDroppedEvents();
+    diagnosticReport_.updateSection(section + 1, numberOfDroppedEvents, [numberOfDroppedEvents]() {
+        DiagnosticReport report;
+        setReportInfo(report, "diagnostic_dropped_events", numberOfDroppedEvents);
+        return report;
+      });
+  }
+  if constexpr (Stages::LATENCY_HISTOGRAMS) {
+    const size_t firstStage = LatencyStage::NUMBER_OF_IMU_STAGES;
+    const size_t lastStage = LatencyStage::NUMBER_OF_STAGES;
+    diagnosticReport_.updateSection(
+      section + 2, countLatencies_(firstStage, lastStage, 0), [this, firstStage, lastStage]() {
+        return makeLatencyReport_(firstStage, lastStage, 0);
+      });
+  }
+
+  const DiagnosticReport & report = diagnosticReport_.getReport();
+  recordLatency_(LatencyStage::REPORT, 0, time);
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+uint64_t BasicLocalisationMultiIMUPlugin<Stages>::countLatencies_(
+  const size_t & firstStage,
+  const size_t & lastStage,
+  const size_t & imuIndex)const
+{
+  uint64_t count = 0;
+  for (size_t stage = firstStage; stage < lastStage; ++stage) {
+    count += latencyHistograms_[latencyIndex_(LatencyStage::Stage(stage), imuIndex)].getCount();
+  }
+  return count;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+DiagnosticReport BasicLocalisationMultiIMUPlugin<Stages>::makeLatencyReport_(
+  const size_t & firstStage,
+  const size_t & lastStage,
+  const size_t & imuIndex)const
+{
+  DiagnosticReport report;
+  for (size_t stage = firstStage; stage < lastStage; ++stage) {
+    const LatencyHistogram & histogram =
+      latencyHistograms_[latencyIndex_(LatencyStage::Stage(stage), imuIndex)];
+    if (histogram.getCount() == 0) {
+      continue;
+    }
+
+    const std::string name =
+      std::string("latency_") + LatencyStage::toString(LatencyStage::Stage(stage));
+    setReportInfo(report, name + "_p50_ns", histogram.getPercentile(50.).count());
+    setReportInfo(report, name + "_p99_ns", histogram.getPercentile(99.).count());
+    setReportInfo(report, name + "_max_ns", histogram.getMaximum().count());
+  }
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+void BasicLocalisationMultiIMUPlugin<Stages>::processDiagnosticEvent_(
+  const DiagnosticEvent & event)
+{
+  // events are only pushed for enabled rate checkups
+  const Duration stamp(event.stamp);
+  switch (event.type) {
+    case DiagnosticStatusTransition::LINEAR_SPEED_RATE:
+      linearSpeedRateStatus_.store(
+        evaluateSampleRate_(
+          DiagnosticStatusTransition::LINEAR_SPEED_RATE, 0, stamp, linearSpeedRateDiagnostic_),
+        std::memory_order_relaxed);
+      break;
+    case DiagnosticStatusTransition::INERTIAL_MEASUREMENT_RATE:
+      inertialMeasurementRateStatuses_[event.source].store(
+        evaluateSampleRate_(
+          DiagnosticStatusTransition::INERTIAL_MEASUREMENT_RATE,
+          event.source,
+          stamp,
+          inertialMeasurementRateDiagnostics_[event.source]),
+        std::memory_order_relaxed);
+      break;
+    case DiagnosticStatusTransition::ATTITUDE_RATE:
+      attitudeRateStatuses_[event.source].store(
+        evaluateSampleRate_(
+          DiagnosticStatusTransition::ATTITUDE_RATE,
+          event.source,
+          stamp,
+          attitudeRateDiagnostics_[event.source]),
+        std::memory_order_relaxed);
+      break;
+    case HEART_BEAT_EVENT:
+      {
+        // timeouts are evaluated at caller stamps, as without aggregation
+        std::lock_guard<std::mutex> lock(diagnosticReportMutex_);
+        checkHeartBeats_(stamp);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Stages>
+DiagnosticReport BasicLocalisationMultiIMUPlugin<Stages>::makeIMUReport_(
+  const size_t & imuIndex,
+  DiagnosticReport imuReport)const
+{
+  if (imus_.size() == 1) {
+    return imuReport;
+  }
+
+  const std::string prefix = "imu" + std::to_string(imuIndex);
+  DiagnosticReport report;
+  for (Diagnostic & diagnostic : imuReport.diagnostics) {
+    diagnostic.message = prefix + ": " + diagnostic.message;
+    report.diagnostics.push_back(std::move(diagnostic));
+  }
+  for (const auto & info : imuReport.info) {
+    report.info[prefix + "_" + info.first] = info.second;
+  }
+  return report;
+}
+
+// fully featured plugin, instantiated once in the library
+extern template class BasicLocalisationMultiIMUPlugin<LocalisationIMUPluginStages>;
+using LocalisationMultiIMUPlugin = BasicLocalisationMultiIMUPlugin<LocalisationIMUPluginStages>;
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__LOCALISATIONMULTIIMUPLUGIN_HPP_
@@ -0,0 +1,127 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__MPSCQUEUE_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__MPSCQUEUE_HPP_
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace romea
+{
+namespace core
+{
+
+// Bounded lock free queue with several producers and a single consumer.
+// Each slot carries a sequence number telling whether it is free or written, so producers
+// only contend on the tail index and never wait for the consumer: push fails when the queue
+// is full. Slots are allocated at construction, push and pop never allocate.
+template<typename T>
+class MPSCQueue
+{
+  static_assert(std::is_trivially_copyable<T>::value, "MPSCQueue value must be trivially copyable");
+
+public:
+  // capacity is rounded to a power of two
+  explicit MPSCQueue(const size_t & capacity)
+  : mask_(roundUpToPowerOfTwo_(capacity) - 1),
+    slots_(std::make_unique<Slot[]>(mask_ + 1)),
+    tail_(0),
+    head_(0)
+  {
+    // slot sequence is equal to index when slot is free and to index + 1 once written
+    for (size_t n = 0; n <= mask_; ++n) {
+      slots_[n].sequence.store(n, std::memory_order_relaxed);
+    }
+  }
+
+  MPSCQueue(const MPSCQueue &) = delete;
+  MPSCQueue & operator=(const MPSCQueue &) = delete;
+
+  size_t capacity()const
+  {
+    return mask_ + 1;
+  }
+
+  // can be called concurrently from several threads, return false when queue is full
+  bool tryPush(const T & value)
+  {
+    uint64_t index = tail_.load(std::memory_order_relaxed);
+    Slot * slot;
+    while (true) {
+      slot = &slots_[index & mask_];
+      uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+      if (sequence == index) {
+        if (tail_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (sequence < index) {
+        // queue is full, consumer is late
+        return false;
+      } else {
+        index = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value = value;
+    slot->sequence.store(index + 1, std::memory_order_release);
+    return true;
+  }
+
+  // must only be called from the consumer thread, return false when queue is empty
+  bool tryPop(T & value)
+  {
+    Slot & slot = slots_[head_ & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+
+    value = slot.value;
+    slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    return true;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<uint64_t> sequence;
+    T value;
+  };
+
+  static size_t roundUpToPowerOfTwo_(const size_t & value)
+  {
+    size_t power = 2;
+    while (power < value) {
+      power *= 2;
+    }
+    return power;
+  }
+
+private:
+  size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(64) std::atomic<uint64_t> tail_;
+  alignas(64) uint64_t head_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__MPSCQUEUE_HPP_
@@ -0,0 +1,181 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__MOVINGSTATISTICS_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__MOVINGSTATISTICS_HPP_
+
+// std
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace romea
+{
+namespace core
+{
+
+// Sliding window mean and variance of several channels packed in lanes.
+// All lanes are updated in one pass by a kernel built in the library with compiler vector
+// types, four lanes at a time: it is lowered to AVX2 when the library is built with it, to
+// NEON on aarch64 and to SSE2 otherwise, without any instruction set leaking into this header.
+// Only 4 and 8 lanes of float and double are instantiated, in the library.
+// Sums are computed around a per lane offset, keeping variances accurate for large means
+// (gravity). While the window is traversed, entering rows are also summed around the mean of
+// the previous window: these sums replace the running ones when the window wraps, which moves
+// the offset and flushes rounding errors without rescanning the window.
+// Values are stored as Scalar: float rows take half the memory of double rows and four of
+// them fit in a 128 bit register, which doubles the lanes processed per instruction.
+template<size_t Lanes, typename Scalar = double>
+class MovingStatistics
+{
+  static_assert(Lanes % 4 == 0, "number of lanes must be a multiple of 4");
+  static_assert(
+    std::is_same<Scalar, double>::value || std::is_same<Scalar, float>::value,
+    "scalar must be float or double");
+
+public:
+  struct alignas(32) Row
+  {
+    Scalar values[Lanes];
+  };
+
+public:
+  explicit MovingStatistics(const size_t & windowSize)
+  : rows_(std::max(windowSize, size_t(1))),
+    index_(0),
+    numberOfRows_(0),
+    offsets_(),
+    sums_(),
+    squaredSums_(),
+    nextOffsets_(),
+    nextSums_(),
+    nextSquaredSums_()
+  {
+  }
+
+  void update(const Row & row)
+  {
+    if (numberOfRows_ == 0) {
+      offsets_ = row;
+      nextOffsets_ = row;
+    }
+
+    if (numberOfRows_ == rows_.size()) {
+      accumulate_(row, rows_[index_]);
+    } else {
+      accumulate_(offsets_, row, sums_, squaredSums_);
+      accumulate_(nextOffsets_, row, nextSums_, nextSquaredSums_);
+      ++numberOfRows_;
+    }
+
+    rows_[index_] = row;
+    if (++index_ == rows_.size()) {
+      index_ = 0;
+      recenter_();
+    }
+  }
+
+  bool isAvailable()const
+  {
+    return numberOfRows_ == rows_.size();
+  }
+
+  size_t getNumberOfRows()const
+  {
+    return numberOfRows_;
+  }
+
+  size_t getWindowSize()const
+  {
+    return rows_.size();
+  }
+
+  Scalar getMean(const size_t & lane)const
+  {
+    return offsets_.values[lane] + sums_.values[lane] / numberOfRows_;
+  }
+
+  Scalar getVariance(const size_t & lane)const
+  {
+    Scalar mean = sums_.values[lane] / numberOfRows_;
+    return std::max(squaredSums_.values[lane] / numberOfRows_ - mean * mean, Scalar(0));
+  }
+
+  void reset()
+  {
+    index_ = 0;
+    numberOfRows_ = 0;
+    sums_ = Row();
+    squaredSums_ = Row();
+    nextSums_ = Row();
+    nextSquaredSums_ = Row();
+  }
+
+private:
+  static void accumulate_(
+    const Row & offsets,
+    const Row & entering,
+    Row & sums,
+    Row & squaredSums)
+  {
+    for (size_t n = 0; n < Lanes; ++n) {
+      Scalar centered = entering.values[n] - offsets.values[n];
+      sums.values[n] += centered;
+      squaredSums.values[n] += centered * centered;
+    }
+  }
+
+  // sliding window step of running and next sums, defined in library
+  void accumulate_(const Row & entering, const Row & leaving);
+
+  // next sums hold the whole window when it wraps, constant cost
+  void recenter_()
+  {
+    offsets_ = nextOffsets_;
+    sums_ = nextSums_;
+    squaredSums_ = nextSquaredSums_;
+
+    for (size_t n = 0; n < Lanes; ++n) {
+      nextOffsets_.values[n] = getMean(n);
+    }
+    nextSums_ = Row();
+    nextSquaredSums_ = Row();
+  }
+
+private:
+  std::vector<Row> rows_;
+  size_t index_;
+  size_t numberOfRows_;
+
+  Row offsets_;
+  Row sums_;
+  Row squaredSums_;
+
+  // sums of rows entered since window wrapped, around mean of previous window
+  Row nextOffsets_;
+  Row nextSums_;
+  Row nextSquaredSums_;
+};
+
+extern template class MovingStatistics<4, double>;
+extern template class MovingStatistics<4, float>;
+extern template class MovingStatistics<8, double>;
+extern template class MovingStatistics<8, float>;
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__MOVINGSTATISTICS_HPP_
@@ -0,0 +1,134 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__SEQLOCK_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__SEQLOCK_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace romea
+{
+namespace core
+{
+
+// Sequence lock used to publish small trivially copyable values.
+// Readers never block writers, they copy the value and retry if a write happened meanwhile.
+// Writers are serialized between themselves but never wait for readers.
+template<typename T>
+class SeqLock
+{
+  static_assert(std::is_trivially_copyable<T>::value, "SeqLock value must be trivially copyable");
+
+public:
+  SeqLock()
+  : sequence_(0),
+    words_()
+  {
+    store(T());
+  }
+
+  explicit SeqLock(const T & value)
+  : sequence_(0),
+    words_()
+  {
+    store(value);
+  }
+
+  void store(const T & value)
+  {
+    update([&value](T & current) {current = value;});
+  }
+
+  template<typename Modifier>
+  void update(Modifier && modifier)
+  {
+    uint32_t sequence = lock_();
+    T value = read_();
+    modifier(value);
+    write_(value);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  T load()const
+  {
+    T value;
+    uint32_t sequence;
+    do {
+      sequence = sequence_.load(std::memory_order_acquire);
+      while (sequence & 1) {
+        sequence = sequence_.load(std::memory_order_acquire);
+      }
+      value = read_();
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while (sequence != sequence_.load(std::memory_order_relaxed));
+    return value;
+  }
+
+  // changes each time a value is stored, odd while a store is in progress
+  uint32_t getVersion()const
+  {
+    return sequence_.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr size_t NUMBER_OF_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  uint32_t lock_()
+  {
+    uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    do {
+      while (sequence & 1) {
+        sequence = sequence_.load(std::memory_order_relaxed);
+      }
+    } while (!sequence_.compare_exchange_weak(
+        sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+    return sequence;
+  }
+
+  T read_()const
+  {
+    std::array<uint64_t, NUMBER_OF_WORDS> words;
+    for (size_t n = 0; n < NUMBER_OF_WORDS; ++n) {
+      words[n] = words_[n].load(std::memory_order_relaxed);
+    }
+    T value;
+    std::memcpy(static_cast<void *>(&value), words.data(), sizeof(T));
+    return value;
+  }
+
+  void write_(const T & value)
+  {
+    std::array<uint64_t, NUMBER_OF_WORDS> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+    for (size_t n = 0; n < NUMBER_OF_WORDS; ++n) {
+      words_[n].store(words[n], std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::atomic<uint32_t> sequence_;
+  std::array<std::atomic<uint64_t>, NUMBER_OF_WORDS> words_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__SEQLOCK_HPP_
@@ -0,0 +1,78 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__SESSIONFORMAT_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__SESSIONFORMAT_HPP_
+
+// std
+#include <cstddef>
+#include <cstdint>
+
+namespace romea
+{
+namespace core
+{
+
+// Header of column oriented session files written by SessionWriter.
+// Header is followed by columns, each column is a contiguous array of 8 bytes values
+// (nanosecond stamps or doubles) starting at an offset aligned on 64 bytes.
+// Values are stored with native endianness.
+struct SessionFormat
+{
+  enum Column : uint32_t
+  {
+    INERTIAL_MEASUREMENT_STAMPS,
+    ACCELERATIONS_ALONG_X_AXIS,
+    ACCELERATIONS_ALONG_Y_AXIS,
+    ACCELERATIONS_ALONG_Z_AXIS,
+    ANGULAR_SPEEDS_AROUND_X_AXIS,
+    ANGULAR_SPEEDS_AROUND_Y_AXIS,
+    ANGULAR_SPEEDS_AROUND_Z_AXIS,
+    ATTITUDE_STAMPS,
+    ROLL_ANGLES,
+    PITCH_ANGLES,
+    COURSE_ANGLES,
+    LINEAR_SPEED_STAMPS,
+    LINEAR_SPEEDS,
+    NUMBER_OF_COLUMNS
+  };
+
+  static constexpr char MAGIC[4] = {'R', 'I', 'S', 'F'};
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t ALIGNMENT = 64;
+
+  char magic[4];
+  uint32_t version;
+  uint64_t numberOfInertialMeasurements;
+  uint64_t numberOfAttitudes;
+  uint64_t numberOfLinearSpeeds;
+  uint64_t offsets[NUMBER_OF_COLUMNS];
+
+  uint64_t getNumberOfValues(const Column & column)const
+  {
+    if (column < ATTITUDE_STAMPS) {
+      return numberOfInertialMeasurements;
+    } else if (column < LINEAR_SPEED_STAMPS) {
+      return numberOfAttitudes;
+    } else {
+      return numberOfLinearSpeeds;
+    }
+  }
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__SESSIONFORMAT_HPP_
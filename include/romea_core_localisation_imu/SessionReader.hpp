@@ -0,0 +1,79 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__SESSIONREADER_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__SESSIONREADER_HPP_
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/AttitudesBatch.hpp"
+#include "romea_core_localisation_imu/InertialMeasurementsBatch.hpp"
+#include "romea_core_localisation_imu/LinearSpeedsBatch.hpp"
+#include "romea_core_localisation_imu/SessionFormat.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Memory mapped reader of session files written by SessionWriter.
+// Opening only maps the file and checks the header, returned batches point directly into
+// the mapping and remain valid as long as the reader is alive.
+class SessionReader
+{
+public:
+  // throw std::runtime_error if file cannot be mapped or is not a valid session
+  explicit SessionReader(const std::string & filename);
+
+  ~SessionReader();
+
+  SessionReader(const SessionReader &) = delete;
+  SessionReader & operator=(const SessionReader &) = delete;
+
+  size_t getNumberOfInertialMeasurements()const;
+  size_t getNumberOfAttitudes()const;
+  size_t getNumberOfLinearSpeeds()const;
+
+  // samples in [begin, end), end is clamped to number of samples
+  InertialMeasurementsBatch getInertialMeasurements(
+    const size_t & begin = 0,
+    const size_t & end = SIZE_MAX)const;
+
+  AttitudesBatch getAttitudes(
+    const size_t & begin = 0,
+    const size_t & end = SIZE_MAX)const;
+
+  LinearSpeedsBatch getLinearSpeeds(
+    const size_t & begin = 0,
+    const size_t & end = SIZE_MAX)const;
+
+private:
+  template<typename T>
+  const T * column_(const SessionFormat::Column & column, const size_t & begin)const;
+
+private:
+  const char * data_;
+  size_t size_;
+  SessionFormat header_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__SESSIONREADER_HPP_
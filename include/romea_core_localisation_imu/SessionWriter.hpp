@@ -0,0 +1,91 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__SESSIONWRITER_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__SESSIONWRITER_HPP_
+
+// romea
+#include <romea_core_common/time/Time.hpp>
+
+// std
+#include <array>
+#include <fstream>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/SessionFormat.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Streaming writer of column oriented session files.
+// Each column is appended to its own temporary file, columns are gathered in the session
+// file on close so memory usage does not depend on session length.
+class SessionWriter
+{
+public:
+  // throw std::runtime_error if files cannot be opened
+  explicit SessionWriter(const std::string & filename);
+
+  // session is closed if close has not been called, errors are ignored
+  ~SessionWriter();
+
+  SessionWriter(const SessionWriter &) = delete;
+  SessionWriter & operator=(const SessionWriter &) = delete;
+
+  void addInertialMeasurements(
+    const Duration & stamp,
+    const double & accelerationAlongXAxis,
+    const double & accelerationAlongYAxis,
+    const double & accelerationAlongZAxis,
+    const double & angularSpeedAroundXAxis,
+    const double & angularSpeedAroundYAxis,
+    const double & angularSpeedAroundZAxis);
+
+  void addAttitude(
+    const Duration & stamp,
+    const double & rollAngle,
+    const double & pitchAngle,
+    const double & courseAngle);
+
+  void addLinearSpeed(
+    const Duration & stamp,
+    const double & linearSpeed);
+
+  // throw std::runtime_error if session file cannot be written
+  void close();
+
+private:
+  std::string makeColumnFilename_(const size_t & column)const;
+
+  void append_(const SessionFormat::Column & column, const double & value);
+
+  void append_(const SessionFormat::Column & column, const Duration & stamp);
+
+  void removeColumnFiles_();
+
+private:
+  std::string filename_;
+  std::array<std::ofstream, SessionFormat::NUMBER_OF_COLUMNS> columns_;
+  SessionFormat header_;
+  bool isClosed_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__SESSIONWRITER_HPP_
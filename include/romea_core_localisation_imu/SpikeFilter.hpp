@@ -0,0 +1,106 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__SPIKEFILTER_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__SPIKEFILTER_HPP_
+
+// romea
+#include <romea_core_imu/AccelerationsFrame.hpp>
+#include <romea_core_imu/AngularSpeedsFrame.hpp>
+#include <romea_core_common/diagnostic/DiagnosticReport.hpp>
+
+// std
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// local
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+// Replaces single sample spikes of acceleration and angular speed channels.
+// Each sample is compared to the median of a window made of itself and the previous samples:
+// it is an outlier when its distance to the median exceeds six times the largest of the
+// scaled median absolute deviation of the window and the sensor noise std, the latter
+// avoiding false detections when the window is nearly constant. Outliers are replaced by
+// the median, raw values are kept in window so that genuine steps are followed after half a
+// window. Medians are computed with a selection network over the six channels at once, using
+// compiler vector types like MovingStatistics, and the deviation median is only computed for
+// samples further than six noise stds from the window median. Samples pass through until
+// window is full, the one filling it is checked, window is refilled after a reset.
+class SpikeFilter
+{
+public:
+  static constexpr size_t WINDOW_SIZE = 5;
+
+public:
+  SpikeFilter(
+    const double & accelerationStd,
+    const double & angularSpeedStd);
+
+  // return true when at least one channel has been replaced
+  bool filter(
+    AccelerationsFrame & accelerations,
+    AngularSpeedsFrame & angularSpeeds);
+
+  // empty window after a data gap, can be called from another thread than filter
+  void reset();
+
+  DiagnosticReport getReport()const;
+
+  // changes each time a spike is replaced, used to cache reports
+  uint32_t getReportVersion()const;
+
+private:
+  // acceleration along and angular speed around x, y and z axes, two padding lanes
+  static constexpr size_t NUMBER_OF_LANES = 8;
+
+  struct alignas(32) Row
+  {
+    double values[NUMBER_OF_LANES];
+  };
+
+  // published when a spike is replaced
+  struct ReportValues
+  {
+    uint64_t numberOfAccelerationSpikes;
+    uint64_t numberOfAngularSpeedSpikes;
+  };
+
+  void applyRequestedReset_();
+
+  static DiagnosticReport makeReport_(const ReportValues & values);
+
+private:
+  Row noiseStds_;
+  std::array<Row, WINDOW_SIZE> rows_;
+  size_t index_;
+  size_t numberOfRows_;
+  std::atomic<bool> isResetRequested_;
+
+  ReportValues counters_;
+  SeqLock<ReportValues> reportValues_;
+};
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__SPIKEFILTER_HPP_
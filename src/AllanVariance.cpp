@@ -0,0 +1,172 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// local
+#include "romea_core_localisation_imu/AllanVariance.hpp"
+
+namespace
+{
+// ratio between flicker floor of Allan deviation and bias instability
+const double BIAS_INSTABILITY_RATIO = 0.664;
+}
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+AllanVariance::AllanVariance(const double & samplingPeriod)
+: samplingPeriod_(samplingPeriod),
+  levels_()
+{
+  reset();
+}
+
+//-----------------------------------------------------------------------------
+void AllanVariance::update(const double & value)
+{
+  // level k receives a cluster every 2^k samples, like a binary counter
+  double cluster = value;
+  for (size_t k = 0; k < NUMBER_OF_LEVELS; ++k) {
+    Level & level = levels_[k];
+    auto & clusters = level.clusters;
+    clusters[0] = clusters[1];
+    clusters[1] = clusters[2];
+    clusters[2] = clusters[3];
+    clusters[3] = cluster;
+    level.numberOfClusters = std::min(level.numberOfClusters + 1, clusters.size());
+
+    if (k == 0 && level.numberOfClusters >= 2) {
+      const double difference = clusters[3] - clusters[2];
+      level.sumOfSquaredDifferences += difference * difference;
+      ++level.numberOfDifferences;
+    }
+
+    // two adjacent clusters of level k + 1, each made of two consecutive clusters of level k
+    if (k + 1 < NUMBER_OF_LEVELS && level.numberOfClusters == clusters.size()) {
+      const double difference = 0.5 * ((clusters[3] + clusters[2]) - (clusters[1] + clusters[0]));
+      levels_[k + 1].sumOfSquaredDifferences += difference * difference;
+      ++levels_[k + 1].numberOfDifferences;
+    }
+
+    if (!level.hasPendingCluster) {
+      level.pendingCluster = cluster;
+      level.hasPendingCluster = true;
+      return;
+    }
+
+    level.hasPendingCluster = false;
+    cluster = 0.5 * (level.pendingCluster + cluster);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void AllanVariance::interrupt()
+{
+  for (Level & level : levels_) {
+    level.numberOfClusters = 0;
+    level.hasPendingCluster = false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void AllanVariance::reset()
+{
+  for (Level & level : levels_) {
+    level.clusters.fill(0.);
+    level.numberOfClusters = 0;
+    level.pendingCluster = 0.;
+    level.hasPendingCluster = false;
+    level.sumOfSquaredDifferences = 0.;
+    level.numberOfDifferences = 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+double AllanVariance::getSamplingPeriod()const
+{
+  return samplingPeriod_;
+}
+
+//-----------------------------------------------------------------------------
+double AllanVariance::getClusterDuration(const size_t & level)const
+{
+  return samplingPeriod_ * static_cast<double>(size_t(1) << level);
+}
+
+//-----------------------------------------------------------------------------
+size_t AllanVariance::getNumberOfDifferences(const size_t & level)const
+{
+  return levels_[level].numberOfDifferences;
+}
+
+//-----------------------------------------------------------------------------
+double AllanVariance::getVariance(const size_t & level)const
+{
+  if (levels_[level].numberOfDifferences == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return 0.5 * levels_[level].sumOfSquaredDifferences / levels_[level].numberOfDifferences;
+}
+
+//-----------------------------------------------------------------------------
+double AllanVariance::getDeviation(const size_t & level)const
+{
+  return std::sqrt(getVariance(level));
+}
+
+//-----------------------------------------------------------------------------
+bool AllanVariance::isReliable_(const size_t & level)const
+{
+  return levels_[level].numberOfDifferences >= MINIMAL_NUMBER_OF_DIFFERENCES;
+}
+
+//-----------------------------------------------------------------------------
+std::optional<double> AllanVariance::getRandomWalk()const
+{
+  if (!isReliable_(0)) {
+    return std::nullopt;
+  }
+  return std::sqrt(getVariance(0) * samplingPeriod_);
+}
+
+//-----------------------------------------------------------------------------
+std::optional<double> AllanVariance::getBiasInstability()const
+{
+  // levels are filled in order, the longest reliable cluster duration is the last one
+  size_t minimalLevel = 0;
+  size_t level = 0;
+  for (; level < NUMBER_OF_LEVELS && isReliable_(level); ++level) {
+    if (getVariance(level) < getVariance(minimalLevel)) {
+      minimalLevel = level;
+    }
+  }
+
+  // deviation still decreasing, floor is below last reliable level
+  if (level == 0 || minimalLevel + 1 >= level) {
+    return std::nullopt;
+  }
+  return getDeviation(minimalLevel) / BIAS_INSTABILITY_RATIO;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -14,6 +14,9 @@
 
 
 // std
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <string>
 
 // local
@@ -21,8 +24,36 @@
 
 namespace
 {
-const double ANGULAR_SPEED_BIAS_EPSILON = 0.0001;
 const double LINEAR_SPEED_EPSILON = 0.02;
+const double ZERO_VELOCITY_WINDOW_DURATION = 2.;
+const double ANGULAR_SPEED_BIAS_WINDOW_DURATION = 5.;
+const double ZERO_VELOCITY_STD_RATIO = 3.;
+const double NOISE_ESTIMATION_STD_RATIO = 10.;
+const double NOISE_ESTIMATION_MINIMAL_DURATION = 10.;
+const double NOISE_UPDATE_PERIOD = 1.;
+const double RECURSIVE_FILTER_MINIMAL_DURATION = 0.2;
+const double ANGULAR_SPEED_BIAS_RANDOM_WALK = 1e-4;  // rad/s/sqrt(s)
+const double TEMPERATURE_TABLE_MAXIMAL_DURATION = 60.;
+
+void setNumericReportInfo(
+  romea::core::DiagnosticReport & report,
+  const std::string & name,
+  const double & value)
+{
+  if (std::isfinite(value)) {
+    romea::core::setReportInfo(report, name, value);
+  } else {
+    romea::core::setReportInfo(report, name, "");
+  }
+}
+
+std::array<romea::core::AllanVariance, 6> makeAllanVariances(const double & imuRate)
+{
+  romea::core::AllanVariance allanVariance(1. / imuRate);
+  return {allanVariance, allanVariance, allanVariance,
+    allanVariance, allanVariance, allanVariance};
+}
+
 }
 
 namespace romea
@@ -31,44 +62,101 @@ namespace core
 {
 
 //-----------------------------------------------------------------------------
-AngularSpeedBias::AngularSpeedBias(
+template<typename Scalar>
+BasicAngularSpeedBias<Scalar>::BasicAngularSpeedBias(
   const double & imuRate,
   const double & accelerationSpeedStd,
-  const double & angularSpeedStd)
-: zeroVelocity_(imuRate, accelerationSpeedStd, angularSpeedStd),
-  imuAngularSpeedBiasEstimator_(ANGULAR_SPEED_BIAS_EPSILON, 5 * imuRate),
-  mutex_(),
-  report_()
+  const double & angularSpeedStd,
+  const AngularSpeedBiasEstimation::Mode & mode)
+: imuRate_(imuRate),
+  accelerationStd_(accelerationSpeedStd),
+  angularSpeedStd_(angularSpeedStd),
+  mode_(mode),
+  zeroVelocityStatistics_(static_cast<size_t>(ZERO_VELOCITY_WINDOW_DURATION * imuRate)),
+  angularSpeedBiasStatistics_(static_cast<size_t>(ANGULAR_SPEED_BIAS_WINDOW_DURATION * imuRate)),
+  measuredAccelerationStd_(std::numeric_limits<double>::quiet_NaN()),
+  measuredAngularSpeedStd_(std::numeric_limits<double>::quiet_NaN()),
+  prior_(),
+  isTemperaturePrior_(false),
+  filteredAngularSpeedBiases_({0., 0., 0.}),
+  filteredAngularSpeedBiasVariances_({std::numeric_limits<double>::infinity(),
+      std::numeric_limits<double>::infinity(),
+      std::numeric_limits<double>::infinity()}),
+  numberOfFilteredSamples_(0),
+  temperature_(std::numeric_limits<double>::quiet_NaN()),
+  temperatureTable_(
+    static_cast<uint64_t>(ANGULAR_SPEED_BIAS_WINDOW_DURATION * imuRate),
+    static_cast<uint64_t>(TEMPERATURE_TABLE_MAXIMAL_DURATION * imuRate)),
+  allanVariances_(makeAllanVariances(imuRate)),
+  isStandingStill_(false),
+  numberOfStandstillSamples_(0),
+  zeroVelocityAccelerationStd_(accelerationSpeedStd),
+  zeroVelocityAngularSpeedStd_(angularSpeedStd),
+  velocityRandomWalk_(std::numeric_limits<double>::quiet_NaN()),
+  angleRandomWalk_(std::numeric_limits<double>::quiet_NaN()),
+  angularSpeedBiasInstability_(std::numeric_limits<double>::quiet_NaN()),
+  isResetRequested_(false),
+  isZeroVelocityResetRequested_(false),
+  isPriorClearRequested_(false),
+  reportValues_({DiagnosticStatus::STALE,
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      false,
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN()})
 {
-  setReportInfo(report_, "acceleration_std", "");
-  setReportInfo(report_, "angular_speed_std", "");
-  setReportInfo(report_, "linear_speed", "");
-  setReportInfo(report_, "angular_speed_bias", "");
 }
 
 //-----------------------------------------------------------------------------
-bool AngularSpeedBias::hasNullLinearSpeed_(const double & linearSpeed)const
+template<typename Scalar>
+bool BasicAngularSpeedBias<Scalar>::hasNullLinearSpeed_(const double & linearSpeed)const
 {
   return std::isfinite(linearSpeed) && std::abs(linearSpeed) < LINEAR_SPEED_EPSILON;
 }
 
 //-----------------------------------------------------------------------------
-bool AngularSpeedBias::hasZeroVelocity_(
+template<typename Scalar>
+bool BasicAngularSpeedBias<Scalar>::hasZeroVelocity_(
   const AccelerationsFrame & accelerations,
   const AngularSpeedsFrame & angularSpeeds)
 {
-  return zeroVelocity_.update(
-    accelerations.accelerationAlongXAxis,
-    accelerations.accelerationAlongYAxis,
-    accelerations.accelerationAlongZAxis,
-    angularSpeeds.angularSpeedAroundXAxis,
-    angularSpeeds.angularSpeedAroundYAxis,
-    angularSpeeds.angularSpeedAroundZAxis);
-}
+  zeroVelocityStatistics_.update(
+    {{static_cast<Scalar>(accelerations.accelerationAlongXAxis),
+      static_cast<Scalar>(accelerations.accelerationAlongYAxis),
+      static_cast<Scalar>(accelerations.accelerationAlongZAxis),
+      static_cast<Scalar>(angularSpeeds.angularSpeedAroundXAxis),
+      static_cast<Scalar>(angularSpeeds.angularSpeedAroundYAxis),
+      static_cast<Scalar>(angularSpeeds.angularSpeedAroundZAxis),
+      0, 0}});
 
+  if (!zeroVelocityStatistics_.isAvailable()) {
+    return false;
+  }
+
+  measuredAccelerationStd_ = std::sqrt(
+    std::max({zeroVelocityStatistics_.getVariance(0),
+      zeroVelocityStatistics_.getVariance(1),
+      zeroVelocityStatistics_.getVariance(2)}));
+
+  measuredAngularSpeedStd_ = std::sqrt(
+    std::max({zeroVelocityStatistics_.getVariance(3),
+      zeroVelocityStatistics_.getVariance(4),
+      zeroVelocityStatistics_.getVariance(5)}));
+
+  return measuredAccelerationStd_ < ZERO_VELOCITY_STD_RATIO * zeroVelocityAccelerationStd_ &&
+         measuredAngularSpeedStd_ < ZERO_VELOCITY_STD_RATIO * zeroVelocityAngularSpeedStd_;
+}
 
 //-----------------------------------------------------------------------------
-void AngularSpeedBias::updateAngularSpeedBias_(
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::updateAngularSpeedBias_(
   const double & linearSpeed,
   const AccelerationsFrame & accelerations,
   const AngularSpeedsFrame & angularSpeeds)
@@ -76,73 +164,497 @@ void AngularSpeedBias::updateAngularSpeedBias_(
   bool hasNullLinearSpeed = hasNullLinearSpeed_(linearSpeed);
   bool hasZeroVelocity = hasZeroVelocity_(accelerations, angularSpeeds);
 
+  if (mode_ == AngularSpeedBiasEstimation::RECURSIVE_FILTER) {
+    // biases keep drifting while they cannot be observed
+    for (double & variance : filteredAngularSpeedBiasVariances_) {
+      variance += ANGULAR_SPEED_BIAS_RANDOM_WALK * ANGULAR_SPEED_BIAS_RANDOM_WALK / imuRate_;
+    }
+  }
+
   if (hasZeroVelocity && hasNullLinearSpeed) {
-    imuAngularSpeedBiasEstimator_.update(angularSpeeds.angularSpeedAroundZAxis);
+    if (mode_ == AngularSpeedBiasEstimation::RECURSIVE_FILTER) {
+      filterAngularSpeedBias_(angularSpeeds);
+    } else {
+      angularSpeedBiasStatistics_.update(
+        {{static_cast<Scalar>(angularSpeeds.angularSpeedAroundXAxis),
+          static_cast<Scalar>(angularSpeeds.angularSpeedAroundYAxis),
+          static_cast<Scalar>(angularSpeeds.angularSpeedAroundZAxis),
+          0}});
+    }
+    temperatureTable_.update(temperature_.load(std::memory_order_relaxed), angularSpeeds);
+  }
+
+  // noise is measured whenever odometry confirms standstill, zero velocity thresholds would
+  // otherwise only keep the samples quieter than datasheet values and could never be raised.
+  // Loose bounds on datasheet values only reject gross disturbances (engine, loading).
+  bool hasNoiseStandstill = hasNullLinearSpeed &&
+    measuredAccelerationStd_ < NOISE_ESTIMATION_STD_RATIO * accelerationStd_ &&
+    measuredAngularSpeedStd_ < NOISE_ESTIMATION_STD_RATIO * angularSpeedStd_;
+
+  if (hasNoiseStandstill) {
+    updateAllanVariances_(accelerations, angularSpeeds);
+  } else if (isStandingStill_) {
+    interruptAllanVariances_();
   }
 }
 
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::filterAngularSpeedBias_(
+  const AngularSpeedsFrame & angularSpeeds)
+{
+  // at standstill, angular speeds are direct observations of biases
+  const std::array<double, 3> observations = {angularSpeeds.angularSpeedAroundXAxis,
+    angularSpeeds.angularSpeedAroundYAxis, angularSpeeds.angularSpeedAroundZAxis};
+  const double observationVariance = zeroVelocityAngularSpeedStd_ * zeroVelocityAngularSpeedStd_;
+
+  for (size_t axis = 0; axis < 3; ++axis) {
+    double & bias = filteredAngularSpeedBiases_[axis];
+    double & variance = filteredAngularSpeedBiasVariances_[axis];
+    if (std::isinf(variance)) {
+      bias = observations[axis];
+      variance = observationVariance;
+    } else {
+      const double gain = variance / (variance + observationVariance);
+      bias += gain * (observations[axis] - bias);
+      variance -= gain * variance;
+    }
+  }
+  ++numberOfFilteredSamples_;
+}
 
 //-----------------------------------------------------------------------------
-std::optional<double> AngularSpeedBias::evaluate(
-  const double & linearSpeed,
+template<typename Scalar>
+bool BasicAngularSpeedBias<Scalar>::isAngularSpeedBiasEstimated_()const
+{
+  if (mode_ == AngularSpeedBiasEstimation::RECURSIVE_FILTER) {
+    return numberOfFilteredSamples_ >= std::max(
+      static_cast<size_t>(RECURSIVE_FILTER_MINIMAL_DURATION * imuRate_), size_t(1));
+  }
+  return angularSpeedBiasStatistics_.isAvailable();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::updateAllanVariances_(
   const AccelerationsFrame & accelerations,
   const AngularSpeedsFrame & angularSpeeds)
 {
-  updateAngularSpeedBias_(linearSpeed, accelerations, angularSpeeds);
+  allanVariances_[0].update(accelerations.accelerationAlongXAxis);
+  allanVariances_[1].update(accelerations.accelerationAlongYAxis);
+  allanVariances_[2].update(accelerations.accelerationAlongZAxis);
+  allanVariances_[3].update(angularSpeeds.angularSpeedAroundXAxis);
+  allanVariances_[4].update(angularSpeeds.angularSpeedAroundYAxis);
+  allanVariances_[5].update(angularSpeeds.angularSpeedAroundZAxis);
+  isStandingStill_ = true;
 
-  std::lock_guard<std::mutex> lock(mutex_);
-  setReportInfo(report_, "acceleration_std", zeroVelocity_.getAccelerationStd());
-  setReportInfo(report_, "angular_speed_std", zeroVelocity_.getAngularSpeedStd());
-  setReportInfo(
-    report_, "linear_speed", std::isfinite(linearSpeed) ? std::to_string(
-      linearSpeed) : "");
-
-  if (imuAngularSpeedBiasEstimator_.isAvailable()) {
-    double angularSpeedBias = imuAngularSpeedBiasEstimator_.getAverage();
-    setDiagnostic_(DiagnosticStatus::OK, "Angular speed bias is OK.");
-    setReportInfo(report_, "angular_speed_bias", angularSpeedBias);
-    return angularSpeedBias;
-  } else {
-    setDiagnostic_(DiagnosticStatus::WARN, "Angular speed bias not available.");
-    setReportInfo(report_, "angular_speed_bias", "");
+  // noise parameters evolve slowly, there is no need to extract them at each sample
+  ++numberOfStandstillSamples_;
+  size_t updatePeriod = std::max(static_cast<size_t>(NOISE_UPDATE_PERIOD * imuRate_), size_t(1));
+  if (numberOfStandstillSamples_ % updatePeriod == 0) {
+    updateNoiseParameters_();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::interruptAllanVariances_()
+{
+  for (auto & allanVariance : allanVariances_) {
+    allanVariance.interrupt();
+  }
+  isStandingStill_ = false;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::updateNoiseParameters_()
+{
+  // worst axis is kept, like measured standard deviations of zero velocity window
+  double velocityRandomWalk = 0;
+  double angleRandomWalk = 0;
+  double angularSpeedBiasInstability = std::numeric_limits<double>::quiet_NaN();
+  for (size_t axis = 0; axis < 3; ++axis) {
+    auto accelerationRandomWalk = allanVariances_[axis].getRandomWalk();
+    auto angularSpeedRandomWalk = allanVariances_[axis + 3].getRandomWalk();
+    if (!accelerationRandomWalk.has_value() || !angularSpeedRandomWalk.has_value()) {
+      return;
+    }
+    velocityRandomWalk = std::max(velocityRandomWalk, *accelerationRandomWalk);
+    angleRandomWalk = std::max(angleRandomWalk, *angularSpeedRandomWalk);
+
+    auto biasInstability = allanVariances_[axis + 3].getBiasInstability();
+    if (biasInstability.has_value()) {
+      angularSpeedBiasInstability = std::fmax(angularSpeedBiasInstability, *biasInstability);
+    }
+  }
+
+  velocityRandomWalk_ = velocityRandomWalk;
+  angleRandomWalk_ = angleRandomWalk;
+  angularSpeedBiasInstability_ = angularSpeedBiasInstability;
+
+  // standard deviation of a sample is white noise density divided by square root of period
+  if (numberOfStandstillSamples_ >= NOISE_ESTIMATION_MINIMAL_DURATION * imuRate_) {
+    zeroVelocityAccelerationStd_ = velocityRandomWalk * std::sqrt(imuRate_);
+    zeroVelocityAngularSpeedStd_ = angleRandomWalk * std::sqrt(imuRate_);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::resetNoiseParameters_()
+{
+  for (auto & allanVariance : allanVariances_) {
+    allanVariance.reset();
+  }
+  isStandingStill_ = false;
+  numberOfStandstillSamples_ = 0;
+  zeroVelocityAccelerationStd_ = accelerationStd_;
+  zeroVelocityAngularSpeedStd_ = angularSpeedStd_;
+  velocityRandomWalk_ = std::numeric_limits<double>::quiet_NaN();
+  angleRandomWalk_ = std::numeric_limits<double>::quiet_NaN();
+  angularSpeedBiasInstability_ = std::numeric_limits<double>::quiet_NaN();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+std::optional<AngularSpeedsFrame> BasicAngularSpeedBias<Scalar>::computeAngularSpeedBiases_()const
+{
+  if (mode_ == AngularSpeedBiasEstimation::RECURSIVE_FILTER) {
+    // prior initializes filter state, its variance stands for its number of samples
+    if (!isAngularSpeedBiasEstimated_() && !prior_.has_value()) {
+      return std::nullopt;
+    }
+    return AngularSpeedsFrame{filteredAngularSpeedBiases_[0],
+      filteredAngularSpeedBiases_[1], filteredAngularSpeedBiases_[2]};
+  }
+
+  const auto & statistics = angularSpeedBiasStatistics_;
+  if (!statistics.isAvailable() && !prior_.has_value()) {
     return std::nullopt;
   }
+
+  if (statistics.isAvailable() || statistics.getNumberOfRows() == 0) {
+    return statistics.isAvailable() ?
+           AngularSpeedsFrame{statistics.getMean(0), statistics.getMean(1), statistics.getMean(2)} :
+           prior_->angularSpeedBiases;
+  }
+
+  // prior stands for the samples still missing to fill the window
+  double numberOfSamples = statistics.getNumberOfRows();
+  double priorWeight = std::min(
+    static_cast<double>(prior_->numberOfSamples),
+    static_cast<double>(statistics.getWindowSize()) - numberOfSamples);
+  double totalWeight = priorWeight + numberOfSamples;
+
+  const AngularSpeedsFrame & priorBiases = prior_->angularSpeedBiases;
+  AngularSpeedsFrame angularSpeedBiases;
+  angularSpeedBiases.angularSpeedAroundXAxis = (priorWeight * priorBiases.angularSpeedAroundXAxis +
+    numberOfSamples * statistics.getMean(0)) / totalWeight;
+  angularSpeedBiases.angularSpeedAroundYAxis = (priorWeight * priorBiases.angularSpeedAroundYAxis +
+    numberOfSamples * statistics.getMean(1)) / totalWeight;
+  angularSpeedBiases.angularSpeedAroundZAxis = (priorWeight * priorBiases.angularSpeedAroundZAxis +
+    numberOfSamples * statistics.getMean(2)) / totalWeight;
+  return angularSpeedBiases;
 }
 
 //-----------------------------------------------------------------------------
-void AngularSpeedBias::reset(bool resetZeroVelocityEstimator)
+template<typename Scalar>
+std::optional<AngularSpeedsFrame> BasicAngularSpeedBias<Scalar>::getAngularSpeedBiases()const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  report_.diagnostics.clear();
+  return computeAngularSpeedBiases_();
+}
 
-  if (resetZeroVelocityEstimator) {
-    zeroVelocity_.reset();
-    setReportInfo(report_, "acceleration_std", "");
-    setReportInfo(report_, "angular_speed_std", "");
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::setPrior(const AngularSpeedBiasPrior & prior)
+{
+  prior_ = prior;
+  isTemperaturePrior_ = false;
+  initializeFilterFromPrior_();
+
+  reportValues_.update([&prior](ReportValues & values) {
+      if (!std::isfinite(values.accelerationStd)) {
+        values.accelerationStd = prior.measuredAccelerationStd;
+        values.angularSpeedStd = prior.measuredAngularSpeedStd;
+      }
+    });
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::clearPrior()
+{
+  isPriorClearRequested_.store(true);
+  reset(false);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::initializeFilterFromPrior_()
+{
+  if (mode_ == AngularSpeedBiasEstimation::RECURSIVE_FILTER && prior_.has_value()) {
+    const auto & biases = prior_->angularSpeedBiases;
+    filteredAngularSpeedBiases_ = {biases.angularSpeedAroundXAxis,
+      biases.angularSpeedAroundYAxis, biases.angularSpeedAroundZAxis};
+    filteredAngularSpeedBiasVariances_.fill(angularSpeedStd_ * angularSpeedStd_ /
+      static_cast<double>(std::max(prior_->numberOfSamples, uint64_t(1))));
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+std::optional<AngularSpeedBiasPrior> BasicAngularSpeedBias<Scalar>::makePrior()const
+{
+  ReportValues values = reportValues_.load();
+  if (values.status != DiagnosticStatus::OK || !values.isAngularSpeedBiasEstimated) {
+    return std::nullopt;
+  }
+
+  AngularSpeedBiasPrior prior;
+  prior.imuRate = imuRate_;
+  prior.accelerationStd = accelerationStd_;
+  prior.angularSpeedStd = angularSpeedStd_;
+  prior.angularSpeedBiases.angularSpeedAroundXAxis = values.angularSpeedBiasAroundXAxis;
+  prior.angularSpeedBiases.angularSpeedAroundYAxis = values.angularSpeedBiasAroundYAxis;
+  prior.angularSpeedBiases.angularSpeedAroundZAxis = values.angularSpeedBias;
+  prior.numberOfSamples = angularSpeedBiasStatistics_.getWindowSize();
+  if (mode_ == AngularSpeedBiasEstimation::RECURSIVE_FILTER) {
+    // number of samples giving the same bias variance with an average
+    prior.numberOfSamples = std::max(static_cast<uint64_t>(std::pow(
+        angularSpeedStd_ / values.angularSpeedBiasStd, 2)), uint64_t(1));
+  }
+  prior.measuredAccelerationStd = values.accelerationStd;
+  prior.measuredAngularSpeedStd = values.angularSpeedStd;
+  return prior;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::setTemperature(const double & temperature)
+{
+  temperature_.store(temperature, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+const AngularSpeedBiasTable & BasicAngularSpeedBias<Scalar>::getTemperatureTable()const
+{
+  return temperatureTable_;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+AngularSpeedBiasTable & BasicAngularSpeedBias<Scalar>::getTemperatureTable()
+{
+  return temperatureTable_;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+std::optional<double> BasicAngularSpeedBias<Scalar>::evaluate(
+  const double & linearSpeed,
+  const AccelerationsFrame & accelerations,
+  const AngularSpeedsFrame & angularSpeeds)
+{
+  std::optional<double> angularSpeedBias;
+  evaluate(&linearSpeed, &accelerations, &angularSpeeds, 1, &angularSpeedBias);
+  return angularSpeedBias;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::evaluate(
+  const double * linearSpeeds,
+  const AccelerationsFrame * accelerations,
+  const AngularSpeedsFrame * angularSpeeds,
+  const size_t & numberOfSamples,
+  std::optional<double> * angularSpeedBiases,
+  double * angularSpeedBiasVariances,
+  AngularSpeedsFrame * angularSpeedBiasFrames)
+{
+  if (numberOfSamples == 0) {
+    return;
+  }
+
+  applyRequestedReset_();
+  applyTemperaturePrior_();
+
+  std::optional<AngularSpeedsFrame> biases;
+  for (size_t n = 0; n < numberOfSamples; ++n) {
+    updateAngularSpeedBias_(linearSpeeds[n], accelerations[n], angularSpeeds[n]);
+
+    biases = computeAngularSpeedBiases_();
+    if (biases.has_value()) {
+      angularSpeedBiases[n] = biases->angularSpeedAroundZAxis;
+    } else {
+      angularSpeedBiases[n] = std::nullopt;
+    }
+
+    if (angularSpeedBiasVariances != nullptr) {
+      angularSpeedBiasVariances[n] = mode_ == AngularSpeedBiasEstimation::RECURSIVE_FILTER &&
+        biases.has_value() ? filteredAngularSpeedBiasVariances_[2] : 0.;
+    }
+
+    if (angularSpeedBiasFrames != nullptr) {
+      angularSpeedBiasFrames[n] = biases.value_or(AngularSpeedsFrame{0., 0., 0.});
+    }
+  }
+
+  ReportValues values;
+  values.accelerationStd = measuredAccelerationStd_;
+  values.angularSpeedStd = measuredAngularSpeedStd_;
+  values.linearSpeed = linearSpeeds[numberOfSamples - 1];
+
+  values.isAngularSpeedBiasEstimated = isAngularSpeedBiasEstimated_();
+  values.velocityRandomWalk = velocityRandomWalk_;
+  values.angleRandomWalk = angleRandomWalk_;
+  values.angularSpeedBiasInstability = angularSpeedBiasInstability_;
+  values.temperature = temperature_.load(std::memory_order_relaxed);
+
+  if (biases.has_value()) {
+    values.status = DiagnosticStatus::OK;
+    values.angularSpeedBias = biases->angularSpeedAroundZAxis;
+    values.angularSpeedBiasAroundXAxis = biases->angularSpeedAroundXAxis;
+    values.angularSpeedBiasAroundYAxis = biases->angularSpeedAroundYAxis;
+    values.angularSpeedBiasStd = mode_ == AngularSpeedBiasEstimation::RECURSIVE_FILTER ?
+      std::sqrt(filteredAngularSpeedBiasVariances_[2]) : std::numeric_limits<double>::quiet_NaN();
   } else {
-    setReportInfo(report_, "linear_speed", "");
+    values.status = DiagnosticStatus::WARN;
+    values.angularSpeedBias = std::numeric_limits<double>::quiet_NaN();
+    values.angularSpeedBiasAroundXAxis = std::numeric_limits<double>::quiet_NaN();
+    values.angularSpeedBiasAroundYAxis = std::numeric_limits<double>::quiet_NaN();
+    values.angularSpeedBiasStd = std::numeric_limits<double>::quiet_NaN();
+  }
+  reportValues_.store(values);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::reset(bool resetZeroVelocityEstimator)
+{
+  // estimators are owned by the sample thread, they are reset at next evaluation
+  if (resetZeroVelocityEstimator) {
+    isZeroVelocityResetRequested_.store(true);
+  }
+  isResetRequested_.store(true);
+
+  reportValues_.update([resetZeroVelocityEstimator](ReportValues & values) {
+      if (resetZeroVelocityEstimator) {
+        values.accelerationStd = std::numeric_limits<double>::quiet_NaN();
+        values.angularSpeedStd = std::numeric_limits<double>::quiet_NaN();
+        values.velocityRandomWalk = std::numeric_limits<double>::quiet_NaN();
+        values.angleRandomWalk = std::numeric_limits<double>::quiet_NaN();
+        values.angularSpeedBiasInstability = std::numeric_limits<double>::quiet_NaN();
+      } else {
+        values.linearSpeed = std::numeric_limits<double>::quiet_NaN();
+      }
+      values.angularSpeedBias = std::numeric_limits<double>::quiet_NaN();
+      values.angularSpeedBiasAroundXAxis = std::numeric_limits<double>::quiet_NaN();
+      values.angularSpeedBiasAroundYAxis = std::numeric_limits<double>::quiet_NaN();
+      values.angularSpeedBiasStd = std::numeric_limits<double>::quiet_NaN();
+      values.isAngularSpeedBiasEstimated = false;
+      values.status = DiagnosticStatus::WARN;
+    });
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::applyRequestedReset_()
+{
+  if (isResetRequested_.exchange(false)) {
+    // a loaded prior comes from another session, it only becomes irrelevant when inertial
+    // measurements are lost (the sensor may have been replaced) or when explicitly cleared,
+    // whereas a temperature prior is looked up again at current temperature
+    bool isPriorDropped = isPriorClearRequested_.exchange(false) || isTemperaturePrior_;
+    if (isZeroVelocityResetRequested_.exchange(false)) {
+      zeroVelocityStatistics_.reset();
+      measuredAccelerationStd_ = std::numeric_limits<double>::quiet_NaN();
+      measuredAngularSpeedStd_ = std::numeric_limits<double>::quiet_NaN();
+      resetNoiseParameters_();
+      isPriorDropped = true;
+    }
+    angularSpeedBiasStatistics_.reset();
+    filteredAngularSpeedBiases_.fill(0.);
+    filteredAngularSpeedBiasVariances_.fill(std::numeric_limits<double>::infinity());
+    numberOfFilteredSamples_ = 0;
+    if (isPriorDropped) {
+      prior_.reset();
+    }
+    initializeFilterFromPrior_();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+void BasicAngularSpeedBias<Scalar>::applyTemperaturePrior_()
+{
+  // recursive filter already started from its own observations does not need it either
+  if (prior_.has_value() || isAngularSpeedBiasEstimated_() || numberOfFilteredSamples_ != 0) {
+    return;
+  }
+
+  auto bin = temperatureTable_.lookup(temperature_.load(std::memory_order_relaxed));
+  if (!bin.has_value()) {
+    return;
   }
 
-  imuAngularSpeedBiasEstimator_.reset();
-  setReportInfo(report_, "angular_speed_bias", "");
-  setDiagnostic_(DiagnosticStatus::WARN, "Angular speed bias not available.");
+  AngularSpeedBiasPrior prior;
+  prior.imuRate = imuRate_;
+  prior.accelerationStd = accelerationStd_;
+  prior.angularSpeedStd = angularSpeedStd_;
+  prior.angularSpeedBiases = bin->angularSpeedBiases;
+  prior.numberOfSamples = bin->numberOfSamples;
+  prior.measuredAccelerationStd = std::numeric_limits<double>::quiet_NaN();
+  prior.measuredAngularSpeedStd = std::numeric_limits<double>::quiet_NaN();
+  setPrior(prior);
+  isTemperaturePrior_ = true;
 }
 
 //-----------------------------------------------------------------------------
-void AngularSpeedBias::setDiagnostic_(
-  const DiagnosticStatus & status,
-  const std::string & message)
+template<typename Scalar>
+DiagnosticReport BasicAngularSpeedBias<Scalar>::makeReport_(const ReportValues & values)
 {
-  report_.diagnostics.clear();
-  report_.diagnostics.push_back({status, message});
+  DiagnosticReport report;
+  if (values.status == DiagnosticStatus::OK) {
+    report.diagnostics.push_back({DiagnosticStatus::OK, "Angular speed bias is OK."});
+  } else if (values.status == DiagnosticStatus::WARN) {
+    report.diagnostics.push_back({DiagnosticStatus::WARN, "Angular speed bias not available."});
+  }
+
+  setNumericReportInfo(report, "acceleration_std", values.accelerationStd);
+  setNumericReportInfo(report, "angular_speed_std", values.angularSpeedStd);
+  setReportInfo(
+    report, "linear_speed", std::isfinite(values.linearSpeed) ? std::to_string(
+      values.linearSpeed) : "");
+  setNumericReportInfo(report, "angular_speed_bias", values.angularSpeedBias);
+  setNumericReportInfo(report, "angular_speed_bias_x", values.angularSpeedBiasAroundXAxis);
+  setNumericReportInfo(report, "angular_speed_bias_y", values.angularSpeedBiasAroundYAxis);
+  setNumericReportInfo(report, "angular_speed_bias_std", values.angularSpeedBiasStd);
+  setNumericReportInfo(report, "velocity_random_walk", values.velocityRandomWalk);
+  setNumericReportInfo(report, "angle_random_walk", values.angleRandomWalk);
+  setNumericReportInfo(
+    report, "angular_speed_bias_instability", values.angularSpeedBiasInstability);
+  setNumericReportInfo(report, "temperature", values.temperature);
+  return report;
 }
 
 //-----------------------------------------------------------------------------
-DiagnosticReport AngularSpeedBias::getReport()const
+template<typename Scalar>
+DiagnosticReport BasicAngularSpeedBias<Scalar>::getReport()const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return report_;
+  return makeReport_(reportValues_.load());
 }
 
+//-----------------------------------------------------------------------------
+template<typename Scalar>
+uint32_t BasicAngularSpeedBias<Scalar>::getReportVersion()const
+{
+  return reportValues_.getVersion();
+}
+
+template class BasicAngularSpeedBias<double>;
+template class BasicAngularSpeedBias<float>;
+
 }  // namespace core
 }  // namespace romea
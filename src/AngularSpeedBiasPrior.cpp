@@ -0,0 +1,107 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/AngularSpeedBiasPrior.hpp"
+#include "BinaryFile.hpp"
+
+namespace
+{
+
+// payload: 8 doubles, number of samples (uint64)
+const char MAGIC[4] = {'R', 'A', 'S', 'B'};
+const uint32_t VERSION = 1;
+const size_t FILE_SIZE =
+  romea::core::BINARY_FILE_HEADER_SIZE + 8 * 8 + 8 + romea::core::BINARY_FILE_CHECKSUM_SIZE;
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+void saveAngularSpeedBiasPrior(
+  const std::string & filename,
+  const AngularSpeedBiasPrior & prior)
+{
+  std::array<char, FILE_SIZE> buffer;
+  char * cursor = writeBinaryFileHeader(buffer.data(), MAGIC, VERSION);
+  writeBinaryValue(cursor, prior.imuRate);
+  writeBinaryValue(cursor, prior.accelerationStd);
+  writeBinaryValue(cursor, prior.angularSpeedStd);
+  writeBinaryValue(cursor, prior.angularSpeedBiases.angularSpeedAroundXAxis);
+  writeBinaryValue(cursor, prior.angularSpeedBiases.angularSpeedAroundYAxis);
+  writeBinaryValue(cursor, prior.angularSpeedBiases.angularSpeedAroundZAxis);
+  writeBinaryValue(cursor, prior.measuredAccelerationStd);
+  writeBinaryValue(cursor, prior.measuredAngularSpeedStd);
+  writeBinaryValue(cursor, prior.numberOfSamples);
+
+  if (!saveBinaryFile(filename, buffer.data(), buffer.size())) {
+    throw std::runtime_error("Unable to write angular speed bias file " + filename);
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::optional<AngularSpeedBiasPrior> loadAngularSpeedBiasPrior(
+  const std::string & filename,
+  const double & imuRate,
+  const double & accelerationStd,
+  const double & angularSpeedStd)
+{
+  std::array<char, FILE_SIZE> buffer;
+  const char * cursor = loadBinaryFile(filename, MAGIC, VERSION, buffer.data(), buffer.size());
+  if (cursor == nullptr) {
+    return std::nullopt;
+  }
+
+  AngularSpeedBiasPrior prior;
+  prior.imuRate = readBinaryValue<double>(cursor);
+  prior.accelerationStd = readBinaryValue<double>(cursor);
+  prior.angularSpeedStd = readBinaryValue<double>(cursor);
+  prior.angularSpeedBiases.angularSpeedAroundXAxis = readBinaryValue<double>(cursor);
+  prior.angularSpeedBiases.angularSpeedAroundYAxis = readBinaryValue<double>(cursor);
+  prior.angularSpeedBiases.angularSpeedAroundZAxis = readBinaryValue<double>(cursor);
+  prior.measuredAccelerationStd = readBinaryValue<double>(cursor);
+  prior.measuredAngularSpeedStd = readBinaryValue<double>(cursor);
+  prior.numberOfSamples = readBinaryValue<uint64_t>(cursor);
+
+  if (!isSameBinaryFileParameter(prior.imuRate, imuRate) ||
+    !isSameBinaryFileParameter(prior.accelerationStd, accelerationStd) ||
+    !isSameBinaryFileParameter(prior.angularSpeedStd, angularSpeedStd))
+  {
+    return std::nullopt;
+  }
+
+  if (!std::isfinite(prior.angularSpeedBiases.angularSpeedAroundXAxis) ||
+    !std::isfinite(prior.angularSpeedBiases.angularSpeedAroundYAxis) ||
+    !std::isfinite(prior.angularSpeedBiases.angularSpeedAroundZAxis) ||
+    prior.numberOfSamples == 0)
+  {
+    return std::nullopt;
+  }
+
+  return prior;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,203 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// std
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/AngularSpeedBiasTable.hpp"
+#include "BinaryFile.hpp"
+
+namespace
+{
+
+using romea::core::AngularSpeedBiasTable;
+
+// payload: 3 doubles, number of bins (uint32), bins (3 doubles, number of samples (uint64))
+const char MAGIC[4] = {'R', 'A', 'B', 'T'};
+const uint32_t VERSION = 1;
+const size_t BIN_SIZE = 3 * 8 + 8;
+const size_t FILE_SIZE = romea::core::BINARY_FILE_HEADER_SIZE + 3 * 8 + 4 +
+  AngularSpeedBiasTable::NUMBER_OF_BINS * BIN_SIZE + romea::core::BINARY_FILE_CHECKSUM_SIZE;
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+AngularSpeedBiasTable::AngularSpeedBiasTable(
+  const uint64_t & minimalNumberOfSamples,
+  const uint64_t & maximalNumberOfSamples)
+: minimalNumberOfSamples_(std::max(minimalNumberOfSamples, uint64_t(1))),
+  maximalNumberOfSamples_(std::max(maximalNumberOfSamples, minimalNumberOfSamples)),
+  bins_()
+{
+}
+
+//-----------------------------------------------------------------------------
+std::optional<size_t> AngularSpeedBiasTable::binIndex_(const double & temperature)
+{
+  // negated comparisons also reject NaN
+  const double position = temperature - MINIMAL_TEMPERATURE;
+  if (!(position >= 0.) || !(position < static_cast<double>(NUMBER_OF_BINS))) {
+    return std::nullopt;
+  }
+  return static_cast<size_t>(position);
+}
+
+//-----------------------------------------------------------------------------
+void AngularSpeedBiasTable::update(
+  const double & temperature,
+  const AngularSpeedsFrame & angularSpeeds)
+{
+  auto index = binIndex_(temperature);
+  if (!index.has_value()) {
+    return;
+  }
+
+  const uint64_t maximalNumberOfSamples = maximalNumberOfSamples_;
+  bins_[*index].update([&angularSpeeds, maximalNumberOfSamples](Bin & bin) {
+      bin.numberOfSamples = std::min(bin.numberOfSamples + 1, maximalNumberOfSamples);
+      const double weight = 1. / static_cast<double>(bin.numberOfSamples);
+      AngularSpeedsFrame & biases = bin.angularSpeedBiases;
+      biases.angularSpeedAroundXAxis +=
+        weight * (angularSpeeds.angularSpeedAroundXAxis - biases.angularSpeedAroundXAxis);
+      biases.angularSpeedAroundYAxis +=
+        weight * (angularSpeeds.angularSpeedAroundYAxis - biases.angularSpeedAroundYAxis);
+      biases.angularSpeedAroundZAxis +=
+        weight * (angularSpeeds.angularSpeedAroundZAxis - biases.angularSpeedAroundZAxis);
+    });
+}
+
+//-----------------------------------------------------------------------------
+std::optional<AngularSpeedBiasTable::Bin> AngularSpeedBiasTable::lookup(
+  const double & temperature)const
+{
+  auto index = binIndex_(temperature);
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+
+  Bin bin = bins_[*index].load();
+  if (bin.numberOfSamples < minimalNumberOfSamples_) {
+    return std::nullopt;
+  }
+  return bin;
+}
+
+//-----------------------------------------------------------------------------
+AngularSpeedBiasTable::Bin AngularSpeedBiasTable::getBin(const size_t & index)const
+{
+  return bins_[index].load();
+}
+
+//-----------------------------------------------------------------------------
+void AngularSpeedBiasTable::setBin(const size_t & index, const Bin & bin)
+{
+  Bin clampedBin = bin;
+  clampedBin.numberOfSamples = std::min(bin.numberOfSamples, maximalNumberOfSamples_);
+  bins_[index].store(clampedBin);
+}
+
+//-----------------------------------------------------------------------------
+void AngularSpeedBiasTable::reset()
+{
+  for (auto & bin : bins_) {
+    bin.store(Bin());
+  }
+}
+
+//-----------------------------------------------------------------------------
+void saveAngularSpeedBiasTable(
+  const std::string & filename,
+  const double & imuRate,
+  const double & accelerationStd,
+  const double & angularSpeedStd,
+  const AngularSpeedBiasTable & table)
+{
+  std::array<char, FILE_SIZE> buffer;
+  char * cursor = writeBinaryFileHeader(buffer.data(), MAGIC, VERSION);
+  writeBinaryValue(cursor, imuRate);
+  writeBinaryValue(cursor, accelerationStd);
+  writeBinaryValue(cursor, angularSpeedStd);
+  writeBinaryValue(cursor, static_cast<uint32_t>(AngularSpeedBiasTable::NUMBER_OF_BINS));
+  for (size_t n = 0; n < AngularSpeedBiasTable::NUMBER_OF_BINS; ++n) {
+    AngularSpeedBiasTable::Bin bin = table.getBin(n);
+    writeBinaryValue(cursor, bin.angularSpeedBiases.angularSpeedAroundXAxis);
+    writeBinaryValue(cursor, bin.angularSpeedBiases.angularSpeedAroundYAxis);
+    writeBinaryValue(cursor, bin.angularSpeedBiases.angularSpeedAroundZAxis);
+    writeBinaryValue(cursor, bin.numberOfSamples);
+  }
+
+  if (!saveBinaryFile(filename, buffer.data(), buffer.size())) {
+    throw std::runtime_error("Unable to write angular speed bias table file " + filename);
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool loadAngularSpeedBiasTable(
+  const std::string & filename,
+  const double & imuRate,
+  const double & accelerationStd,
+  const double & angularSpeedStd,
+  AngularSpeedBiasTable & table)
+{
+  std::array<char, FILE_SIZE> buffer;
+  const char * cursor = loadBinaryFile(filename, MAGIC, VERSION, buffer.data(), buffer.size());
+  if (cursor == nullptr) {
+    return false;
+  }
+
+  if (!isSameBinaryFileParameter(readBinaryValue<double>(cursor), imuRate) ||
+    !isSameBinaryFileParameter(readBinaryValue<double>(cursor), accelerationStd) ||
+    !isSameBinaryFileParameter(readBinaryValue<double>(cursor), angularSpeedStd) ||
+    readBinaryValue<uint32_t>(cursor) != AngularSpeedBiasTable::NUMBER_OF_BINS)
+  {
+    return false;
+  }
+
+  std::array<AngularSpeedBiasTable::Bin, AngularSpeedBiasTable::NUMBER_OF_BINS> bins;
+  for (auto & bin : bins) {
+    bin.angularSpeedBiases.angularSpeedAroundXAxis = readBinaryValue<double>(cursor);
+    bin.angularSpeedBiases.angularSpeedAroundYAxis = readBinaryValue<double>(cursor);
+    bin.angularSpeedBiases.angularSpeedAroundZAxis = readBinaryValue<double>(cursor);
+    bin.numberOfSamples = readBinaryValue<uint64_t>(cursor);
+  }
+
+  for (const auto & bin : bins) {
+    if (!std::isfinite(bin.angularSpeedBiases.angularSpeedAroundXAxis) ||
+      !std::isfinite(bin.angularSpeedBiases.angularSpeedAroundYAxis) ||
+      !std::isfinite(bin.angularSpeedBiases.angularSpeedAroundZAxis))
+    {
+      return false;
+    }
+  }
+
+  for (size_t n = 0; n < bins.size(); ++n) {
+    table.setBin(n, bins[n]);
+  }
+  return true;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,164 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// std
+#include <algorithm>
+#include <limits>
+
+// local
+#include "romea_core_localisation_imu/AngularSpeedDecimator.hpp"
+
+namespace
+{
+// a partial group is dropped once more consecutive samples than this are missing or rejected
+const size_t MAXIMAL_NUMBER_OF_MISSING_SAMPLES = 3;
+}
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+AngularSpeedDecimator::AngularSpeedDecimator(
+  const double & imuRate,
+  const size_t & numberOfSamples,
+  const Duration & windowDuration)
+: samplingPeriod_(1. / imuRate),
+  maximalNumberOfSamples_(std::max(numberOfSamples, size_t(1))),
+  windowDuration_(durationToSecond(windowDuration)),
+  maximalGapDuration_((MAXIMAL_NUMBER_OF_MISSING_SAMPLES + 1.5) * samplingPeriod_),
+  hasWindowStart_(false),
+  windowStart_(0),
+  lastStamp_(0),
+  numberOfConsecutiveRejectedSamples_(0),
+  numberOfSamples_(0),
+  angularSpeedSum_(0.),
+  angularSpeedNoiseVarianceSum_(0.),
+  angularSpeed_(std::numeric_limits<double>::quiet_NaN()),
+  angularSpeedVariance_(std::numeric_limits<double>::quiet_NaN()),
+  counters_({0, 0, 0}),
+  reportValues_(counters_)
+{
+}
+
+//-----------------------------------------------------------------------------
+bool AngularSpeedDecimator::add(
+  const Duration & stamp,
+  const double & angularSpeed,
+  const double & angularSpeedNoiseVariance,
+  const double & angularSpeedBiasVariance)
+{
+  // first group and groups following a gap start one sampling period before their first sample,
+  // samples received before the gap are not mixed with following ones whatever window duration
+  if (!hasWindowStart_ || durationToSecond(stamp - lastStamp_) > maximalGapDuration_) {
+    drop_();
+    windowStart_ = stamp - durationFromSecond(samplingPeriod_);
+    hasWindowStart_ = true;
+  }
+  lastStamp_ = stamp;
+  numberOfConsecutiveRejectedSamples_ = 0;
+
+  numberOfSamples_++;
+  angularSpeedSum_ += angularSpeed;
+  angularSpeedNoiseVarianceSum_ += angularSpeedNoiseVariance;
+
+  if (numberOfSamples_ < maximalNumberOfSamples_ &&
+    durationToSecond(stamp - windowStart_) < windowDuration_)
+  {
+    return false;
+  }
+
+  const double numberOfSamples = static_cast<double>(numberOfSamples_);
+  angularSpeed_ = angularSpeedSum_ / numberOfSamples;
+  angularSpeedVariance_ = angularSpeedNoiseVarianceSum_ / (numberOfSamples * numberOfSamples) +
+    angularSpeedBiasVariance;
+
+  counters_.numberOfObservations++;
+  counters_.numberOfAveragedSamples += numberOfSamples_;
+  reportValues_.store(counters_);
+
+  windowStart_ = stamp;
+  clear_();
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void AngularSpeedDecimator::reject()
+{
+  counters_.numberOfRejectedSamples++;
+  reportValues_.store(counters_);
+
+  if (++numberOfConsecutiveRejectedSamples_ > MAXIMAL_NUMBER_OF_MISSING_SAMPLES) {
+    drop_();
+    hasWindowStart_ = false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void AngularSpeedDecimator::drop_()
+{
+  if (numberOfSamples_ != 0) {
+    counters_.numberOfRejectedSamples += numberOfSamples_;
+    reportValues_.store(counters_);
+    clear_();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void AngularSpeedDecimator::clear_()
+{
+  numberOfSamples_ = 0;
+  angularSpeedSum_ = 0.;
+  angularSpeedNoiseVarianceSum_ = 0.;
+}
+
+//-----------------------------------------------------------------------------
+double AngularSpeedDecimator::getAngularSpeed()const
+{
+  return angularSpeed_;
+}
+
+//-----------------------------------------------------------------------------
+double AngularSpeedDecimator::getAngularSpeedVariance()const
+{
+  return angularSpeedVariance_;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport AngularSpeedDecimator::makeReport_(const ReportValues & values)
+{
+  DiagnosticReport report;
+  setReportInfo(report, "decimated_observations", values.numberOfObservations);
+  setReportInfo(report, "decimation_averaged_samples", values.numberOfAveragedSamples);
+  setReportInfo(report, "decimation_rejected_samples", values.numberOfRejectedSamples);
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport AngularSpeedDecimator::getReport()const
+{
+  return makeReport_(reportValues_.load());
+}
+
+//-----------------------------------------------------------------------------
+uint32_t AngularSpeedDecimator::getReportVersion()const
+{
+  return reportValues_.getVersion();
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,195 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// local
+#include "romea_core_localisation_imu/AngularSpeedIntegrator.hpp"
+
+namespace
+{
+const double MAXIMAL_STEP_RATIO = 10.;
+const double HISTORY_DURATION = 1.;
+}
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+AngularSpeedIntegrator::AngularSpeedIntegrator(
+  const double & imuRate,
+  const double & angularSpeedVariance)
+: samplingPeriod_(1. / imuRate),
+  angularSpeedVariance_(angularSpeedVariance),
+  totals_({0, 0, 0., {0., 0., 0.}, 0., 0., {0., 0., 0.}, 0.}),
+  history_(std::max(static_cast<size_t>(std::ceil(HISTORY_DURATION * imuRate)), size_t(1))),
+  numberOfPublishedSamples_(0),
+  hasPoppedTotals_(false),
+  poppedTotals_(totals_)
+{
+}
+
+//-----------------------------------------------------------------------------
+void AngularSpeedIntegrator::integrate(
+  const Duration & stamp,
+  const AngularSpeedsFrame & angularSpeeds,
+  const double & angularSpeedBiasVariance)
+{
+  double step = samplingPeriod_;
+  if (totals_.numberOfSamples != 0) {
+    if (stamp.count() <= totals_.stamp) {
+      return;
+    }
+
+    const double elapsedTime = durationToSecond(stamp - Duration(totals_.stamp));
+    if (elapsedTime <= MAXIMAL_STEP_RATIO * samplingPeriod_) {
+      step = elapsedTime;
+    }
+  }
+
+  totals_.stamp = stamp.count();
+  totals_.numberOfSamples++;
+  totals_.duration += step;
+  totals_.angles[0] += angularSpeeds.angularSpeedAroundXAxis * step;
+  totals_.angles[1] += angularSpeeds.angularSpeedAroundYAxis * step;
+  totals_.angles[2] += angularSpeeds.angularSpeedAroundZAxis * step;
+  totals_.angleNoiseVariance += angularSpeedVariance_ * step * step;
+  totals_.angularSpeedBiasVariance = angularSpeedBiasVariance;
+  totals_.angularSpeeds = {angularSpeeds.angularSpeedAroundXAxis,
+    angularSpeeds.angularSpeedAroundYAxis, angularSpeeds.angularSpeedAroundZAxis};
+  totals_.step = step;
+
+  history_[(totals_.numberOfSamples - 1) % history_.size()].store(totals_);
+  numberOfPublishedSamples_.store(totals_.numberOfSamples, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+bool AngularSpeedIntegrator::loadTotals_(
+  const uint64_t & numberOfSamples,
+  Totals & totals)const
+{
+  totals = history_[(numberOfSamples - 1) % history_.size()].load();
+  return totals.numberOfSamples == numberOfSamples;
+}
+
+//-----------------------------------------------------------------------------
+bool AngularSpeedIntegrator::pop(DeltaAngles & deltaAngles)
+{
+  const uint64_t numberOfSamples = numberOfPublishedSamples_.load(std::memory_order_acquire);
+  Totals totals;
+  if (numberOfSamples == poppedTotals_.numberOfSamples ||
+    !loadTotals_(numberOfSamples, totals))
+  {
+    return false;
+  }
+
+  pop_(totals, deltaAngles);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool AngularSpeedIntegrator::pop(const Duration & stamp, DeltaAngles & deltaAngles)
+{
+  const uint64_t numberOfSamples = numberOfPublishedSamples_.load(std::memory_order_acquire);
+  Totals totals;
+  if ((hasPoppedTotals_ && stamp.count() <= poppedTotals_.stamp) ||
+    numberOfSamples == 0 || !loadTotals_(numberOfSamples, totals) || totals.stamp < stamp.count())
+  {
+    return false;
+  }
+
+  // first sample stamped at or after stamp among those not popped yet and still kept
+  const uint64_t oldestKeptSample = numberOfSamples > history_.size() ?
+    numberOfSamples - history_.size() + 1 : 1;
+  uint64_t lower = std::max(poppedTotals_.numberOfSamples + 1, oldestKeptSample);
+  uint64_t upper = numberOfSamples;
+  while (lower < upper) {
+    const uint64_t middle = lower + (upper - lower) / 2;
+    Totals middleTotals;
+    if (!loadTotals_(middle, middleTotals)) {
+      return false;
+    }
+    if (middleTotals.stamp >= stamp.count()) {
+      upper = middle;
+      totals = middleTotals;
+    } else {
+      lower = middle + 1;
+    }
+  }
+
+  // previous sample is not kept anymore, it may be stamped after stamp as well
+  Duration cutStamp = stamp;
+  if (upper > poppedTotals_.numberOfSamples + 1 && upper == oldestKeptSample) {
+    cutStamp = std::max(stamp, Duration(totals.stamp) - durationFromSecond(totals.step));
+  }
+
+  pop_(cut_(totals, cutStamp), deltaAngles);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+AngularSpeedIntegrator::Totals AngularSpeedIntegrator::cut_(
+  const Totals & totals,
+  const Duration & stamp)const
+{
+  // part of the sample held after stamp is left to next pop, with the sample itself
+  const double remainingTime = std::min(
+    durationToSecond(Duration(totals.stamp) - stamp), totals.step);
+  if (remainingTime <= 0.) {
+    return totals;
+  }
+
+  Totals cutTotals = totals;
+  cutTotals.stamp = stamp.count();
+  cutTotals.numberOfSamples--;
+  cutTotals.duration -= remainingTime;
+  for (size_t n = 0; n < 3; ++n) {
+    cutTotals.angles[n] -= totals.angularSpeeds[n] * remainingTime;
+  }
+  cutTotals.angleNoiseVariance -= angularSpeedVariance_ * totals.step * remainingTime;
+  return cutTotals;
+}
+
+//-----------------------------------------------------------------------------
+void AngularSpeedIntegrator::pop_(const Totals & totals, DeltaAngles & deltaAngles)
+{
+  deltaAngles.duration = totals.duration - poppedTotals_.duration;
+  deltaAngles.numberOfSamples = totals.numberOfSamples - poppedTotals_.numberOfSamples;
+  deltaAngles.stopStamp = Duration(totals.stamp);
+  if (hasPoppedTotals_) {
+    deltaAngles.startStamp = Duration(poppedTotals_.stamp);
+  } else {
+    deltaAngles.startStamp = deltaAngles.stopStamp - durationFromSecond(deltaAngles.duration);
+  }
+
+  for (size_t n = 0; n < 3; ++n) {
+    deltaAngles.Y(n) = totals.angles[n] - poppedTotals_.angles[n];
+  }
+
+  const double angleVariance = totals.angleNoiseVariance - poppedTotals_.angleNoiseVariance +
+    totals.angularSpeedBiasVariance * deltaAngles.duration * deltaAngles.duration;
+  deltaAngles.R = Eigen::Matrix3d::Identity() * angleVariance;
+
+  hasPoppedTotals_ = true;
+  poppedTotals_ = totals;
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,180 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// local
+#include "romea_core_localisation_imu/AttitudePropagator.hpp"
+
+namespace
+{
+// longer gaps between angular speeds are not integrated
+const double MAXIMAL_STEP_RATIO = 10.;
+const double MAXIMAL_PROPAGATION_DURATION = 5.;
+const double MINIMAL_ROTATION_ANGLE = 1.e-9;
+}
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+AttitudePropagator::AttitudePropagator(
+  const double & imuRate,
+  const double & angleVariance,
+  const double & angularSpeedVariance)
+: samplingPeriod_(1. / imuRate),
+  angleVariance_(angleVariance),
+  angularSpeedVariance_(angularSpeedVariance),
+  attitudeFrame_({std::numeric_limits<int64_t>::min(),
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN()}),
+  orientation_(Eigen::Quaterniond::Identity()),
+  attitudeFrameStamp_(Duration::min()),
+  stamp_(Duration::min()),
+  angularSpeedNoiseVariance_(0.),
+  angularSpeedBiasVariance_(0.),
+  isPropagating_(false),
+  isAvailable_(false)
+{
+}
+
+//-----------------------------------------------------------------------------
+void AttitudePropagator::setAttitude(
+  const Duration & stamp,
+  const double & rollAngle,
+  const double & pitchAngle)
+{
+  attitudeFrame_.store({stamp.count(), rollAngle, pitchAngle});
+}
+
+//-----------------------------------------------------------------------------
+void AttitudePropagator::restart_(const AttitudeFrame & attitudeFrame)
+{
+  orientation_ = Eigen::AngleAxisd(attitudeFrame.pitchAngle, Eigen::Vector3d::UnitY()) *
+    Eigen::AngleAxisd(attitudeFrame.rollAngle, Eigen::Vector3d::UnitX());
+  attitudeFrameStamp_ = Duration(attitudeFrame.stamp);
+  stamp_ = attitudeFrameStamp_;
+  angularSpeedNoiseVariance_ = 0.;
+  angularSpeedBiasVariance_ = 0.;
+  isPropagating_ = true;
+}
+
+//-----------------------------------------------------------------------------
+bool AttitudePropagator::propagate(
+  const Duration & stamp,
+  const AngularSpeedsFrame & angularSpeeds,
+  const double & angularSpeedBiasVariance)
+{
+  // a new attitude frame is detected from its stamp
+  AttitudeFrame attitudeFrame = attitudeFrame_.load();
+  if (attitudeFrame.stamp != attitudeFrameStamp_.count()) {
+    restart_(attitudeFrame);
+  }
+
+  isAvailable_ = false;
+  if (!isPropagating_ || stamp <= stamp_) {
+    return false;
+  }
+
+  const double step = durationToSecond(stamp - stamp_);
+  if (step > MAXIMAL_STEP_RATIO * samplingPeriod_ ||
+    durationToSecond(stamp - attitudeFrameStamp_) > MAXIMAL_PROPAGATION_DURATION)
+  {
+    isPropagating_ = false;
+    return false;
+  }
+
+  // angular speed is assumed constant over the step: exact quaternion exponential, with its
+  // first order approximation for negligible rotations
+  const Eigen::Vector3d rotationVector = step * Eigen::Vector3d(
+    angularSpeeds.angularSpeedAroundXAxis,
+    angularSpeeds.angularSpeedAroundYAxis,
+    angularSpeeds.angularSpeedAroundZAxis);
+  const double rotationAngle = rotationVector.norm();
+  Eigen::Quaterniond rotation;
+  if (rotationAngle > MINIMAL_ROTATION_ANGLE) {
+    rotation.w() = std::cos(0.5 * rotationAngle);
+    rotation.vec() = std::sin(0.5 * rotationAngle) / rotationAngle * rotationVector;
+  } else {
+    rotation.w() = 1.;
+    rotation.vec() = 0.5 * rotationVector;
+  }
+
+  // normalized to avoid rounding drift
+  orientation_ = (orientation_ * rotation).normalized();
+
+  angularSpeedNoiseVariance_ += angularSpeedVariance_ * step * step;
+  angularSpeedBiasVariance_ = angularSpeedBiasVariance;
+  stamp_ = stamp;
+  isAvailable_ = true;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void AttitudePropagator::interrupt()
+{
+  isPropagating_ = false;
+  isAvailable_ = false;
+}
+
+//-----------------------------------------------------------------------------
+bool AttitudePropagator::isAvailable()const
+{
+  return isAvailable_;
+}
+
+//-----------------------------------------------------------------------------
+Duration AttitudePropagator::getStamp()const
+{
+  return stamp_;
+}
+
+//-----------------------------------------------------------------------------
+double AttitudePropagator::getRollAngle()const
+{
+  // third row of rotation matrix is gravity direction in body frame
+  const Eigen::Matrix3d rotation = orientation_.toRotationMatrix();
+  return std::atan2(rotation(2, 1), rotation(2, 2));
+}
+
+//-----------------------------------------------------------------------------
+double AttitudePropagator::getPitchAngle()const
+{
+  const Eigen::Matrix3d rotation = orientation_.toRotationMatrix();
+  return -std::asin(std::clamp(rotation(2, 0), -1., 1.));
+}
+
+//-----------------------------------------------------------------------------
+double AttitudePropagator::getAngleVariance()const
+{
+  const double duration = getPropagationDuration();
+  return angleVariance_ + angularSpeedNoiseVariance_ +
+         angularSpeedBiasVariance_ * duration * duration;
+}
+
+//-----------------------------------------------------------------------------
+double AttitudePropagator::getPropagationDuration()const
+{
+  return durationToSecond(stamp_ - attitudeFrameStamp_);
+}
+
+}  // namespace core
+}  // namespace romea
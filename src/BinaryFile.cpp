@@ -0,0 +1,126 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// local
+#include "BinaryFile.hpp"
+
+namespace
+{
+
+const double PARAMETER_RELATIVE_TOLERANCE = 1e-6;
+
+//-----------------------------------------------------------------------------
+uint32_t checksum(const char * data, const size_t & size)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t n = 0; n < size; ++n) {
+    hash ^= static_cast<unsigned char>(data[n]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+char * writeBinaryFileHeader(char * buffer, const char (&magic)[4], const uint32_t & version)
+{
+  char * cursor = buffer;
+  std::memcpy(cursor, magic, 4);
+  cursor += 4;
+  writeBinaryValue(cursor, version);
+  return cursor;
+}
+
+//-----------------------------------------------------------------------------
+bool saveBinaryFile(const std::string & filename, char * buffer, const size_t & size)
+{
+  const size_t payloadSize = size - BINARY_FILE_CHECKSUM_SIZE;
+  char * cursor = buffer + payloadSize;
+  writeBinaryValue(cursor, checksum(buffer, payloadSize));
+
+  // rename is atomic, a crash while saving leaves either previous or new file
+  const std::string temporaryFilename = filename + ".tmp";
+  {
+    std::ofstream file(temporaryFilename, std::ios::binary | std::ios::trunc);
+    file.write(buffer, static_cast<std::streamsize>(size));
+    file.flush();
+    if (!file) {
+      file.close();
+      std::remove(temporaryFilename.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(temporaryFilename.c_str(), filename.c_str()) != 0) {
+    std::remove(temporaryFilename.c_str());
+    return false;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+const char * loadBinaryFile(
+  const std::string & filename,
+  const char (&magic)[4],
+  const uint32_t & version,
+  char * buffer,
+  const size_t & size)
+{
+  std::ifstream file(filename, std::ios::binary);
+  file.read(buffer, static_cast<std::streamsize>(size));
+  if (!file || file.peek() != std::ifstream::traits_type::eof()) {
+    return nullptr;
+  }
+
+  const char * cursor = buffer;
+  if (std::memcmp(cursor, magic, 4) != 0) {
+    return nullptr;
+  }
+  cursor += 4;
+
+  if (readBinaryValue<uint32_t>(cursor) != version) {
+    return nullptr;
+  }
+
+  const size_t payloadSize = size - BINARY_FILE_CHECKSUM_SIZE;
+  const char * checksumCursor = buffer + payloadSize;
+  if (readBinaryValue<uint32_t>(checksumCursor) != checksum(buffer, payloadSize)) {
+    return nullptr;
+  }
+  return cursor;
+}
+
+//-----------------------------------------------------------------------------
+bool isSameBinaryFileParameter(const double & value, const double & expectedValue)
+{
+  return std::abs(value - expectedValue) <=
+         PARAMETER_RELATIVE_TOLERANCE * std::abs(expectedValue);
+}
+
+}  // namespace core
+}  // namespace romea
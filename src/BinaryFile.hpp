@@ -0,0 +1,76 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROMEA_CORE_LOCALISATION_IMU__BINARYFILE_HPP_
+#define ROMEA_CORE_LOCALISATION_IMU__BINARYFILE_HPP_
+
+// std
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace romea
+{
+namespace core
+{
+
+// Fixed size binary files of angular speed bias prior and table, internal to the library.
+// File layout (native little endian): magic (4 bytes), version (uint32), payload, FNV-1a
+// checksum (uint32) of everything before it.
+const size_t BINARY_FILE_HEADER_SIZE = 4 + 4;
+const size_t BINARY_FILE_CHECKSUM_SIZE = 4;
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void writeBinaryValue(char *& cursor, const T & value)
+{
+  std::memcpy(cursor, &value, sizeof(T));
+  cursor += sizeof(T);
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+T readBinaryValue(const char *& cursor)
+{
+  T value;
+  std::memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+
+// return a cursor on payload, right after magic and version
+char * writeBinaryFileHeader(char * buffer, const char (&magic)[4], const uint32_t & version);
+
+// checksum is written in the last bytes of buffer, which is first written in a temporary
+// file renamed over filename so that a previous file is never left truncated.
+// Return false if file cannot be written
+bool saveBinaryFile(const std::string & filename, char * buffer, const size_t & size);
+
+// return a cursor on payload, nullptr if file is missing, has another size, magic or
+// version, or if its checksum does not match
+const char * loadBinaryFile(
+  const std::string & filename,
+  const char (&magic)[4],
+  const uint32_t & version,
+  char * buffer,
+  const size_t & size);
+
+// sensor parameters saved along values are compared with a relative tolerance
+bool isSameBinaryFileParameter(const double & value, const double & expectedValue);
+
+}  // namespace core
+}  // namespace romea
+
+#endif  // ROMEA_CORE_LOCALISATION_IMU__BINARYFILE_HPP_
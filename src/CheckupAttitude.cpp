@@ -19,10 +19,6 @@
 // local
 #include "romea_core_localisation_imu/CheckupAttitude.hpp"
 
-namespace
-{
-}
-
 namespace romea
 {
 namespace core
@@ -30,39 +26,19 @@ namespace core
 
 //-----------------------------------------------------------------------------
 CheckupAttitude::CheckupAttitude()
-: report_()
-{
-}
-
-//-----------------------------------------------------------------------------
-void CheckupAttitude::declareReportInfos_()
+: reportValues_()
 {
-  setReportInfo(report_, "roll", "");
-  setReportInfo(report_, "pitch", "");
+  reset();
 }
 
 //-----------------------------------------------------------------------------
 DiagnosticStatus CheckupAttitude::evaluate(const RollPitchCourseFrame & frame)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  if (checkAttitudeAngles_(frame)) {
-    setDiagnostic_(DiagnosticStatus::OK, "Attitude is OK.");
-  } else {
-    setDiagnostic_(DiagnosticStatus::ERROR, "Attitude angles are out of range.");
-  }
+  DiagnosticStatus status = checkAttitudeAngles_(frame) ?
+    DiagnosticStatus::OK : DiagnosticStatus::ERROR;
 
-  setReportInfos_(frame);
-  return report_.diagnostics.front().status;
-}
-
-
-//-----------------------------------------------------------------------------
-void CheckupAttitude::setDiagnostic_(
-  const DiagnosticStatus & status,
-  const std::string & message)
-{
-  report_.diagnostics.clear();
-  report_.diagnostics.push_back({status, message});
+  reportValues_.store({status, frame.rollAngle, frame.pitchAngle});
+  return status;
 }
 
 //-----------------------------------------------------------------------------
@@ -75,25 +51,42 @@ bool CheckupAttitude::checkAttitudeAngles_(const RollPitchCourseFrame & frame)
 }
 
 //-----------------------------------------------------------------------------
-void CheckupAttitude::setReportInfos_(const RollPitchCourseFrame & frame)
+DiagnosticReport CheckupAttitude::makeReport_(const ReportValues & values)
 {
-  setReportInfo(report_, "roll", frame.rollAngle);
-  setReportInfo(report_, "pitch", frame.pitchAngle);
+  DiagnosticReport report;
+  if (values.status == DiagnosticStatus::STALE) {
+    setReportInfo(report, "roll", "");
+    setReportInfo(report, "pitch", "");
+    return report;
+  }
+
+  if (values.status == DiagnosticStatus::OK) {
+    report.diagnostics.push_back({DiagnosticStatus::OK, "Attitude is OK."});
+  } else {
+    report.diagnostics.push_back({DiagnosticStatus::ERROR, "Attitude angles are out of range."});
+  }
+
+  setReportInfo(report, "roll", values.rollAngle);
+  setReportInfo(report, "pitch", values.pitchAngle);
+  return report;
 }
 
 //-----------------------------------------------------------------------------
 void CheckupAttitude::reset()
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  report_.diagnostics.clear();
-  declareReportInfos_();
+  reportValues_.update([](ReportValues & values) {values.status = DiagnosticStatus::STALE;});
 }
 
 //-----------------------------------------------------------------------------
 DiagnosticReport CheckupAttitude::getReport()const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return report_;
+  return makeReport_(reportValues_.load());
+}
+
+//-----------------------------------------------------------------------------
+uint32_t CheckupAttitude::getReportVersion()const
+{
+  return reportValues_.getVersion();
 }
 
 }  // namespace core
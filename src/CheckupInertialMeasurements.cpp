@@ -30,20 +30,9 @@ CheckupInertialMeasurements::CheckupInertialMeasurements(
   const double & angularSpeedRange)
 : accelerationRange_(accelerationRange),
   angularSpeedRange_(angularSpeedRange),
-  report_()
+  reportValues_()
 {
-  declareReportInfos_();
-}
-
-//-----------------------------------------------------------------------------
-void CheckupInertialMeasurements::declareReportInfos_()
-{
-  setReportInfo(report_, "acceleration_x", "");
-  setReportInfo(report_, "acceleration_y", "");
-  setReportInfo(report_, "acceleration_z", "");
-  setReportInfo(report_, "angular_speed_x", "");
-  setReportInfo(report_, "angular_speed_y", "");
-  setReportInfo(report_, "angular_speed_z", "");
+  reset();
 }
 
 //-----------------------------------------------------------------------------
@@ -51,81 +40,126 @@ DiagnosticStatus CheckupInertialMeasurements::evaluate(
   const AccelerationsFrame & accelerations,
   const AngularSpeedsFrame & angularSpeeds)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  report_.diagnostics.clear();
-  checkAccelerations_(accelerations);
-  checkAngularSpeeds_(angularSpeeds);
-  setReportInfos_(accelerations);
-  setReportInfos_(angularSpeeds);
-  return worseStatus(report_.diagnostics);
+  DiagnosticStatus status;
+  evaluate(&accelerations, &angularSpeeds, 1, &status);
+  return status;
 }
 
-//--------------------------------------------------------------------
-void CheckupInertialMeasurements::checkAccelerations_(const AccelerationsFrame & accelerationFrame)
+//-----------------------------------------------------------------------------
+void CheckupInertialMeasurements::evaluate(
+  const AccelerationsFrame * accelerations,
+  const AngularSpeedsFrame * angularSpeeds,
+  const size_t & numberOfSamples,
+  DiagnosticStatus * statuses)
 {
-  if (std::abs(accelerationFrame.accelerationAlongXAxis) > accelerationRange_ ||
-    std::abs(accelerationFrame.accelerationAlongYAxis) > accelerationRange_ ||
-    std::abs(accelerationFrame.accelerationAlongZAxis) > accelerationRange_)
-  {
-    addDiagnostic_(DiagnosticStatus::ERROR, "Acceleration data is out of range.");
-  } else {
-    addDiagnostic_(DiagnosticStatus::OK, "Acceleration data is OK.");
+  if (numberOfSamples == 0) {
+    return;
   }
+
+  // report keeps the worst statuses of the batch, with the values of its first out of range
+  // sample or of its last sample when all of them are within ranges
+  ReportValues values;
+  values.accelerationStatus = DiagnosticStatus::OK;
+  values.angularSpeedStatus = DiagnosticStatus::OK;
+  size_t reportedSample = numberOfSamples - 1;
+  bool isOutOfRangeSampleFound = false;
+  for (size_t n = 0; n < numberOfSamples; ++n) {
+    const bool isAccelerationOutOfRange = isOutOfRange_(accelerations[n]);
+    const bool isAngularSpeedOutOfRange = isOutOfRange_(angularSpeeds[n]);
+    if (isAccelerationOutOfRange) {
+      values.accelerationStatus = DiagnosticStatus::ERROR;
+    }
+    if (isAngularSpeedOutOfRange) {
+      values.angularSpeedStatus = DiagnosticStatus::ERROR;
+    }
+
+    if (isAccelerationOutOfRange || isAngularSpeedOutOfRange) {
+      statuses[n] = DiagnosticStatus::ERROR;
+      if (!isOutOfRangeSampleFound) {
+        reportedSample = n;
+        isOutOfRangeSampleFound = true;
+      }
+    } else {
+      statuses[n] = DiagnosticStatus::OK;
+    }
+  }
+
+  values.accelerations = accelerations[reportedSample];
+  values.angularSpeeds = angularSpeeds[reportedSample];
+  reportValues_.store(values);
 }
 
 //--------------------------------------------------------------------
-void CheckupInertialMeasurements::checkAngularSpeeds_(const AngularSpeedsFrame & angularSpeedFrame)
+bool CheckupInertialMeasurements::isOutOfRange_(const AccelerationsFrame & accelerationFrame)const
 {
-  if (std::abs(angularSpeedFrame.angularSpeedAroundXAxis) > angularSpeedRange_ ||
-    std::abs(angularSpeedFrame.angularSpeedAroundYAxis) > angularSpeedRange_ ||
-    std::abs(angularSpeedFrame.angularSpeedAroundZAxis) > angularSpeedRange_)
-  {
-    addDiagnostic_(DiagnosticStatus::ERROR, "Angular speed data is out of range.");
-  } else {
-    addDiagnostic_(DiagnosticStatus::OK, "Angular speed data is OK.");
-  }
+  return std::abs(accelerationFrame.accelerationAlongXAxis) > accelerationRange_ ||
+         std::abs(accelerationFrame.accelerationAlongYAxis) > accelerationRange_ ||
+         std::abs(accelerationFrame.accelerationAlongZAxis) > accelerationRange_;
 }
 
-
-//-----------------------------------------------------------------------------
-DiagnosticReport CheckupInertialMeasurements::getReport() const
+//--------------------------------------------------------------------
+bool CheckupInertialMeasurements::isOutOfRange_(const AngularSpeedsFrame & angularSpeedFrame)const
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  return report_;
+  return std::abs(angularSpeedFrame.angularSpeedAroundXAxis) > angularSpeedRange_ ||
+         std::abs(angularSpeedFrame.angularSpeedAroundYAxis) > angularSpeedRange_ ||
+         std::abs(angularSpeedFrame.angularSpeedAroundZAxis) > angularSpeedRange_;
 }
 
 //-----------------------------------------------------------------------------
-void CheckupInertialMeasurements::setReportInfos_(const AccelerationsFrame & accelarations)
+DiagnosticReport CheckupInertialMeasurements::makeReport_(const ReportValues & values)
 {
-  setReportInfo(report_, "acceleration_x", accelarations.accelerationAlongXAxis);
-  setReportInfo(report_, "acceleration_y", accelarations.accelerationAlongYAxis);
-  setReportInfo(report_, "acceleration_z", accelarations.accelerationAlongZAxis);
+  DiagnosticReport report;
+  if (values.accelerationStatus == DiagnosticStatus::STALE) {
+    setReportInfo(report, "acceleration_x", "");
+    setReportInfo(report, "acceleration_y", "");
+    setReportInfo(report, "acceleration_z", "");
+    setReportInfo(report, "angular_speed_x", "");
+    setReportInfo(report, "angular_speed_y", "");
+    setReportInfo(report, "angular_speed_z", "");
+    return report;
+  }
+
+  if (values.accelerationStatus == DiagnosticStatus::OK) {
+    report.diagnostics.push_back({DiagnosticStatus::OK, "Acceleration data is OK."});
+  } else {
+    report.diagnostics.push_back({DiagnosticStatus::ERROR, "Acceleration data is out of range."});
+  }
+
+  if (values.angularSpeedStatus == DiagnosticStatus::OK) {
+    report.diagnostics.push_back({DiagnosticStatus::OK, "Angular speed data is OK."});
+  } else {
+    report.diagnostics.push_back(
+      {DiagnosticStatus::ERROR, "Angular speed data is out of range."});
+  }
+
+  setReportInfo(report, "acceleration_x", values.accelerations.accelerationAlongXAxis);
+  setReportInfo(report, "acceleration_y", values.accelerations.accelerationAlongYAxis);
+  setReportInfo(report, "acceleration_z", values.accelerations.accelerationAlongZAxis);
+  setReportInfo(report, "angular_speed_x", values.angularSpeeds.angularSpeedAroundXAxis);
+  setReportInfo(report, "angular_speed_y", values.angularSpeeds.angularSpeedAroundYAxis);
+  setReportInfo(report, "angular_speed_z", values.angularSpeeds.angularSpeedAroundZAxis);
+  return report;
 }
 
 //-----------------------------------------------------------------------------
-void CheckupInertialMeasurements::setReportInfos_(const AngularSpeedsFrame & angularSpeeds)
+DiagnosticReport CheckupInertialMeasurements::getReport() const
 {
-  setReportInfo(report_, "angular_speed_x", angularSpeeds.angularSpeedAroundXAxis);
-  setReportInfo(report_, "angular_speed_y", angularSpeeds.angularSpeedAroundYAxis);
-  setReportInfo(report_, "angular_speed_z", angularSpeeds.angularSpeedAroundZAxis);
+  return makeReport_(reportValues_.load());
 }
 
 //-----------------------------------------------------------------------------
-void CheckupInertialMeasurements::addDiagnostic_(
-  const DiagnosticStatus & status,
-  const std::string & message)
+uint32_t CheckupInertialMeasurements::getReportVersion()const
 {
-  Diagnostic diagnostic;
-  diagnostic.message = message;
-  diagnostic.status = status;
-  report_.diagnostics.push_back(diagnostic);
+  return reportValues_.getVersion();
 }
 
 //-----------------------------------------------------------------------------
 void CheckupInertialMeasurements::reset()
 {
-  report_.diagnostics.clear();
-  declareReportInfos_();
+  reportValues_.update([](ReportValues & values) {
+      values.accelerationStatus = DiagnosticStatus::STALE;
+      values.angularSpeedStatus = DiagnosticStatus::STALE;
+    });
 }
 
 }  // namespace core
@@ -0,0 +1,142 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/CheckupSampleRate.hpp"
+
+namespace
+{
+const double RATE_WINDOW_DURATION = 2.0;
+const double HEART_BEAT_TIMEOUT = 1.0;
+}
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+CheckupSampleRate::CheckupSampleRate(
+  const std::string & name,
+  const double & minimalRate,
+  const double & epsilon)
+: name_(name),
+  minimalRate_(minimalRate),
+  epsilon_(epsilon),
+  stamps_(std::max(size_t(2), static_cast<size_t>(RATE_WINDOW_DURATION * minimalRate)) + 1),
+  stampIndex_(0),
+  numberOfStamps_(0),
+  hasStamp_(false),
+  lastStamp_(0),
+  isResetRequested_(false),
+  reportValues_({DiagnosticStatus::ERROR, std::numeric_limits<double>::quiet_NaN()})
+{
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus CheckupSampleRate::evaluate(const Duration & stamp)
+{
+  applyRequestedReset_();
+
+  stamps_[stampIndex_] = stamp;
+  stampIndex_ = (stampIndex_ + 1) % stamps_.size();
+  numberOfStamps_ = std::min(numberOfStamps_ + 1, stamps_.size());
+
+  lastStamp_.store(stamp.count());
+  hasStamp_.store(true);
+
+  double rate = std::numeric_limits<double>::quiet_NaN();
+  if (numberOfStamps_ == stamps_.size()) {
+    // oldest stamp is the one that will be overwritten next
+    double windowDuration = durationToSecond(stamp - stamps_[stampIndex_]);
+    if (windowDuration > 0) {
+      rate = (stamps_.size() - 1) / windowDuration;
+    }
+  }
+
+  DiagnosticStatus status = rate > minimalRate_ - epsilon_ ?
+    DiagnosticStatus::OK : DiagnosticStatus::ERROR;
+
+  reportValues_.store({status, rate});
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+bool CheckupSampleRate::heartBeatCallback(const Duration & stamp)
+{
+  if (hasStamp_.load() &&
+    durationToSecond(stamp - Duration(lastStamp_.load())) < HEART_BEAT_TIMEOUT)
+  {
+    return true;
+  }
+
+  reset();
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+void CheckupSampleRate::reset()
+{
+  // stamps buffer is owned by the sample thread, it is cleared at next evaluation
+  hasStamp_.store(false);
+  isResetRequested_.store(true);
+  reportValues_.store({DiagnosticStatus::ERROR, std::numeric_limits<double>::quiet_NaN()});
+}
+
+//-----------------------------------------------------------------------------
+void CheckupSampleRate::applyRequestedReset_()
+{
+  if (isResetRequested_.exchange(false)) {
+    stampIndex_ = 0;
+    numberOfStamps_ = 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport CheckupSampleRate::getReport()const
+{
+  ReportValues values = reportValues_.load();
+
+  DiagnosticReport report;
+  if (values.status == DiagnosticStatus::OK) {
+    report.diagnostics.push_back({DiagnosticStatus::OK, name_ + " rate is OK."});
+  } else if (std::isfinite(values.rate)) {
+    report.diagnostics.push_back({DiagnosticStatus::ERROR, name_ + " rate is too low."});
+  } else {
+    report.diagnostics.push_back({DiagnosticStatus::ERROR, name_ + " rate is not available."});
+  }
+
+  if (std::isfinite(values.rate)) {
+    setReportInfo(report, name_ + "_rate", values.rate);
+  } else {
+    setReportInfo(report, name_ + "_rate", "");
+  }
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t CheckupSampleRate::getReportVersion()const
+{
+  return reportValues_.getVersion();
+}
+
+}  // namespace core
+}  // namespace romea
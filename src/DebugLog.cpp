@@ -0,0 +1,193 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/DebugLog.hpp"
+
+namespace
+{
+
+const size_t WRITE_CHUNK_SIZE = 256;
+const std::chrono::milliseconds WRITER_PERIOD(5);
+
+static_assert(sizeof(romea::core::DebugLogRecord) == 64, "unexpected debug log record size");
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+DebugLog::DebugLog(const std::string & filename, const size_t & capacity)
+: filename_(filename),
+  file_(),
+  records_(capacity),
+  numberOfLoggedRecords_(0),
+  numberOfDroppedRecords_(0),
+  isRunning_(true),
+  writer_()
+{
+  // records are written by chunks, unbuffered writes let failures be detected chunk by chunk
+  file_.rdbuf()->pubsetbuf(nullptr, 0);
+  file_.open(filename, std::ios::binary | std::ios::trunc);
+  if (!file_) {
+    throw std::runtime_error("Unable to open debug log file " + filename);
+  }
+
+  uint32_t recordSize = sizeof(DebugLogRecord);
+  file_.write(MAGIC, sizeof(MAGIC));
+  file_.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+  file_.write(reinterpret_cast<const char *>(&recordSize), sizeof(recordSize));
+
+  writer_ = std::thread(&DebugLog::write_, this);
+}
+
+//-----------------------------------------------------------------------------
+DebugLog::~DebugLog()
+{
+  isRunning_.store(false, std::memory_order_release);
+  writer_.join();
+}
+
+//-----------------------------------------------------------------------------
+bool DebugLog::log(
+  const DebugLogRecord::Type & type,
+  const uint32_t & source,
+  const Duration & stamp,
+  const double & value0,
+  const double & value1,
+  const double & value2,
+  const double & value3,
+  const double & value4,
+  const double & value5)
+{
+  DebugLogRecord record;
+  record.type = type;
+  record.source = source;
+  record.stamp = stamp.count();
+  record.values[0] = value0;
+  record.values[1] = value1;
+  record.values[2] = value2;
+  record.values[3] = value3;
+  record.values[4] = value4;
+  record.values[5] = value5;
+
+  if (!records_.tryPush(record)) {
+    // ring is full, writer thread is late
+    numberOfDroppedRecords_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t DebugLog::getNumberOfLoggedRecords()const
+{
+  return numberOfLoggedRecords_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t DebugLog::getNumberOfDroppedRecords()const
+{
+  return numberOfDroppedRecords_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void DebugLog::write_()
+{
+  std::array<DebugLogRecord, WRITE_CHUNK_SIZE> records;
+  uint64_t numberOfReportedDrops = 0;
+  int64_t lastStamp = 0;
+  std::streampos endOfWrittenRecords = file_.tellp();
+  bool hasWriteFailed = false;
+
+  bool isRunning = true;
+  while (isRunning) {
+    // read flag before draining so that records logged before destruction are all written
+    isRunning = isRunning_.load(std::memory_order_acquire);
+
+    size_t size = 0;
+    do {
+      size = 0;
+      while (size < WRITE_CHUNK_SIZE && records_.tryPop(records[size])) {
+        lastStamp = records[size].stamp;
+        ++size;
+      }
+      size_t numberOfPoppedRecords = size;
+
+      // drop record is stamped with the last record written before the gap
+      uint64_t numberOfDrops = numberOfDroppedRecords_.load(std::memory_order_relaxed);
+      uint64_t previousNumberOfReportedDrops = numberOfReportedDrops;
+      if (numberOfDrops != numberOfReportedDrops && size < WRITE_CHUNK_SIZE) {
+        DebugLogRecord & record = records[size++];
+        record = DebugLogRecord();
+        record.type = DebugLogRecord::DROPPED_RECORDS;
+        record.stamp = lastStamp;
+        record.values[0] = static_cast<double>(numberOfDrops - numberOfReportedDrops);
+        for (size_t n = 1; n < DebugLogRecord::NUMBER_OF_VALUES; ++n) {
+          record.values[n] = std::numeric_limits<double>::quiet_NaN();
+        }
+        numberOfReportedDrops = numberOfDrops;
+      }
+
+      if (size == 0) {
+        break;
+      }
+
+      file_.write(
+        reinterpret_cast<const char *>(records.data()),
+        static_cast<std::streamsize>(size * sizeof(DebugLogRecord)));
+
+      if (file_) {
+        endOfWrittenRecords += static_cast<std::streamoff>(size * sizeof(DebugLogRecord));
+        numberOfLoggedRecords_.fetch_add(numberOfPoppedRecords, std::memory_order_relaxed);
+      } else {
+        // disk full or I/O error, chunk is lost and its records are counted as dropped, the
+        // next chunk overwrites what may have been partially written
+        hasWriteFailed = true;
+        numberOfDroppedRecords_.fetch_add(numberOfPoppedRecords, std::memory_order_relaxed);
+        numberOfReportedDrops = previousNumberOfReportedDrops;
+        file_.clear();
+        file_.seekp(endOfWrittenRecords);
+      }
+    } while (size == WRITE_CHUNK_SIZE);
+
+    if (isRunning) {
+      std::this_thread::sleep_for(WRITER_PERIOD);
+    }
+  }
+
+  file_.close();
+
+  // remove partially written chunk so that file only holds whole records
+  if (hasWriteFailed) {
+    std::error_code error;
+    std::filesystem::resize_file(
+      filename_, static_cast<std::uintmax_t>(endOfWrittenRecords), error);
+  }
+}
+
+}  // namespace core
+}  // namespace romea
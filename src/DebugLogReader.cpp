@@ -0,0 +1,60 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/DebugLogReader.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+DebugLogReader::DebugLogReader(const std::string & filename)
+: file_(filename, std::ios::binary)
+{
+  if (!file_) {
+    throw std::runtime_error("Unable to open debug log file " + filename);
+  }
+
+  char magic[sizeof(DebugLog::MAGIC)];
+  uint32_t version = 0;
+  uint32_t recordSize = 0;
+  file_.read(magic, sizeof(magic));
+  file_.read(reinterpret_cast<char *>(&version), sizeof(version));
+  file_.read(reinterpret_cast<char *>(&recordSize), sizeof(recordSize));
+
+  if (!file_ ||
+    std::memcmp(magic, DebugLog::MAGIC, sizeof(magic)) != 0 ||
+    version != DebugLog::VERSION ||
+    recordSize != sizeof(DebugLogRecord))
+  {
+    throw std::runtime_error("File " + filename + " is not a debug log");
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool DebugLogReader::read(DebugLogRecord & record)
+{
+  return static_cast<bool>(file_.read(reinterpret_cast<char *>(&record), sizeof(record)));
+}
+
+}  // namespace core
+}  // namespace romea
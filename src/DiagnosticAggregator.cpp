@@ -0,0 +1,120 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <utility>
+
+// local
+#include "romea_core_localisation_imu/DiagnosticAggregator.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+DiagnosticAggregator::DiagnosticAggregator(
+  EventCallback eventCallback,
+  ReportCallback reportCallback,
+  const Duration & period,
+  const size_t & capacity)
+: eventCallback_(std::move(eventCallback)),
+  reportCallback_(std::move(reportCallback)),
+  period_(period),
+  events_(capacity),
+  numberOfDroppedEvents_(0),
+  reportMutex_(),
+  report_(),
+  runningMutex_(),
+  runningCondition_(),
+  isRunning_(true),
+  aggregator_()
+{
+  aggregator_ = std::thread(&DiagnosticAggregator::aggregate_, this);
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticAggregator::~DiagnosticAggregator()
+{
+  {
+    std::lock_guard<std::mutex> lock(runningMutex_);
+    isRunning_ = false;
+  }
+  runningCondition_.notify_one();
+  aggregator_.join();
+}
+
+//-----------------------------------------------------------------------------
+bool DiagnosticAggregator::push(
+  const uint32_t & type,
+  const uint32_t & source,
+  const Duration & stamp)
+{
+  if (!events_.tryPush({type, source, stamp.count()})) {
+    numberOfDroppedEvents_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport DiagnosticAggregator::getReport()const
+{
+  std::lock_guard<std::mutex> lock(reportMutex_);
+  return report_;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t DiagnosticAggregator::getNumberOfDroppedEvents()const
+{
+  return numberOfDroppedEvents_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void DiagnosticAggregator::drain_()
+{
+  DiagnosticEvent event;
+  while (events_.tryPop(event)) {
+    eventCallback_(event);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void DiagnosticAggregator::aggregate_()
+{
+  std::unique_lock<std::mutex> runningLock(runningMutex_);
+  while (isRunning_) {
+    runningCondition_.wait_for(runningLock, period_, [this]() {return !isRunning_;});
+    runningLock.unlock();
+
+    drain_();
+
+    DiagnosticReport report = reportCallback_();
+
+    {
+      std::lock_guard<std::mutex> lock(reportMutex_);
+      std::swap(report_, report);
+    }
+
+    runningLock.lock();
+  }
+
+  // events pushed before destruction are not lost
+  runningLock.unlock();
+  drain_();
+}
+
+}  // namespace core
+}  // namespace romea
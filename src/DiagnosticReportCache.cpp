@@ -0,0 +1,48 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// local
+#include "romea_core_localisation_imu/DiagnosticReportCache.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+DiagnosticReportCache::DiagnosticReportCache(const size_t & numberOfSections)
+: sections_(numberOfSections, Section{false, 0, DiagnosticReport()}),
+  isAssembled_(false),
+  report_()
+{
+}
+
+//-----------------------------------------------------------------------------
+const DiagnosticReport & DiagnosticReportCache::getReport()
+{
+  if (!isAssembled_) {
+    report_ = DiagnosticReport();
+    for (const Section & section : sections_) {
+      if (section.isBuilt) {
+        report_ += section.report;
+      }
+    }
+    isAssembled_ = true;
+  }
+  return report_;
+}
+
+}  // namespace core
+}  // namespace romea
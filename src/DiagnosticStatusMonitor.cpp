@@ -0,0 +1,90 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// local
+#include "romea_core_localisation_imu/DiagnosticStatusMonitor.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+DiagnosticStatusMonitor::DiagnosticStatusMonitor(
+  const size_t & numberOfIMUs,
+  const size_t & capacity)
+: statuses_(numberOfIMUs * DiagnosticStatusTransition::NUMBER_OF_CHECKUPS, [](const size_t &) {
+      return std::atomic<DiagnosticStatus>(DiagnosticStatus::STALE);
+    }),
+  transitions_(capacity),
+  generation_(0),
+  numberOfDroppedTransitions_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticStatus DiagnosticStatusMonitor::getStatus(
+  const DiagnosticStatusTransition::Checkup & checkup,
+  const size_t & imuIndex)const
+{
+  return statuses_[index_(checkup, imuIndex)].load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t DiagnosticStatusMonitor::getGeneration()const
+{
+  return generation_.load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+bool DiagnosticStatusMonitor::popTransition(DiagnosticStatusTransition & transition)
+{
+  return transitions_.tryPop(transition);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t DiagnosticStatusMonitor::getNumberOfDroppedTransitions()const
+{
+  return numberOfDroppedTransitions_.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void DiagnosticStatusMonitor::recordTransition_(
+  const DiagnosticStatusTransition::Checkup & checkup,
+  const size_t & imuIndex,
+  const DiagnosticStatus & status,
+  const Duration & stamp)
+{
+  // when several threads observe the same transition, only the first one records it
+  DiagnosticStatus previousStatus =
+    statuses_[index_(checkup, imuIndex)].exchange(status, std::memory_order_acq_rel);
+  if (previousStatus == status) {
+    return;
+  }
+
+  DiagnosticStatusTransition transition;
+  transition.checkup = checkup;
+  transition.imuIndex = static_cast<uint32_t>(imuIndex);
+  transition.previousStatus = previousStatus;
+  transition.status = status;
+  transition.stamp = stamp;
+  if (!transitions_.tryPush(transition)) {
+    numberOfDroppedTransitions_.fetch_add(1, std::memory_order_relaxed);
+  }
+  generation_.fetch_add(1, std::memory_order_release);
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,113 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// local
+#include "romea_core_localisation_imu/LatencyHistogram.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+const char * LatencyStage::toString(const Stage & stage)
+{
+  switch (stage) {
+    case INERTIAL_MEASUREMENT_RATE_CHECKUP:
+      return "inertial_measurement_rate_checkup";
+    case INERTIAL_MEASUREMENT_FRAMES:
+      return "inertial_measurement_frames";
+    case INERTIAL_MEASUREMENT_CHECKUP:
+      return "inertial_measurement_checkup";
+    case ANGULAR_SPEED_BIAS_ESTIMATION:
+      return "angular_speed_bias_estimation";
+    case ATTITUDE_RATE_CHECKUP:
+      return "attitude_rate_checkup";
+    case ATTITUDE_CHECKUP:
+      return "attitude_checkup";
+    case ATTITUDE_PROPAGATION:
+      return "attitude_propagation";
+    case ANGULAR_SPEED_INTEGRATION:
+      return "angular_speed_integration";
+    case SPIKE_REJECTION:
+      return "spike_rejection";
+    case HEART_BEATS:
+      return "heart_beats";
+    case REPORT:
+      return "report";
+  }
+  return "";
+}
+
+//-----------------------------------------------------------------------------
+LatencyHistogram::LatencyHistogram()
+: buckets_(),
+  maximum_(0),
+  count_(0)
+{
+  for (auto & bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LatencyHistogram::getCount()const
+{
+  return count_.load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LatencyHistogram::getBucketCount(const size_t & bucket)const
+{
+  return buckets_[bucket].load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+Duration LatencyHistogram::getPercentile(const double & percentile)const
+{
+  // buckets may be slightly ahead of count when read during a record
+  const uint64_t count = getCount();
+  if (count == 0) {
+    return Duration(0);
+  }
+
+  const uint64_t rank = std::max(
+    static_cast<uint64_t>(std::ceil(percentile / 100. * count)), uint64_t(1));
+
+  uint64_t cumulatedCount = 0;
+  size_t bucket = 0;
+  for (; bucket + 1 < NUMBER_OF_BUCKETS; ++bucket) {
+    cumulatedCount += getBucketCount(bucket);
+    if (cumulatedCount >= rank) {
+      break;
+    }
+  }
+
+  const int64_t upperBound = int64_t(1) << (bucket + 1);
+  return Duration(std::min(upperBound, getMaximum().count()));
+}
+
+//-----------------------------------------------------------------------------
+Duration LatencyHistogram::getMaximum()const
+{
+  return Duration(maximum_.load(std::memory_order_relaxed));
+}
+
+}  // namespace core
+}  // namespace romea
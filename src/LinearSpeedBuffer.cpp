@@ -0,0 +1,114 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <limits>
+
+// local
+#include "romea_core_localisation_imu/LinearSpeedBuffer.hpp"
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+LinearSpeedBuffer::LinearSpeedBuffer(const Duration & maximalAge)
+: maximalAge_(maximalAge),
+  head_(0),
+  slots_()
+{
+  for (Slot & slot : slots_) {
+    slot.sequence.store(0);
+    slot.stamp.store(0);
+    slot.linearSpeed.store(0.);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LinearSpeedBuffer::push(const Duration & stamp, const double & linearSpeed)
+{
+  // slot sequence is odd while written and equal to 2 * (index + 1) once written
+  uint64_t index = head_.load(std::memory_order_relaxed);
+  Slot & slot = slots_[index % CAPACITY];
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.stamp.store(stamp.count(), std::memory_order_relaxed);
+  slot.linearSpeed.store(linearSpeed, std::memory_order_relaxed);
+  slot.sequence.store(2 * index + 2, std::memory_order_release);
+  head_.store(index + 1, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+bool LinearSpeedBuffer::read_(const uint64_t & index, Entry & entry)const
+{
+  const Slot & slot = slots_[index % CAPACITY];
+  if (slot.sequence.load(std::memory_order_acquire) != 2 * index + 2) {
+    return false;
+  }
+
+  entry.stamp = Duration(slot.stamp.load(std::memory_order_relaxed));
+  entry.linearSpeed = slot.linearSpeed.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot.sequence.load(std::memory_order_relaxed) == 2 * index + 2;
+}
+
+//-----------------------------------------------------------------------------
+double LinearSpeedBuffer::interpolate(const Duration & stamp)const
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  const uint64_t tail = head > CAPACITY ? head - CAPACITY : 0;
+
+  // look for the latest speed older than stamp, newer speeds are more likely to be requested
+  bool hasNewer = false;
+  Entry newer;
+  Entry older;
+  uint64_t index = head;
+  while (index > tail) {
+    --index;
+    if (!read_(index, older)) {
+      // slot has been overwritten by the producer, speeds around stamp are lost
+      return nan;
+    }
+
+    if (older.stamp <= stamp) {
+      if (!hasNewer) {
+        return stamp - older.stamp <= maximalAge_ ? older.linearSpeed : nan;
+      }
+
+      // odometry gap, speed may have changed in any way between both speeds
+      if (newer.stamp - older.stamp > maximalAge_) {
+        return nan;
+      }
+
+      double ratio = durationToSecond(stamp - older.stamp) /
+        durationToSecond(newer.stamp - older.stamp);
+      return older.linearSpeed + ratio * (newer.linearSpeed - older.linearSpeed);
+    }
+
+    newer = older;
+    hasNewer = true;
+  }
+
+  // stamp is older than every speed ever pushed, speeds dropped by ring are not extrapolated
+  if (index == 0 && hasNewer && newer.stamp - stamp <= maximalAge_) {
+    return newer.linearSpeed;
+  }
+  return nan;
+}
+
+}  // namespace core
+}  // namespace romea
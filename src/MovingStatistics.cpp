@@ -0,0 +1,104 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// std
+#include <cstring>
+
+// local
+#include "romea_core_localisation_imu/MovingStatistics.hpp"
+
+namespace
+{
+
+// four lanes, one AVX2 register of double, one SSE2 or NEON register of float, two NEON or
+// SSE2 registers of double
+template<typename Scalar>
+struct VectorType;
+
+template<>
+struct VectorType<double>
+{
+  typedef double Type __attribute__((vector_size(32)));
+};
+
+template<>
+struct VectorType<float>
+{
+  typedef float Type __attribute__((vector_size(16)));
+};
+
+template<typename Scalar>
+using Vector = typename VectorType<Scalar>::Type;
+
+// vectors are never passed by value, their calling convention depends on instruction set
+template<typename Scalar>
+void load(Vector<Scalar> & vector, const Scalar * values)
+{
+  std::memcpy(&vector, values, sizeof(vector));
+}
+
+template<typename Scalar>
+void store(Scalar * values, const Vector<Scalar> & vector)
+{
+  std::memcpy(values, &vector, sizeof(vector));
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+template<size_t Lanes, typename Scalar>
+void MovingStatistics<Lanes, Scalar>::accumulate_(const Row & entering, const Row & leaving)
+{
+  Vector<Scalar> offsets, in, out, sums, squaredSums;
+  Vector<Scalar> nextOffsets, nextIn, nextSums, nextSquaredSums;
+  for (size_t n = 0; n < Lanes; n += 4) {
+    load(offsets, offsets_.values + n);
+    load(in, entering.values + n);
+    load(out, leaving.values + n);
+    load(sums, sums_.values + n);
+    load(squaredSums, squaredSums_.values + n);
+    nextIn = in;
+    in -= offsets;
+    out -= offsets;
+    sums += in - out;
+    squaredSums += in * in - out * out;
+    store(sums_.values + n, sums);
+    store(squaredSums_.values + n, squaredSums);
+
+    // leaving row was summed before window wrapped, only entering one is added
+    load(nextOffsets, nextOffsets_.values + n);
+    load(nextSums, nextSums_.values + n);
+    load(nextSquaredSums, nextSquaredSums_.values + n);
+    nextIn -= nextOffsets;
+    nextSums += nextIn;
+    nextSquaredSums += nextIn * nextIn;
+    store(nextSums_.values + n, nextSums);
+    store(nextSquaredSums_.values + n, nextSquaredSums);
+  }
+}
+
+template class MovingStatistics<4, double>;
+template class MovingStatistics<4, float>;
+template class MovingStatistics<8, double>;
+template class MovingStatistics<8, float>;
+
+}  // namespace core
+}  // namespace romea
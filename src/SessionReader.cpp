@@ -0,0 +1,194 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// local
+#include "romea_core_localisation_imu/SessionReader.hpp"
+
+namespace
+{
+
+static_assert(
+  sizeof(romea::core::Duration) == sizeof(int64_t),
+  "session stamps are mapped as durations");
+
+//-----------------------------------------------------------------------------
+bool isValid(const romea::core::SessionFormat & header, const size_t & size)
+{
+  using romea::core::SessionFormat;
+
+  if (std::memcmp(header.magic, SessionFormat::MAGIC, sizeof(header.magic)) != 0 ||
+    header.version != SessionFormat::VERSION)
+  {
+    return false;
+  }
+
+  for (size_t n = 0; n < SessionFormat::NUMBER_OF_COLUMNS; ++n) {
+    uint64_t offset = header.offsets[n];
+    uint64_t numberOfValues = header.getNumberOfValues(static_cast<SessionFormat::Column>(n));
+    if (offset % SessionFormat::ALIGNMENT != 0 ||
+      offset < sizeof(SessionFormat) ||
+      offset > size ||
+      numberOfValues > (size - offset) / sizeof(double))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+SessionReader::SessionReader(const std::string & filename)
+: data_(nullptr),
+  size_(0),
+  header_()
+{
+  int descriptor = ::open(filename.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    throw std::runtime_error("Unable to open session file " + filename);
+  }
+
+  struct stat status;
+  if (::fstat(descriptor, &status) != 0 ||
+    static_cast<size_t>(status.st_size) < sizeof(SessionFormat))
+  {
+    ::close(descriptor);
+    throw std::runtime_error("File " + filename + " is not a session");
+  }
+
+  size_ = static_cast<size_t>(status.st_size);
+  void * mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  ::close(descriptor);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Unable to map session file " + filename);
+  }
+
+  data_ = static_cast<const char *>(mapping);
+  std::memcpy(&header_, data_, sizeof(header_));
+  if (!isValid(header_, size_)) {
+    ::munmap(mapping, size_);
+    throw std::runtime_error("File " + filename + " is not a session");
+  }
+
+  // sessions are mostly scanned from begin to end
+  ::madvise(mapping, size_, MADV_SEQUENTIAL);
+}
+
+//-----------------------------------------------------------------------------
+SessionReader::~SessionReader()
+{
+  ::munmap(const_cast<char *>(data_), size_);
+}
+
+//-----------------------------------------------------------------------------
+size_t SessionReader::getNumberOfInertialMeasurements()const
+{
+  return header_.numberOfInertialMeasurements;
+}
+
+//-----------------------------------------------------------------------------
+size_t SessionReader::getNumberOfAttitudes()const
+{
+  return header_.numberOfAttitudes;
+}
+
+//-----------------------------------------------------------------------------
+size_t SessionReader::getNumberOfLinearSpeeds()const
+{
+  return header_.numberOfLinearSpeeds;
+}
+
+//-----------------------------------------------------------------------------
+InertialMeasurementsBatch SessionReader::getInertialMeasurements(
+  const size_t & begin,
+  const size_t & end)const
+{
+  size_t last = std::min<size_t>(end, header_.numberOfInertialMeasurements);
+  size_t first = std::min(begin, last);
+
+  InertialMeasurementsBatch batch;
+  batch.size = last - first;
+  batch.stamps = column_<Duration>(SessionFormat::INERTIAL_MEASUREMENT_STAMPS, first);
+  batch.accelerationsAlongXAxis = column_<double>(SessionFormat::ACCELERATIONS_ALONG_X_AXIS, first);
+  batch.accelerationsAlongYAxis = column_<double>(SessionFormat::ACCELERATIONS_ALONG_Y_AXIS, first);
+  batch.accelerationsAlongZAxis = column_<double>(SessionFormat::ACCELERATIONS_ALONG_Z_AXIS, first);
+  batch.angularSpeedsAroundXAxis =
+    column_<double>(SessionFormat::ANGULAR_SPEEDS_AROUND_X_AXIS, first);
+  batch.angularSpeedsAroundYAxis =
+    column_<double>(SessionFormat::ANGULAR_SPEEDS_AROUND_Y_AXIS, first);
+  batch.angularSpeedsAroundZAxis =
+    column_<double>(SessionFormat::ANGULAR_SPEEDS_AROUND_Z_AXIS, first);
+  return batch;
+}
+
+//-----------------------------------------------------------------------------
+AttitudesBatch SessionReader::getAttitudes(
+  const size_t & begin,
+  const size_t & end)const
+{
+  size_t last = std::min<size_t>(end, header_.numberOfAttitudes);
+  size_t first = std::min(begin, last);
+
+  AttitudesBatch batch;
+  batch.size = last - first;
+  batch.stamps = column_<Duration>(SessionFormat::ATTITUDE_STAMPS, first);
+  batch.rollAngles = column_<double>(SessionFormat::ROLL_ANGLES, first);
+  batch.pitchAngles = column_<double>(SessionFormat::PITCH_ANGLES, first);
+  batch.courseAngles = column_<double>(SessionFormat::COURSE_ANGLES, first);
+  return batch;
+}
+
+//-----------------------------------------------------------------------------
+LinearSpeedsBatch SessionReader::getLinearSpeeds(
+  const size_t & begin,
+  const size_t & end)const
+{
+  size_t last = std::min<size_t>(end, header_.numberOfLinearSpeeds);
+  size_t first = std::min(begin, last);
+
+  LinearSpeedsBatch batch;
+  batch.size = last - first;
+  batch.stamps = column_<Duration>(SessionFormat::LINEAR_SPEED_STAMPS, first);
+  batch.linearSpeeds = column_<double>(SessionFormat::LINEAR_SPEEDS, first);
+  return batch;
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+const T * SessionReader::column_(const SessionFormat::Column & column, const size_t & begin)const
+{
+  return reinterpret_cast<const T *>(data_ + header_.offsets[column]) + begin;
+}
+
+}  // namespace core
+}  // namespace romea
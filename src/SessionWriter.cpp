@@ -0,0 +1,200 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// std
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// local
+#include "romea_core_localisation_imu/SessionWriter.hpp"
+
+namespace
+{
+
+const size_t COPY_BUFFER_SIZE = 1 << 16;
+
+//-----------------------------------------------------------------------------
+uint64_t align(const uint64_t & offset)
+{
+  const uint64_t alignment = romea::core::SessionFormat::ALIGNMENT;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+SessionWriter::SessionWriter(const std::string & filename)
+: filename_(filename),
+  columns_(),
+  header_(),
+  isClosed_(false)
+{
+  for (size_t n = 0; n < SessionFormat::NUMBER_OF_COLUMNS; ++n) {
+    columns_[n].open(makeColumnFilename_(n), std::ios::binary | std::ios::trunc);
+    if (!columns_[n]) {
+      removeColumnFiles_();
+      throw std::runtime_error("Unable to open session column file " + makeColumnFilename_(n));
+    }
+  }
+
+  std::memcpy(header_.magic, SessionFormat::MAGIC, sizeof(header_.magic));
+  header_.version = SessionFormat::VERSION;
+  header_.numberOfInertialMeasurements = 0;
+  header_.numberOfAttitudes = 0;
+  header_.numberOfLinearSpeeds = 0;
+}
+
+//-----------------------------------------------------------------------------
+SessionWriter::~SessionWriter()
+{
+  if (!isClosed_) {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void SessionWriter::addInertialMeasurements(
+  const Duration & stamp,
+  const double & accelerationAlongXAxis,
+  const double & accelerationAlongYAxis,
+  const double & accelerationAlongZAxis,
+  const double & angularSpeedAroundXAxis,
+  const double & angularSpeedAroundYAxis,
+  const double & angularSpeedAroundZAxis)
+{
+  append_(SessionFormat::INERTIAL_MEASUREMENT_STAMPS, stamp);
+  append_(SessionFormat::ACCELERATIONS_ALONG_X_AXIS, accelerationAlongXAxis);
+  append_(SessionFormat::ACCELERATIONS_ALONG_Y_AXIS, accelerationAlongYAxis);
+  append_(SessionFormat::ACCELERATIONS_ALONG_Z_AXIS, accelerationAlongZAxis);
+  append_(SessionFormat::ANGULAR_SPEEDS_AROUND_X_AXIS, angularSpeedAroundXAxis);
+  append_(SessionFormat::ANGULAR_SPEEDS_AROUND_Y_AXIS, angularSpeedAroundYAxis);
+  append_(SessionFormat::ANGULAR_SPEEDS_AROUND_Z_AXIS, angularSpeedAroundZAxis);
+  ++header_.numberOfInertialMeasurements;
+}
+
+//-----------------------------------------------------------------------------
+void SessionWriter::addAttitude(
+  const Duration & stamp,
+  const double & rollAngle,
+  const double & pitchAngle,
+  const double & courseAngle)
+{
+  append_(SessionFormat::ATTITUDE_STAMPS, stamp);
+  append_(SessionFormat::ROLL_ANGLES, rollAngle);
+  append_(SessionFormat::PITCH_ANGLES, pitchAngle);
+  append_(SessionFormat::COURSE_ANGLES, courseAngle);
+  ++header_.numberOfAttitudes;
+}
+
+//-----------------------------------------------------------------------------
+void SessionWriter::addLinearSpeed(
+  const Duration & stamp,
+  const double & linearSpeed)
+{
+  append_(SessionFormat::LINEAR_SPEED_STAMPS, stamp);
+  append_(SessionFormat::LINEAR_SPEEDS, linearSpeed);
+  ++header_.numberOfLinearSpeeds;
+}
+
+//-----------------------------------------------------------------------------
+void SessionWriter::close()
+{
+  isClosed_ = true;
+
+  bool isOk = true;
+  for (auto & column : columns_) {
+    column.close();
+    isOk = isOk && !column.fail();
+  }
+
+  uint64_t offset = align(sizeof(SessionFormat));
+  for (size_t n = 0; n < SessionFormat::NUMBER_OF_COLUMNS; ++n) {
+    header_.offsets[n] = offset;
+    auto column = static_cast<SessionFormat::Column>(n);
+    offset = align(offset + header_.getNumberOfValues(column) * sizeof(double));
+  }
+
+  std::ofstream file(filename_, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+  uint64_t position = sizeof(header_);
+
+  std::array<char, COPY_BUFFER_SIZE> buffer;
+  const std::array<char, SessionFormat::ALIGNMENT> padding{};
+  for (size_t n = 0; n <= SessionFormat::NUMBER_OF_COLUMNS && isOk && file; ++n) {
+    // pad up to next column offset, or up to the end of the last column
+    uint64_t columnOffset = n < SessionFormat::NUMBER_OF_COLUMNS ? header_.offsets[n] : offset;
+    if (position > columnOffset || columnOffset - position >= SessionFormat::ALIGNMENT) {
+      isOk = false;
+      break;
+    }
+    file.write(padding.data(), static_cast<std::streamsize>(columnOffset - position));
+    position = columnOffset;
+
+    if (n < SessionFormat::NUMBER_OF_COLUMNS) {
+      std::ifstream column(makeColumnFilename_(n), std::ios::binary);
+      while (column.read(buffer.data(), buffer.size()) || column.gcount() > 0) {
+        file.write(buffer.data(), column.gcount());
+        position += static_cast<uint64_t>(column.gcount());
+      }
+    }
+  }
+  file.close();
+
+  removeColumnFiles_();
+  if (!isOk || file.fail()) {
+    throw std::runtime_error("Unable to write session file " + filename_);
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::string SessionWriter::makeColumnFilename_(const size_t & column)const
+{
+  return filename_ + ".column" + std::to_string(column);
+}
+
+//-----------------------------------------------------------------------------
+void SessionWriter::append_(const SessionFormat::Column & column, const double & value)
+{
+  columns_[column].write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+//-----------------------------------------------------------------------------
+void SessionWriter::append_(const SessionFormat::Column & column, const Duration & stamp)
+{
+  int64_t nanoseconds = stamp.count();
+  columns_[column].write(reinterpret_cast<const char *>(&nanoseconds), sizeof(nanoseconds));
+}
+
+//-----------------------------------------------------------------------------
+void SessionWriter::removeColumnFiles_()
+{
+  for (size_t n = 0; n < SessionFormat::NUMBER_OF_COLUMNS; ++n) {
+    std::remove(makeColumnFilename_(n).c_str());
+  }
+}
+
+}  // namespace core
+}  // namespace romea
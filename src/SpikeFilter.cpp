@@ -0,0 +1,257 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// std
+#include <cstdint>
+#include <cstring>
+
+// local
+#include "romea_core_localisation_imu/SpikeFilter.hpp"
+
+namespace
+{
+// median absolute deviation of normal distribution
+const double MAD_TO_STD = 1.4826;
+const double OUTLIER_THRESHOLD = 6.;
+
+// one register, four lanes with AVX and two lanes with SSE2 or NEON: compare and select
+// operations on wider vectors are split lane by lane by the compiler
+#ifdef __AVX__
+typedef double Vector __attribute__((vector_size(32)));
+typedef int64_t Mask __attribute__((vector_size(32)));
+#else
+typedef double Vector __attribute__((vector_size(16)));
+typedef int64_t Mask __attribute__((vector_size(16)));
+#endif
+
+// all lanes of a row, vectors are processed side by side so that their operations overlap
+const size_t NUMBER_OF_ROW_VALUES = 8;
+const size_t NUMBER_OF_VECTORS = NUMBER_OF_ROW_VALUES * sizeof(double) / sizeof(Vector);
+
+struct Lanes
+{
+  Vector vectors[NUMBER_OF_VECTORS];
+};
+
+typedef Lanes Window[romea::core::SpikeFilter::WINDOW_SIZE];
+
+// vectors are never passed by value, their calling convention depends on instruction set
+void load(Lanes & lanes, const double * values)
+{
+  std::memcpy(&lanes, values, sizeof(lanes));
+}
+
+void store(double * values, const Lanes & lanes)
+{
+  std::memcpy(values, &lanes, sizeof(lanes));
+}
+
+void compareExchange(Lanes & lower, Lanes & upper)
+{
+  for (size_t n = 0; n < NUMBER_OF_VECTORS; ++n) {
+    const Mask isLower = lower.vectors[n] < upper.vectors[n];
+    const Vector minimum = isLower ? lower.vectors[n] : upper.vectors[n];
+    upper.vectors[n] = isLower ? upper.vectors[n] : lower.vectors[n];
+    lower.vectors[n] = minimum;
+  }
+}
+
+// seven compare exchanges select the third of five values, lanes are independent
+void median(Window & window, Lanes & center)
+{
+  static_assert(romea::core::SpikeFilter::WINDOW_SIZE == 5,
+    "selection network is written for five samples");
+
+  compareExchange(window[0], window[1]);
+  compareExchange(window[3], window[4]);
+  compareExchange(window[0], window[3]);
+  compareExchange(window[1], window[4]);
+  compareExchange(window[1], window[2]);
+  compareExchange(window[2], window[3]);
+  compareExchange(window[1], window[2]);
+  center = window[2];
+}
+
+void absoluteDifference(const Lanes & lhs, const Lanes & rhs, Lanes & difference)
+{
+  for (size_t n = 0; n < NUMBER_OF_VECTORS; ++n) {
+    const Vector vector = lhs.vectors[n] - rhs.vectors[n];
+    difference.vectors[n] = vector < 0. ? -vector : vector;
+  }
+}
+
+// true when one lane of lhs is greater than factor times the same lane of rhs
+bool isAnyGreater(const Lanes & lhs, const double & factor, const Lanes & rhs)
+{
+  Mask isGreater = lhs.vectors[0] > factor * rhs.vectors[0];
+  for (size_t n = 1; n < NUMBER_OF_VECTORS; ++n) {
+    isGreater |= lhs.vectors[n] > factor * rhs.vectors[n];
+  }
+
+  int64_t values[sizeof(Mask) / sizeof(int64_t)];
+  std::memcpy(values, &isGreater, sizeof(isGreater));
+  for (const int64_t & value : values) {
+    if (value != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace core
+{
+
+//-----------------------------------------------------------------------------
+SpikeFilter::SpikeFilter(
+  const double & accelerationStd,
+  const double & angularSpeedStd)
+: noiseStds_(),
+  rows_(),
+  index_(0),
+  numberOfRows_(0),
+  isResetRequested_(false),
+  counters_({0, 0}),
+  reportValues_(counters_)
+{
+  for (size_t lane = 0; lane < 3; ++lane) {
+    noiseStds_.values[lane] = accelerationStd;
+    noiseStds_.values[lane + 3] = angularSpeedStd;
+  }
+  noiseStds_.values[6] = noiseStds_.values[7] = 1.;
+}
+
+//-----------------------------------------------------------------------------
+bool SpikeFilter::filter(
+  AccelerationsFrame & accelerations,
+  AngularSpeedsFrame & angularSpeeds)
+{
+  applyRequestedReset_();
+
+  Row & row = rows_[index_];
+  row.values[0] = accelerations.accelerationAlongXAxis;
+  row.values[1] = accelerations.accelerationAlongYAxis;
+  row.values[2] = accelerations.accelerationAlongZAxis;
+  row.values[3] = angularSpeeds.angularSpeedAroundXAxis;
+  row.values[4] = angularSpeeds.angularSpeedAroundYAxis;
+  row.values[5] = angularSpeeds.angularSpeedAroundZAxis;
+  row.values[6] = row.values[7] = 0.;
+
+  // sample filling the window is checked against it
+  index_ = (index_ + 1) % WINDOW_SIZE;
+  if (numberOfRows_ < WINDOW_SIZE && ++numberOfRows_ < WINDOW_SIZE) {
+    return false;
+  }
+
+  static_assert(sizeof(Row) == sizeof(Lanes), "rows are loaded as vectors");
+
+  Window window;
+  Lanes sample, center, distance, noiseStds;
+  load(sample, row.values);
+  load(noiseStds, noiseStds_.values);
+  for (size_t n = 0; n < WINDOW_SIZE; ++n) {
+    load(window[n], rows_[n].values);
+  }
+  median(window, center);
+  absoluteDifference(sample, center, distance);
+
+  // threshold is never below six noise stds, deviation is only needed above it
+  if (!isAnyGreater(distance, OUTLIER_THRESHOLD, noiseStds)) {
+    return false;
+  }
+
+  Lanes deviation;
+  for (size_t n = 0; n < WINDOW_SIZE; ++n) {
+    load(deviation, rows_[n].values);
+    absoluteDifference(deviation, center, window[n]);
+  }
+  median(window, deviation);
+
+  Lanes selected;
+  int64_t isSpike[NUMBER_OF_LANES];
+  for (size_t n = 0; n < NUMBER_OF_VECTORS; ++n) {
+    const Vector scaledDeviation = MAD_TO_STD * deviation.vectors[n];
+    const Vector threshold = OUTLIER_THRESHOLD *
+      (scaledDeviation > noiseStds.vectors[n] ? scaledDeviation : noiseStds.vectors[n]);
+    const Mask isVectorSpike = distance.vectors[n] > threshold;
+    selected.vectors[n] = isVectorSpike ? center.vectors[n] : sample.vectors[n];
+    std::memcpy(isSpike + n * sizeof(Vector) / sizeof(double), &isVectorSpike, sizeof(Mask));
+  }
+
+  Row filtered;
+  store(filtered.values, selected);
+
+  const bool isAccelerationSpike = isSpike[0] || isSpike[1] || isSpike[2];
+  const bool isAngularSpeedSpike = isSpike[3] || isSpike[4] || isSpike[5];
+  if (!isAccelerationSpike && !isAngularSpeedSpike) {
+    return false;
+  }
+
+  accelerations.accelerationAlongXAxis = filtered.values[0];
+  accelerations.accelerationAlongYAxis = filtered.values[1];
+  accelerations.accelerationAlongZAxis = filtered.values[2];
+  angularSpeeds.angularSpeedAroundXAxis = filtered.values[3];
+  angularSpeeds.angularSpeedAroundYAxis = filtered.values[4];
+  angularSpeeds.angularSpeedAroundZAxis = filtered.values[5];
+
+  counters_.numberOfAccelerationSpikes += isAccelerationSpike;
+  counters_.numberOfAngularSpeedSpikes += isAngularSpeedSpike;
+  reportValues_.store(counters_);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void SpikeFilter::reset()
+{
+  // window is owned by the sample thread, it is emptied at next filtering
+  isResetRequested_.store(true);
+}
+
+//-----------------------------------------------------------------------------
+void SpikeFilter::applyRequestedReset_()
+{
+  if (isResetRequested_.exchange(false)) {
+    index_ = 0;
+    numberOfRows_ = 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport SpikeFilter::makeReport_(const ReportValues & values)
+{
+  DiagnosticReport report;
+  setReportInfo(report, "acceleration_spikes", values.numberOfAccelerationSpikes);
+  setReportInfo(report, "angular_speed_spikes", values.numberOfAngularSpeedSpikes);
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+DiagnosticReport SpikeFilter::getReport()const
+{
+  return makeReport_(reportValues_.load());
+}
+
+//-----------------------------------------------------------------------------
+uint32_t SpikeFilter::getReportVersion()const
+{
+  return reportValues_.getVersion();
+}
+
+}  // namespace core
+}  // namespace romea
@@ -0,0 +1,143 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// local
+#include "allocation_counter.hpp"
+
+namespace
+{
+std::atomic<size_t> numberOfAllocations(0);
+
+//-----------------------------------------------------------------------------
+void * allocate(std::size_t size)
+{
+  numberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void * pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+//-----------------------------------------------------------------------------
+void * allocate(std::size_t size, std::align_val_t alignment)
+{
+  // aligned_alloc requires a size multiple of alignment
+  numberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+  const std::size_t alignmentSize = static_cast<std::size_t>(alignment);
+  const std::size_t alignedSize = (std::max<std::size_t>(size, 1) + alignmentSize - 1) /
+    alignmentSize * alignmentSize;
+  if (void * pointer = std::aligned_alloc(alignmentSize, alignedSize)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+size_t getNumberOfAllocations()
+{
+  return numberOfAllocations.load(std::memory_order_relaxed);
+}
+
+// nothrow and array versions of libstdc++ and libc++ forward to the replaced ones below, they
+// are replaced anyway so that counting does not depend on the standard library
+
+//-----------------------------------------------------------------------------
+void * operator new(std::size_t size)
+{
+  return allocate(size);
+}
+
+void * operator new[](std::size_t size)
+{
+  return allocate(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  try {
+    return allocate(size);
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+  try {
+    return allocate(size);
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+  return allocate(size, alignment);
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return allocate(size, alignment);
+}
+
+//-----------------------------------------------------------------------------
+void operator delete(void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void * pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void * pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void * pointer, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void * pointer, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void * pointer, std::size_t, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void * pointer, std::size_t, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
@@ -0,0 +1,28 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifndef TEST__ALLOCATION_COUNTER_HPP_
+#define TEST__ALLOCATION_COUNTER_HPP_
+
+// std
+#include <cstddef>
+
+// Global operator new and delete are replaced by counting ones in allocation_counter.cpp,
+// which has to be compiled into the executable using this function. Plain, array, nothrow
+// and over-aligned allocations are all counted.
+size_t getNumberOfAllocations();
+
+#endif  // TEST__ALLOCATION_COUNTER_HPP_
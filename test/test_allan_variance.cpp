@@ -0,0 +1,182 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <random>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/AllanVariance.hpp"
+
+using romea::core::AllanVariance;
+
+//-----------------------------------------------------------------------------
+std::vector<double> averagePairs(const std::vector<double> & clusters)
+{
+  std::vector<double> averages;
+  for (size_t n = 0; n + 1 < clusters.size(); n += 2) {
+    averages.push_back(0.5 * (clusters[n] + clusters[n + 1]));
+  }
+  return averages;
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAllanVariance, empty)
+{
+  AllanVariance allanVariance(0.01);
+  EXPECT_DOUBLE_EQ(allanVariance.getClusterDuration(0), 0.01);
+  EXPECT_DOUBLE_EQ(allanVariance.getClusterDuration(3), 0.08);
+  EXPECT_EQ(allanVariance.getNumberOfDifferences(0), 0u);
+  EXPECT_TRUE(std::isnan(allanVariance.getVariance(0)));
+  EXPECT_FALSE(allanVariance.getRandomWalk().has_value());
+  EXPECT_FALSE(allanVariance.getBiasInstability().has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAllanVariance, matchesNaiveComputation)
+{
+  AllanVariance allanVariance(0.01);
+  std::default_random_engine generator(0);
+  std::normal_distribution<double> distribution(0., 0.01);
+
+  std::vector<double> samples;
+  for (size_t n = 0; n < 1000; ++n) {
+    samples.push_back(distribution(generator) + 1e-4 * n);
+    allanVariance.update(samples.back());
+  }
+
+  // level k is computed from half overlapping clusters of 2^k samples
+  std::vector<double> clusters = samples;
+  for (size_t level = 0; level < 9; ++level) {
+    double sumOfSquaredDifferences = 0;
+    size_t numberOfDifferences = 0;
+    if (level == 0) {
+      for (size_t n = 0; n + 1 < samples.size(); ++n) {
+        sumOfSquaredDifferences += std::pow(samples[n + 1] - samples[n], 2);
+        ++numberOfDifferences;
+      }
+    } else {
+      for (size_t n = 0; n + 3 < clusters.size(); ++n) {
+        sumOfSquaredDifferences += std::pow(
+          0.5 * (clusters[n + 3] + clusters[n + 2] - clusters[n + 1] - clusters[n]), 2);
+        ++numberOfDifferences;
+      }
+      clusters = averagePairs(clusters);
+    }
+
+    EXPECT_EQ(allanVariance.getNumberOfDifferences(level), numberOfDifferences);
+    EXPECT_NEAR(
+      allanVariance.getVariance(level),
+      0.5 * sumOfSquaredDifferences / numberOfDifferences, 1e-12);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAllanVariance, whiteNoise)
+{
+  const double samplingPeriod = 0.01;
+  const double randomWalk = 0.001;
+  AllanVariance allanVariance(samplingPeriod);
+
+  std::default_random_engine generator(0);
+  std::normal_distribution<double> distribution(0., randomWalk / std::sqrt(samplingPeriod));
+  for (size_t n = 0; n < 100000; ++n) {
+    allanVariance.update(distribution(generator) + 0.05);
+  }
+
+  ASSERT_TRUE(allanVariance.getRandomWalk().has_value());
+  EXPECT_NEAR(*allanVariance.getRandomWalk(), randomWalk, 0.02 * randomWalk);
+
+  // deviation decreases as inverse square root of cluster duration
+  for (size_t level = 0; level < 10; ++level) {
+    double tau = allanVariance.getClusterDuration(level);
+    EXPECT_NEAR(allanVariance.getDeviation(level) * std::sqrt(tau), randomWalk, 0.1 * randomWalk);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAllanVariance, biasInstability)
+{
+  const double samplingPeriod = 0.01;
+  const double randomWalk = 0.001;
+  const double rateRandomWalk = 1e-5;
+  AllanVariance allanVariance(samplingPeriod);
+
+  std::default_random_engine generator(0);
+  std::normal_distribution<double> whiteNoise(0., randomWalk / std::sqrt(samplingPeriod));
+  std::normal_distribution<double> biasNoise(0., rateRandomWalk * std::sqrt(samplingPeriod));
+
+  double bias = 0;
+  for (size_t n = 0; n < 1000000; ++n) {
+    bias += biasNoise(generator);
+    allanVariance.update(bias + whiteNoise(generator));
+
+    // curve is still decreasing during first seconds
+    if (n == 1000) {
+      EXPECT_FALSE(allanVariance.getBiasInstability().has_value());
+    }
+  }
+
+  // Allan deviation floor is reached at tau = sqrt(3) N / K
+  double minimalDeviation = std::sqrt(2. * randomWalk * rateRandomWalk / std::sqrt(3.));
+  ASSERT_TRUE(allanVariance.getBiasInstability().has_value());
+  EXPECT_NEAR(
+    *allanVariance.getBiasInstability() * 0.664, minimalDeviation, 0.2 * minimalDeviation);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAllanVariance, interruption)
+{
+  AllanVariance allanVariance(0.01);
+  for (size_t n = 0; n < 1000; ++n) {
+    allanVariance.update(0.);
+  }
+  allanVariance.interrupt();
+  for (size_t n = 0; n < 1000; ++n) {
+    allanVariance.update(1.);
+  }
+
+  // no cluster spans the step
+  for (size_t level = 0; level < 8; ++level) {
+    EXPECT_GT(allanVariance.getNumberOfDifferences(level), 0u);
+    EXPECT_DOUBLE_EQ(allanVariance.getVariance(level), 0.);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAllanVariance, reset)
+{
+  AllanVariance allanVariance(0.01);
+  for (size_t n = 0; n < 100; ++n) {
+    allanVariance.update(n % 2);
+  }
+  EXPECT_TRUE(allanVariance.getRandomWalk().has_value());
+
+  allanVariance.reset();
+  EXPECT_EQ(allanVariance.getNumberOfDifferences(0), 0u);
+  EXPECT_FALSE(allanVariance.getRandomWalk().has_value());
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,10 +17,14 @@
 #include <gtest/gtest.h>
 
 // std
+#include <cmath>
+#include <optional>
 #include <random>
 #include <string>
 
 // romea
+#include "romea_core_common/math/OnlineAverage.hpp"
+#include "romea_core_imu/algorithms/ZeroVelocityEstimator.hpp"
 #include "romea_core_localisation_imu/AngularSpeedBias.hpp"
 
 bool boolean(const romea::core::DiagnosticStatus & status)
@@ -165,6 +169,195 @@ TEST_F(TestAngularSpeedBias, testResetAfterAllOK)
   EXPECT_EQ(report.diagnostics.front().status, romea::core::DiagnosticStatus::WARN);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBias, testNoiseEstimation)
+{
+  // mounted sensor noisier than datasheet, but still below zero velocity thresholds
+  linearSpeed = 0;
+  accelerationDistribution = std::normal_distribution<double>(0., 2.5 * accelerationStd);
+  angularSpeedDistribution = std::normal_distribution<double>(0., 2.5 * angularSpeedStd);
+  for (size_t n = 0; n < 30 * rate; ++n) {
+    makeAccelerationFrame();
+    makeAngularSpeedFrame();
+    angularSpeedBiasEstimator.evaluate(linearSpeed, accelerations, angularSpeeds);
+  }
+
+  report = angularSpeedBiasEstimator.getReport();
+  double angleRandomWalk = 2.5 * angularSpeedStd / std::sqrt(rate);
+  double velocityRandomWalk = 2.5 * accelerationStd / std::sqrt(rate);
+  EXPECT_NEAR(std::stod(report.info["angle_random_walk"]), angleRandomWalk, 0.1 * angleRandomWalk);
+  EXPECT_NEAR(
+    std::stod(report.info["velocity_random_walk"]), velocityRandomWalk, 0.1 * velocityRandomWalk);
+
+  // zero velocity thresholds follow estimated noise instead of datasheet values, so that
+  // bias estimation goes on with twice more noise, whereas datasheet thresholds are exceeded
+  angularSpeedDistribution = std::normal_distribution<double>(0.02, 5 * angularSpeedStd);
+  std::optional<double> bias;
+  for (size_t n = 0; n < 10 * rate; ++n) {
+    makeAccelerationFrame();
+    makeAngularSpeedFrame();
+    bias = angularSpeedBiasEstimator.evaluate(linearSpeed, accelerations, angularSpeeds);
+  }
+  ASSERT_TRUE(bias.has_value());
+  EXPECT_NEAR(*bias, 0.02, 0.01);
+
+  angularSpeedBiasEstimator.reset(true);
+  report = angularSpeedBiasEstimator.getReport();
+  EXPECT_EQ(report.info["angle_random_walk"], "");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBias, testNoiseEstimationRaisesThresholds)
+{
+  // datasheet values five times lower than the actual noise of the sensor, standstill is only
+  // confirmed by odometry until measured noise raises zero velocity thresholds
+  romea::core::AngularSpeedBias estimator(rate, accelerationStd / 5, angularSpeedStd / 5);
+  linearSpeed = 0;
+  accelerationDistribution = std::normal_distribution<double>(0., accelerationStd);
+  angularSpeedDistribution = std::normal_distribution<double>(0.02, angularSpeedStd);
+
+  std::optional<double> bias;
+  for (size_t n = 0; n < 10 * rate; ++n) {
+    makeAccelerationFrame();
+    makeAngularSpeedFrame();
+    bias = estimator.evaluate(linearSpeed, accelerations, angularSpeeds);
+    EXPECT_FALSE(bias.has_value());
+  }
+
+  for (size_t n = 0; n < 10 * rate; ++n) {
+    makeAccelerationFrame();
+    makeAngularSpeedFrame();
+    bias = estimator.evaluate(linearSpeed, accelerations, angularSpeeds);
+  }
+  ASSERT_TRUE(bias.has_value());
+  EXPECT_NEAR(*bias, 0.02, 0.005);
+
+  report = estimator.getReport();
+  double angleRandomWalk = angularSpeedStd / std::sqrt(rate);
+  EXPECT_NEAR(std::stod(report.info["angle_random_walk"]), angleRandomWalk, 0.1 * angleRandomWalk);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBias, testRecursiveFilter)
+{
+  romea::core::AngularSpeedBias recursiveEstimator(rate, accelerationStd, angularSpeedStd,
+    romea::core::AngularSpeedBiasEstimation::RECURSIVE_FILTER);
+
+  linearSpeed = 0;
+  accelerationDistribution = std::normal_distribution<double>(0., accelerationStd);
+  angularSpeedDistribution = std::normal_distribution<double>(0.02, angularSpeedStd);
+
+  // zero velocity window is full at sample 2 * rate - 1, then bias needs 0.2 s of samples
+  size_t firstAvailableSample = 0;
+  std::optional<double> bias;
+  double biasVariance = 0;
+  for (size_t n = 0; n < 5 * rate; ++n) {
+    makeAccelerationFrame();
+    makeAngularSpeedFrame();
+    recursiveEstimator.evaluate(&linearSpeed, &accelerations, &angularSpeeds, 1, &bias,
+      &biasVariance);
+    if (bias.has_value() && firstAvailableSample == 0) {
+      firstAvailableSample = n;
+      EXPECT_NEAR(*bias, 0.02, 3 * std::sqrt(biasVariance));
+    }
+  }
+  EXPECT_EQ(firstAvailableSample, static_cast<size_t>((2 + 0.2) * rate) - 2);
+  ASSERT_TRUE(bias.has_value());
+  EXPECT_NEAR(*bias, 0.02, 3 * std::sqrt(biasVariance));
+  EXPECT_LT(biasVariance, angularSpeedStd * angularSpeedStd / (2 * rate));
+
+  report = recursiveEstimator.getReport();
+  EXPECT_EQ(report.diagnostics.front().status, romea::core::DiagnosticStatus::OK);
+  EXPECT_NEAR(std::stod(report.info["angular_speed_bias_std"]), std::sqrt(biasVariance), 1e-9);
+
+  // bias is kept while moving, its variance grows with random walk model
+  linearSpeed = 1.;
+  double standstillBiasVariance = biasVariance;
+  for (size_t n = 0; n < 10 * rate; ++n) {
+    makeAccelerationFrame();
+    makeAngularSpeedFrame();
+    recursiveEstimator.evaluate(&linearSpeed, &accelerations, &angularSpeeds, 1, &bias,
+      &biasVariance);
+    ASSERT_TRUE(bias.has_value());
+  }
+  EXPECT_NEAR(biasVariance, standstillBiasVariance + 10 * 1e-8, 1e-12);
+
+  // warm start
+  double movingBiasVariance = biasVariance;
+  auto prior = recursiveEstimator.makePrior();
+  ASSERT_TRUE(prior.has_value());
+  romea::core::AngularSpeedBias warmStartedEstimator(rate, accelerationStd, angularSpeedStd,
+    romea::core::AngularSpeedBiasEstimation::RECURSIVE_FILTER);
+  warmStartedEstimator.setPrior(*prior);
+  warmStartedEstimator.evaluate(&linearSpeed, &accelerations, &angularSpeeds, 1, &bias,
+    &biasVariance);
+  ASSERT_TRUE(bias.has_value());
+  EXPECT_NEAR(*bias, prior->angularSpeedBiases.angularSpeedAroundZAxis, 1e-12);
+  EXPECT_NEAR(biasVariance, movingBiasVariance, 0.02 * movingBiasVariance);
+
+  recursiveEstimator.reset(false);
+  recursiveEstimator.evaluate(&linearSpeed, &accelerations, &angularSpeeds, 1, &bias);
+  EXPECT_FALSE(bias.has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBias, testZeroVelocityAgainstBaselineEstimator)
+{
+  // baseline estimation: zero velocity estimator gating a 5 s online average of z angular speed
+  auto compare = [this](double accelerationScale, double angularSpeedScale, double xScale) {
+      romea::core::AngularSpeedBias estimator(rate, accelerationStd, angularSpeedStd);
+      romea::core::ZeroVelocityEstimator zeroVelocity(rate, accelerationStd, angularSpeedStd);
+      romea::core::OnlineAverage average(0.0001, 5 * rate);
+      std::normal_distribution<double> accelerationNoise(0., accelerationScale * accelerationStd);
+      std::normal_distribution<double> angularSpeedNoise(0., angularSpeedScale * angularSpeedStd);
+
+      // shorter than noise estimation duration, so that thresholds stay datasheet ones
+      size_t numberOfMismatches = 0;
+      for (size_t n = 0; n < 9 * rate; ++n) {
+        makeAccelerationFrame();
+        makeAngularSpeedFrame();
+        accelerations.accelerationAlongXAxis *= xScale;
+        angularSpeeds.angularSpeedAroundXAxis *= xScale;
+        accelerations.accelerationAlongYAxis = accelerationNoise(generator);
+        angularSpeeds.angularSpeedAroundYAxis = angularSpeedNoise(generator);
+        angularSpeeds.angularSpeedAroundZAxis += 0.02;
+
+        auto bias = estimator.evaluate(linearSpeed, accelerations, angularSpeeds);
+        if (zeroVelocity.update(
+            accelerations.accelerationAlongXAxis,
+            accelerations.accelerationAlongYAxis,
+            accelerations.accelerationAlongZAxis,
+            angularSpeeds.angularSpeedAroundXAxis,
+            angularSpeeds.angularSpeedAroundYAxis,
+            angularSpeeds.angularSpeedAroundZAxis))
+        {
+          average.update(angularSpeeds.angularSpeedAroundZAxis);
+        }
+
+        if (bias.has_value() != average.isAvailable()) {
+          ++numberOfMismatches;
+        } else if (bias.has_value()) {
+          // baseline average is quantized with a 1e-4 precision
+          EXPECT_NEAR(*bias, average.getAverage(), 1e-4);
+        }
+      }
+      return numberOfMismatches;
+    };
+
+  linearSpeed = 0;
+  accelerationDistribution = std::normal_distribution<double>(0., accelerationStd);
+  angularSpeedDistribution = std::normal_distribution<double>(0., angularSpeedStd);
+
+  // datasheet noise and quieter sensor: both provide the same bias at the same sample
+  EXPECT_EQ(compare(1., 1., 1.), 0u);
+  EXPECT_EQ(compare(0.5, 0.5, 0.5), 0u);
+  // vibrations on every axis: neither provides a bias
+  EXPECT_EQ(compare(5., 5., 5.), 0u);
+  // vibrations on a single axis: per axis rule rejects them as baseline does
+  EXPECT_EQ(compare(1., 1., 10.), 0u);
+  EXPECT_EQ(compare(10., 1., 1.), 0u);
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
@@ -0,0 +1,230 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+// romea
+#include "romea_core_localisation_imu/AngularSpeedBias.hpp"
+#include "romea_core_localisation_imu/AngularSpeedBiasPrior.hpp"
+
+
+class TestAngularSpeedBiasPrior : public ::testing::Test
+{
+public:
+  TestAngularSpeedBiasPrior()
+  : rate(50.),
+    accelerationStd(0.001),
+    angularSpeedStd(0.01),
+    filename(::testing::TempDir() + "angular_speed_bias_prior.bin"),
+    prior()
+  {
+    prior.imuRate = rate;
+    prior.accelerationStd = accelerationStd;
+    prior.angularSpeedStd = angularSpeedStd;
+    prior.angularSpeedBiases.angularSpeedAroundXAxis = 0.001;
+    prior.angularSpeedBiases.angularSpeedAroundYAxis = -0.002;
+    prior.angularSpeedBiases.angularSpeedAroundZAxis = 0.003;
+    prior.numberOfSamples = 250;
+    prior.measuredAccelerationStd = 0.0011;
+    prior.measuredAngularSpeedStd = 0.0098;
+  }
+
+  void TearDown() override
+  {
+    std::remove(filename.c_str());
+  }
+
+  std::optional<romea::core::AngularSpeedBiasPrior> load()
+  {
+    return romea::core::loadAngularSpeedBiasPrior(
+      filename, rate, accelerationStd, angularSpeedStd);
+  }
+
+  double rate;
+  double accelerationStd;
+  double angularSpeedStd;
+  std::string filename;
+  romea::core::AngularSpeedBiasPrior prior;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, saveAndLoad)
+{
+  romea::core::saveAngularSpeedBiasPrior(filename, prior);
+  auto loaded = load();
+
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_DOUBLE_EQ(loaded->angularSpeedBiases.angularSpeedAroundXAxis, 0.001);
+  EXPECT_DOUBLE_EQ(loaded->angularSpeedBiases.angularSpeedAroundYAxis, -0.002);
+  EXPECT_DOUBLE_EQ(loaded->angularSpeedBiases.angularSpeedAroundZAxis, 0.003);
+  EXPECT_EQ(loaded->numberOfSamples, 250u);
+  EXPECT_DOUBLE_EQ(loaded->measuredAccelerationStd, 0.0011);
+  EXPECT_DOUBLE_EQ(loaded->measuredAngularSpeedStd, 0.0098);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, rejectMissingFile)
+{
+  EXPECT_FALSE(load().has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, rejectOtherSensor)
+{
+  romea::core::saveAngularSpeedBiasPrior(filename, prior);
+  EXPECT_FALSE(romea::core::loadAngularSpeedBiasPrior(
+      filename, 100., accelerationStd, angularSpeedStd).has_value());
+  EXPECT_FALSE(romea::core::loadAngularSpeedBiasPrior(
+      filename, rate, accelerationStd, 2 * angularSpeedStd).has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, rejectCorruptedFile)
+{
+  romea::core::saveAngularSpeedBiasPrior(filename, prior);
+  {
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(40);
+    file.put(0x7f);
+  }
+  EXPECT_FALSE(load().has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, rejectTruncatedFile)
+{
+  romea::core::saveAngularSpeedBiasPrior(filename, prior);
+  std::string content;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), content.size() - 1);
+  }
+  EXPECT_FALSE(load().has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, warmStart)
+{
+  romea::core::AngularSpeedBias angularSpeedBias(rate, accelerationStd, angularSpeedStd);
+  angularSpeedBias.setPrior(prior);
+
+  std::default_random_engine generator(0);
+  std::normal_distribution<double> accelerationDistribution(0., accelerationStd);
+  std::normal_distribution<double> angularSpeedDistribution(0.003, angularSpeedStd);
+
+  romea::core::AccelerationsFrame accelerations;
+  accelerations.accelerationAlongXAxis = accelerationDistribution(generator);
+  accelerations.accelerationAlongYAxis = accelerationDistribution(generator);
+  accelerations.accelerationAlongZAxis = accelerationDistribution(generator) + 9.81;
+  romea::core::AngularSpeedsFrame angularSpeeds;
+  angularSpeeds.angularSpeedAroundXAxis = angularSpeedDistribution(generator);
+  angularSpeeds.angularSpeedAroundYAxis = angularSpeedDistribution(generator);
+  angularSpeeds.angularSpeedAroundZAxis = angularSpeedDistribution(generator);
+
+  // prior is used before zero velocity has been detected
+  auto bias = angularSpeedBias.evaluate(0., accelerations, angularSpeeds);
+  ASSERT_TRUE(bias.has_value());
+  EXPECT_DOUBLE_EQ(bias.value(), 0.003);
+  EXPECT_EQ(
+    angularSpeedBias.getReport().diagnostics.front().status,
+    romea::core::DiagnosticStatus::OK);
+
+  // a warm started bias is not saved again until it has been estimated
+  EXPECT_FALSE(angularSpeedBias.makePrior().has_value());
+
+  for (size_t n = 0; n < 7 * rate; ++n) {
+    accelerations.accelerationAlongXAxis = accelerationDistribution(generator);
+    accelerations.accelerationAlongYAxis = accelerationDistribution(generator);
+    accelerations.accelerationAlongZAxis = accelerationDistribution(generator) + 9.81;
+    angularSpeeds.angularSpeedAroundXAxis = angularSpeedDistribution(generator);
+    angularSpeeds.angularSpeedAroundYAxis = angularSpeedDistribution(generator);
+    angularSpeeds.angularSpeedAroundZAxis = angularSpeedDistribution(generator);
+    bias = angularSpeedBias.evaluate(0., accelerations, angularSpeeds);
+    ASSERT_TRUE(bias.has_value());
+    EXPECT_NEAR(bias.value(), 0.003, 0.005);
+  }
+
+  auto estimated = angularSpeedBias.makePrior();
+  ASSERT_TRUE(estimated.has_value());
+  EXPECT_EQ(estimated->numberOfSamples, 5 * rate);
+  EXPECT_NEAR(estimated->angularSpeedBiases.angularSpeedAroundZAxis, 0.003, 0.002);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, linearSpeedResetKeepsPrior)
+{
+  romea::core::AccelerationsFrame accelerations;
+  accelerations.accelerationAlongZAxis = 9.81;
+  romea::core::AngularSpeedsFrame angularSpeeds;
+
+  for (auto mode : {romea::core::AngularSpeedBiasEstimation::MOVING_AVERAGE,
+      romea::core::AngularSpeedBiasEstimation::RECURSIVE_FILTER})
+  {
+    romea::core::AngularSpeedBias angularSpeedBias(rate, accelerationStd, angularSpeedStd, mode);
+    angularSpeedBias.setPrior(prior);
+    angularSpeedBias.reset(false);
+
+    auto bias = angularSpeedBias.evaluate(0., accelerations, angularSpeeds);
+    ASSERT_TRUE(bias.has_value());
+    EXPECT_DOUBLE_EQ(bias.value(), 0.003);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, inertialResetDropsPrior)
+{
+  romea::core::AngularSpeedBias angularSpeedBias(rate, accelerationStd, angularSpeedStd);
+  angularSpeedBias.setPrior(prior);
+  angularSpeedBias.reset(true);
+
+  romea::core::AccelerationsFrame accelerations;
+  accelerations.accelerationAlongZAxis = 9.81;
+  romea::core::AngularSpeedsFrame angularSpeeds;
+  EXPECT_FALSE(angularSpeedBias.evaluate(0., accelerations, angularSpeeds).has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasPrior, clearPrior)
+{
+  romea::core::AngularSpeedBias angularSpeedBias(rate, accelerationStd, angularSpeedStd,
+    romea::core::AngularSpeedBiasEstimation::RECURSIVE_FILTER);
+  angularSpeedBias.setPrior(prior);
+
+  romea::core::AccelerationsFrame accelerations;
+  accelerations.accelerationAlongZAxis = 9.81;
+  romea::core::AngularSpeedsFrame angularSpeeds;
+  EXPECT_TRUE(angularSpeedBias.evaluate(0., accelerations, angularSpeeds).has_value());
+
+  angularSpeedBias.clearPrior();
+  EXPECT_FALSE(angularSpeedBias.evaluate(0., accelerations, angularSpeeds).has_value());
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
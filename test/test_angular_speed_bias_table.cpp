@@ -0,0 +1,237 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// romea
+#include "romea_core_localisation_imu/AngularSpeedBias.hpp"
+#include "romea_core_localisation_imu/AngularSpeedBiasTable.hpp"
+
+using romea::core::AngularSpeedBiasTable;
+
+class TestAngularSpeedBiasTable : public ::testing::Test
+{
+public:
+  TestAngularSpeedBiasTable()
+  : rate(50.),
+    accelerationStd(0.001),
+    angularSpeedStd(0.01),
+    filename(::testing::TempDir() + "angular_speed_bias_table.bin"),
+    generator(0),
+    accelerationDistribution(0., accelerationStd),
+    angularSpeedDistribution(0., angularSpeedStd)
+  {
+  }
+
+  void TearDown() override
+  {
+    std::remove(filename.c_str());
+  }
+
+  romea::core::AngularSpeedsFrame makeAngularSpeeds(const double & bias)
+  {
+    return {angularSpeedDistribution(generator),
+      angularSpeedDistribution(generator),
+      bias + angularSpeedDistribution(generator)};
+  }
+
+  romea::core::AccelerationsFrame makeAccelerations()
+  {
+    return {accelerationDistribution(generator),
+      accelerationDistribution(generator),
+      9.81 + accelerationDistribution(generator)};
+  }
+
+  double rate;
+  double accelerationStd;
+  double angularSpeedStd;
+  std::string filename;
+
+  std::default_random_engine generator;
+  std::normal_distribution<double> accelerationDistribution;
+  std::normal_distribution<double> angularSpeedDistribution;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasTable, binsAreConfidentAfterMinimalNumberOfSamples)
+{
+  AngularSpeedBiasTable table(10, 100);
+  for (size_t n = 0; n < 9; ++n) {
+    table.update(20.5, makeAngularSpeeds(0.003));
+  }
+  EXPECT_FALSE(table.lookup(20.5).has_value());
+
+  table.update(20.9, makeAngularSpeeds(0.003));
+  auto bin = table.lookup(20.1);
+  ASSERT_TRUE(bin.has_value());
+  EXPECT_EQ(bin->numberOfSamples, 10u);
+  EXPECT_NEAR(bin->angularSpeedBiases.angularSpeedAroundZAxis, 0.003, 3 * angularSpeedStd);
+
+  // one bin per degree
+  EXPECT_FALSE(table.lookup(19.9).has_value());
+  EXPECT_FALSE(table.lookup(21.).has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasTable, outOfRangeTemperatures)
+{
+  AngularSpeedBiasTable table(1, 100);
+  table.update(std::numeric_limits<double>::quiet_NaN(), makeAngularSpeeds(0.));
+  table.update(AngularSpeedBiasTable::MINIMAL_TEMPERATURE - 0.1, makeAngularSpeeds(0.));
+  table.update(AngularSpeedBiasTable::MAXIMAL_TEMPERATURE, makeAngularSpeeds(0.));
+  for (size_t n = 0; n < AngularSpeedBiasTable::NUMBER_OF_BINS; ++n) {
+    EXPECT_EQ(table.getBin(n).numberOfSamples, 0u);
+  }
+  EXPECT_FALSE(table.lookup(std::numeric_limits<double>::quiet_NaN()).has_value());
+
+  table.update(AngularSpeedBiasTable::MINIMAL_TEMPERATURE, makeAngularSpeeds(0.));
+  table.update(AngularSpeedBiasTable::MAXIMAL_TEMPERATURE - 0.1, makeAngularSpeeds(0.));
+  EXPECT_EQ(table.getBin(0).numberOfSamples, 1u);
+  EXPECT_EQ(table.getBin(AngularSpeedBiasTable::NUMBER_OF_BINS - 1).numberOfSamples, 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasTable, binsFollowAging)
+{
+  AngularSpeedBiasTable table(10, 100);
+  for (size_t n = 0; n < 1000; ++n) {
+    table.update(20., {0., 0., 0.001});
+  }
+  EXPECT_EQ(table.lookup(20.)->numberOfSamples, 100u);
+
+  // exponential average once number of samples is saturated
+  for (size_t n = 0; n < 500; ++n) {
+    table.update(20., {0., 0., 0.002});
+  }
+  EXPECT_NEAR(table.lookup(20.)->angularSpeedBiases.angularSpeedAroundZAxis, 0.002, 1e-5);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasTable, saveAndLoad)
+{
+  AngularSpeedBiasTable table(1, 100);
+  table.update(-12.5, {0.001, -0.002, 0.003});
+  table.update(45., {0.004, 0.005, -0.006});
+  romea::core::saveAngularSpeedBiasTable(filename, rate, accelerationStd, angularSpeedStd, table);
+
+  AngularSpeedBiasTable loaded(1, 100);
+  ASSERT_TRUE(romea::core::loadAngularSpeedBiasTable(
+      filename, rate, accelerationStd, angularSpeedStd, loaded));
+  for (size_t n = 0; n < AngularSpeedBiasTable::NUMBER_OF_BINS; ++n) {
+    EXPECT_EQ(loaded.getBin(n).numberOfSamples, table.getBin(n).numberOfSamples);
+  }
+  EXPECT_DOUBLE_EQ(loaded.lookup(-12.9)->angularSpeedBiases.angularSpeedAroundYAxis, -0.002);
+  EXPECT_DOUBLE_EQ(loaded.lookup(45.)->angularSpeedBiases.angularSpeedAroundZAxis, -0.006);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasTable, failedSaveKeepsPreviousFile)
+{
+  AngularSpeedBiasTable table(1, 100);
+  table.update(20., {0.001, -0.002, 0.003});
+  romea::core::saveAngularSpeedBiasTable(filename, rate, accelerationStd, angularSpeedStd, table);
+  EXPECT_FALSE(std::filesystem::exists(filename + ".tmp"));
+
+  // temporary file cannot be created, previous file must be left untouched
+  std::filesystem::create_directory(filename + ".tmp");
+  table.update(20., {0.1, 0.1, 0.1});
+  EXPECT_THROW(
+    romea::core::saveAngularSpeedBiasTable(
+      filename, rate, accelerationStd, angularSpeedStd, table),
+    std::runtime_error);
+  std::filesystem::remove(filename + ".tmp");
+
+  AngularSpeedBiasTable loaded(1, 100);
+  ASSERT_TRUE(romea::core::loadAngularSpeedBiasTable(
+      filename, rate, accelerationStd, angularSpeedStd, loaded));
+  ASSERT_TRUE(loaded.lookup(20.).has_value());
+  EXPECT_EQ(loaded.lookup(20.)->numberOfSamples, 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasTable, rejectInvalidFiles)
+{
+  AngularSpeedBiasTable table(1, 100);
+  EXPECT_FALSE(romea::core::loadAngularSpeedBiasTable(
+      filename, rate, accelerationStd, angularSpeedStd, table));
+
+  table.update(20., {0.001, 0.002, 0.003});
+  romea::core::saveAngularSpeedBiasTable(filename, rate, accelerationStd, angularSpeedStd, table);
+  EXPECT_FALSE(romea::core::loadAngularSpeedBiasTable(
+      filename, 100., accelerationStd, angularSpeedStd, table));
+
+  {
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(100);
+    file.put(0x7f);
+  }
+  AngularSpeedBiasTable loaded(1, 100);
+  EXPECT_FALSE(romea::core::loadAngularSpeedBiasTable(
+      filename, rate, accelerationStd, angularSpeedStd, loaded));
+  EXPECT_FALSE(loaded.lookup(20.).has_value());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestAngularSpeedBiasTable, instantBiasAtKnownTemperature)
+{
+  romea::core::AngularSpeedBias angularSpeedBias(rate, accelerationStd, angularSpeedStd);
+  angularSpeedBias.setTemperature(25.3);
+  for (size_t n = 0; n < 10 * rate; ++n) {
+    angularSpeedBias.evaluate(0., makeAccelerations(), makeAngularSpeeds(0.02));
+  }
+
+  // bias is instantly available again after a reset at a known temperature
+  angularSpeedBias.reset(false);
+  auto bias = angularSpeedBias.evaluate(1., makeAccelerations(), makeAngularSpeeds(0.));
+  ASSERT_TRUE(bias.has_value());
+  EXPECT_NEAR(*bias, 0.02, 0.003);
+  EXPECT_DOUBLE_EQ(std::stod(angularSpeedBias.getReport().info["temperature"]), 25.3);
+
+  angularSpeedBias.reset(false);
+  angularSpeedBias.setTemperature(31.);
+  EXPECT_FALSE(
+    angularSpeedBias.evaluate(1., makeAccelerations(), makeAngularSpeeds(0.)).has_value());
+
+  // table survives restarts
+  romea::core::saveAngularSpeedBiasTable(filename, rate, accelerationStd, angularSpeedStd,
+    angularSpeedBias.getTemperatureTable());
+  romea::core::AngularSpeedBias restarted(rate, accelerationStd, angularSpeedStd,
+    romea::core::AngularSpeedBiasEstimation::RECURSIVE_FILTER);
+  ASSERT_TRUE(romea::core::loadAngularSpeedBiasTable(
+      filename, rate, accelerationStd, angularSpeedStd, restarted.getTemperatureTable()));
+  restarted.setTemperature(25.9);
+  bias = restarted.evaluate(1., makeAccelerations(), makeAngularSpeeds(0.));
+  ASSERT_TRUE(bias.has_value());
+  EXPECT_NEAR(*bias, 0.02, 0.003);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
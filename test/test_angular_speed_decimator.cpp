@@ -0,0 +1,172 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <string>
+
+// romea
+#include "romea_core_localisation_imu/AngularSpeedDecimator.hpp"
+
+using romea::core::AngularSpeedDecimator;
+using romea::core::durationFromSecond;
+
+namespace
+{
+const double RATE = 100.;
+const double NOISE_VARIANCE = 1.e-6;
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedDecimator, averageOverNumberOfSamples)
+{
+  AngularSpeedDecimator decimator(RATE, 4, romea::core::Duration::max());
+
+  for (size_t n = 1; n <= 8; ++n) {
+    bool isComplete = decimator.add(durationFromSecond(n / RATE), n, NOISE_VARIANCE, 1.e-8);
+    EXPECT_EQ(isComplete, n % 4 == 0);
+    if (n == 4) {
+      EXPECT_DOUBLE_EQ(decimator.getAngularSpeed(), 2.5);
+    }
+  }
+
+  // white noise is averaged, bias error is not
+  EXPECT_DOUBLE_EQ(decimator.getAngularSpeed(), 6.5);
+  EXPECT_NEAR(decimator.getAngularSpeedVariance(), NOISE_VARIANCE / 4 + 1.e-8, 1e-18);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedDecimator, averageOverWindowDuration)
+{
+  AngularSpeedDecimator decimator(RATE, 1000, durationFromSecond(0.05));
+
+  // first window starts one period before first sample
+  size_t numberOfObservations = 0;
+  for (size_t n = 1; n <= 20; ++n) {
+    if (decimator.add(durationFromSecond(n / RATE), 1., NOISE_VARIANCE, 0.)) {
+      EXPECT_EQ(n % 5, 0u);
+      ++numberOfObservations;
+    }
+  }
+  EXPECT_EQ(numberOfObservations, 4u);
+  EXPECT_NEAR(decimator.getAngularSpeedVariance(), NOISE_VARIANCE / 5, 1e-18);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedDecimator, rejectedSamplesAreLeftOutOfAverages)
+{
+  AngularSpeedDecimator decimator(RATE, 1000, durationFromSecond(0.05));
+
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.01), 1., NOISE_VARIANCE, 0.));
+  decimator.reject();
+  decimator.reject();
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.04), 3., NOISE_VARIANCE, 0.));
+  decimator.reject();
+  EXPECT_TRUE(decimator.add(durationFromSecond(0.06), 5., NOISE_VARIANCE, 0.));
+
+  // window is shortened by missing samples, average and variance only use accepted ones
+  EXPECT_DOUBLE_EQ(decimator.getAngularSpeed(), 3.);
+  EXPECT_NEAR(decimator.getAngularSpeedVariance(), NOISE_VARIANCE / 3, 1e-18);
+
+  romea::core::DiagnosticReport report = decimator.getReport();
+  EXPECT_EQ(report.info["decimated_observations"], "1");
+  EXPECT_EQ(report.info["decimation_averaged_samples"], "3");
+  EXPECT_EQ(report.info["decimation_rejected_samples"], "3");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedDecimator, staleGroupIsDroppedAfterGap)
+{
+  AngularSpeedDecimator decimator(RATE, 1000, durationFromSecond(0.05));
+
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.01), 10., NOISE_VARIANCE, 0.));
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.02), 10., NOISE_VARIANCE, 0.));
+
+  // samples received before gap are not mixed with following ones
+  for (size_t n = 100; n < 104; ++n) {
+    EXPECT_FALSE(decimator.add(durationFromSecond(n / RATE), 1., NOISE_VARIANCE, 0.));
+  }
+  EXPECT_TRUE(decimator.add(durationFromSecond(1.04), 1., NOISE_VARIANCE, 0.));
+  EXPECT_DOUBLE_EQ(decimator.getAngularSpeed(), 1.);
+
+  romea::core::DiagnosticReport report = decimator.getReport();
+  EXPECT_EQ(report.info["decimation_averaged_samples"], "5");
+  EXPECT_EQ(report.info["decimation_rejected_samples"], "2");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedDecimator, partialGroupIsDroppedAfterGapWithDefaultWindow)
+{
+  AngularSpeedDecimator decimator(RATE, 4, romea::core::Duration::max());
+
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.01), 10., NOISE_VARIANCE, 0.));
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.02), 10., NOISE_VARIANCE, 0.));
+
+  for (size_t n = 10; n < 13; ++n) {
+    EXPECT_FALSE(decimator.add(durationFromSecond(n / RATE), 1., NOISE_VARIANCE, 0.));
+  }
+  EXPECT_TRUE(decimator.add(durationFromSecond(0.13), 1., NOISE_VARIANCE, 0.));
+  EXPECT_DOUBLE_EQ(decimator.getAngularSpeed(), 1.);
+
+  romea::core::DiagnosticReport report = decimator.getReport();
+  EXPECT_EQ(report.info["decimation_averaged_samples"], "4");
+  EXPECT_EQ(report.info["decimation_rejected_samples"], "2");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedDecimator, partialGroupIsDroppedAfterRejectionRun)
+{
+  AngularSpeedDecimator decimator(RATE, 4, romea::core::Duration::max());
+
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.01), 10., NOISE_VARIANCE, 0.));
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.02), 10., NOISE_VARIANCE, 0.));
+
+  // a few isolated rejections keep the group
+  decimator.reject();
+  EXPECT_FALSE(decimator.add(durationFromSecond(0.04), 10., NOISE_VARIANCE, 0.));
+  EXPECT_EQ(decimator.getReport().info["decimation_rejected_samples"], "1");
+
+  for (size_t n = 0; n < 4; ++n) {
+    decimator.reject();
+  }
+  EXPECT_EQ(decimator.getReport().info["decimation_rejected_samples"], "8");
+
+  for (size_t n = 9; n < 12; ++n) {
+    EXPECT_FALSE(decimator.add(durationFromSecond(n / RATE), 1., NOISE_VARIANCE, 0.));
+  }
+  EXPECT_TRUE(decimator.add(durationFromSecond(0.12), 1., NOISE_VARIANCE, 0.));
+  EXPECT_DOUBLE_EQ(decimator.getAngularSpeed(), 1.);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedDecimator, reportVersion)
+{
+  AngularSpeedDecimator decimator(RATE, 2, romea::core::Duration::max());
+  uint32_t version = decimator.getReportVersion();
+
+  decimator.add(durationFromSecond(0.01), 1., NOISE_VARIANCE, 0.);
+  EXPECT_EQ(decimator.getReportVersion(), version);
+
+  decimator.add(durationFromSecond(0.02), 1., NOISE_VARIANCE, 0.);
+  EXPECT_NE(decimator.getReportVersion(), version);
+  version = decimator.getReportVersion();
+
+  decimator.reject();
+  EXPECT_NE(decimator.getReportVersion(), version);
+}
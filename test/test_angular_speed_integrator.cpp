@@ -0,0 +1,235 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <thread>
+
+// romea
+#include "romea_core_localisation_imu/AngularSpeedIntegrator.hpp"
+
+using romea::core::AngularSpeedIntegrator;
+using romea::core::DeltaAngles;
+using romea::core::durationFromSecond;
+using romea::core::durationToSecond;
+
+namespace
+{
+const double RATE = 100.;
+const double ANGULAR_SPEED_VARIANCE = 1.e-6;
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedIntegrator, nothingToPopBeforeFirstSample)
+{
+  AngularSpeedIntegrator integrator(RATE, ANGULAR_SPEED_VARIANCE);
+  DeltaAngles deltaAngles;
+  EXPECT_FALSE(integrator.pop(deltaAngles));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedIntegrator, constantAngularSpeeds)
+{
+  AngularSpeedIntegrator integrator(RATE, ANGULAR_SPEED_VARIANCE);
+  for (size_t n = 1; n <= RATE; ++n) {
+    integrator.integrate(durationFromSecond(n / RATE), {0.1, 0.2, 0.3}, 0.);
+  }
+
+  // first sample is held over one sampling period
+  DeltaAngles deltaAngles;
+  ASSERT_TRUE(integrator.pop(deltaAngles));
+  EXPECT_EQ(deltaAngles.numberOfSamples, 100u);
+  EXPECT_NEAR(deltaAngles.duration, 1., 1e-9);
+  EXPECT_NEAR(durationToSecond(deltaAngles.startStamp), 0., 1e-9);
+  EXPECT_NEAR(durationToSecond(deltaAngles.stopStamp), 1., 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(0), 0.1, 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(1), 0.2, 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(2), 0.3, 1e-9);
+  EXPECT_FALSE(integrator.pop(deltaAngles));
+
+  // next window starts at last sample of previous one
+  for (size_t n = RATE + 1; n <= 1.5 * RATE; ++n) {
+    integrator.integrate(durationFromSecond(n / RATE), {0., 0., -0.2}, 0.);
+  }
+  ASSERT_TRUE(integrator.pop(deltaAngles));
+  EXPECT_EQ(deltaAngles.numberOfSamples, 50u);
+  EXPECT_NEAR(deltaAngles.duration, 0.5, 1e-9);
+  EXPECT_NEAR(durationToSecond(deltaAngles.startStamp), 1., 1e-9);
+  EXPECT_NEAR(durationToSecond(deltaAngles.stopStamp), 1.5, 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(0), 0., 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(2), -0.1, 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedIntegrator, covariance)
+{
+  const double angularSpeedBiasVariance = 1.e-8;
+  AngularSpeedIntegrator integrator(RATE, ANGULAR_SPEED_VARIANCE);
+  for (size_t n = 1; n <= 2 * RATE; ++n) {
+    integrator.integrate(durationFromSecond(n / RATE), {0., 0., 0.}, angularSpeedBiasVariance);
+  }
+
+  // white noise integrated over each sample plus bias error shared by whole window
+  DeltaAngles deltaAngles;
+  ASSERT_TRUE(integrator.pop(deltaAngles));
+  const double expectedVariance = ANGULAR_SPEED_VARIANCE * 2. / RATE +
+    angularSpeedBiasVariance * 4.;
+  EXPECT_NEAR(deltaAngles.R(0, 0), expectedVariance, 1e-15);
+  EXPECT_NEAR(deltaAngles.R(1, 1), expectedVariance, 1e-15);
+  EXPECT_NEAR(deltaAngles.R(2, 2), expectedVariance, 1e-15);
+  EXPECT_DOUBLE_EQ(deltaAngles.R(0, 2), 0.);
+
+  // bias error of shorter windows is smaller
+  for (size_t n = 2 * RATE + 1; n <= 2.5 * RATE; ++n) {
+    integrator.integrate(durationFromSecond(n / RATE), {0., 0., 0.}, angularSpeedBiasVariance);
+  }
+  ASSERT_TRUE(integrator.pop(deltaAngles));
+  EXPECT_NEAR(
+    deltaAngles.R(2, 2),
+    ANGULAR_SPEED_VARIANCE * 0.5 / RATE + angularSpeedBiasVariance * 0.25,
+    1e-15);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedIntegrator, gapsAreHeldOverOneSamplingPeriod)
+{
+  AngularSpeedIntegrator integrator(RATE, ANGULAR_SPEED_VARIANCE);
+  integrator.integrate(durationFromSecond(0.01), {0., 0., 1.}, 0.);
+  integrator.integrate(durationFromSecond(0.02), {0., 0., 1.}, 0.);
+  integrator.integrate(durationFromSecond(1.02), {0., 0., 1.}, 0.);
+
+  DeltaAngles deltaAngles;
+  ASSERT_TRUE(integrator.pop(deltaAngles));
+  EXPECT_EQ(deltaAngles.numberOfSamples, 3u);
+  EXPECT_NEAR(deltaAngles.duration, 0.03, 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(2), 0.03, 1e-9);
+  EXPECT_NEAR(durationToSecond(deltaAngles.stopStamp), 1.02, 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedIntegrator, irregularSamplesCoverIntervalSincePreviousOne)
+{
+  AngularSpeedIntegrator integrator(RATE, ANGULAR_SPEED_VARIANCE);
+  integrator.integrate(durationFromSecond(0.01), {0., 0., 1.}, 0.);
+  integrator.integrate(durationFromSecond(0.025), {0., 0., 2.}, 0.);
+  integrator.integrate(durationFromSecond(0.03), {0., 0., 4.}, 0.);
+
+  // late and duplicated samples are ignored
+  integrator.integrate(durationFromSecond(0.03), {0., 0., 8.}, 0.);
+  integrator.integrate(durationFromSecond(0.02), {0., 0., 8.}, 0.);
+
+  DeltaAngles deltaAngles;
+  ASSERT_TRUE(integrator.pop(deltaAngles));
+  EXPECT_EQ(deltaAngles.numberOfSamples, 3u);
+  EXPECT_NEAR(deltaAngles.duration, 0.03, 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(2), 0.01 + 0.015 * 2. + 0.005 * 4., 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedIntegrator, popAtStampSplitsStraddlingSample)
+{
+  AngularSpeedIntegrator integrator(RATE, ANGULAR_SPEED_VARIANCE);
+  for (size_t n = 1; n <= 5; ++n) {
+    integrator.integrate(durationFromSecond(n / RATE), {0., 0., double(n)}, 0.);
+  }
+
+  // third sample is held from 0.02 to 0.03, half of it is popped
+  DeltaAngles deltaAngles;
+  ASSERT_TRUE(integrator.pop(durationFromSecond(0.025), deltaAngles));
+  EXPECT_EQ(deltaAngles.numberOfSamples, 2u);
+  EXPECT_NEAR(durationToSecond(deltaAngles.startStamp), 0., 1e-9);
+  EXPECT_NEAR(durationToSecond(deltaAngles.stopStamp), 0.025, 1e-9);
+  EXPECT_NEAR(deltaAngles.duration, 0.025, 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(2), 0.01 + 0.02 + 0.005 * 3, 1e-9);
+  const double firstVariance = deltaAngles.R(2, 2);
+
+  // nothing before previous pop nor after last sample
+  EXPECT_FALSE(integrator.pop(durationFromSecond(0.02), deltaAngles));
+  EXPECT_FALSE(integrator.pop(durationFromSecond(0.06), deltaAngles));
+
+  ASSERT_TRUE(integrator.pop(deltaAngles));
+  EXPECT_EQ(deltaAngles.numberOfSamples, 3u);
+  EXPECT_NEAR(durationToSecond(deltaAngles.startStamp), 0.025, 1e-9);
+  EXPECT_NEAR(durationToSecond(deltaAngles.stopStamp), 0.05, 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(2), 0.005 * 3 + 0.04 + 0.05, 1e-9);
+  EXPECT_NEAR(
+    firstVariance + deltaAngles.R(2, 2), 5 * ANGULAR_SPEED_VARIANCE / (RATE * RATE), 1e-18);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedIntegrator, popAtStampOlderThanHistory)
+{
+  AngularSpeedIntegrator integrator(RATE, ANGULAR_SPEED_VARIANCE);
+  for (size_t n = 1; n <= 3 * RATE; ++n) {
+    integrator.integrate(durationFromSecond(n / RATE), {0., 0., 1.}, 0.);
+  }
+
+  // only last second is kept, delta angles stop before its first sample
+  DeltaAngles deltaAngles;
+  ASSERT_TRUE(integrator.pop(durationFromSecond(0.5), deltaAngles));
+  EXPECT_EQ(deltaAngles.numberOfSamples, 2 * RATE);
+  EXPECT_NEAR(durationToSecond(deltaAngles.stopStamp), 2., 1e-9);
+  EXPECT_NEAR(deltaAngles.Y(2), 2., 1e-9);
+
+  ASSERT_TRUE(integrator.pop(durationFromSecond(2.505), deltaAngles));
+  EXPECT_EQ(deltaAngles.numberOfSamples, 50u);
+  EXPECT_NEAR(deltaAngles.Y(2), 0.505, 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAngularSpeedIntegrator, popFromAnotherThreadLosesNoSample)
+{
+  const size_t numberOfSamples = 100000;
+  AngularSpeedIntegrator integrator(RATE, ANGULAR_SPEED_VARIANCE);
+
+  std::atomic<bool> isIntegrating(true);
+  std::thread integratingThread([&]() {
+      for (size_t n = 1; n <= numberOfSamples; ++n) {
+        integrator.integrate(durationFromSecond(n / RATE), {0., 0., 1.}, 0.);
+      }
+      isIntegrating = false;
+    });
+
+  // delta angles are popped either up to last sample or at chosen instants
+  uint64_t totalNumberOfSamples = 0;
+  double totalAngle = 0.;
+  double popStamp = 0.;
+  bool isPoppedAtStamp = false;
+  DeltaAngles deltaAngles;
+  while (isIntegrating) {
+    const bool isPopped = isPoppedAtStamp ?
+      integrator.pop(durationFromSecond(popStamp + 0.0137), deltaAngles) :
+      integrator.pop(deltaAngles);
+    if (isPopped) {
+      totalNumberOfSamples += deltaAngles.numberOfSamples;
+      totalAngle += deltaAngles.Y(2);
+      popStamp = durationToSecond(deltaAngles.stopStamp);
+      isPoppedAtStamp = !isPoppedAtStamp;
+    }
+  }
+  integratingThread.join();
+  while (integrator.pop(deltaAngles)) {
+    totalNumberOfSamples += deltaAngles.numberOfSamples;
+    totalAngle += deltaAngles.Y(2);
+  }
+
+  EXPECT_EQ(totalNumberOfSamples, numberOfSamples);
+  EXPECT_NEAR(totalAngle, numberOfSamples / RATE, 1e-6);
+}
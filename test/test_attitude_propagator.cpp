@@ -0,0 +1,185 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cmath>
+
+// romea
+#include "romea_core_localisation_imu/AttitudePropagator.hpp"
+
+using romea::core::AttitudePropagator;
+using romea::core::durationFromSecond;
+
+namespace
+{
+const double RATE = 100.;
+const double ANGLE_VARIANCE = 1.e-4;
+const double ANGULAR_SPEED_VARIANCE = 1.e-6;
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, noPropagationBeforeAttitudeFrame)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  EXPECT_FALSE(propagator.propagate(durationFromSecond(0.01), {0., 0., 0.}, 0.));
+  EXPECT_FALSE(propagator.isAvailable());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, constantRollRate)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(0.), 0.1, 0.2);
+
+  for (size_t n = 1; n <= RATE; ++n) {
+    EXPECT_TRUE(propagator.propagate(durationFromSecond(n / RATE), {0.5, 0., 0.}, 0.));
+  }
+
+  EXPECT_TRUE(propagator.isAvailable());
+  EXPECT_NEAR(propagator.getPropagationDuration(), 1., 1e-9);
+  EXPECT_NEAR(propagator.getRollAngle(), 0.6, 1e-9);
+  EXPECT_NEAR(propagator.getPitchAngle(), 0.2, 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, constantPitchRate)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(0.), 0., -0.1);
+
+  for (size_t n = 1; n <= 2 * RATE; ++n) {
+    EXPECT_TRUE(propagator.propagate(durationFromSecond(n / RATE), {0., 0.2, 0.}, 0.));
+  }
+
+  EXPECT_NEAR(propagator.getRollAngle(), 0., 1e-6);
+  EXPECT_NEAR(propagator.getPitchAngle(), 0.3, 1e-6);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, yawRateDoesNotChangeLevelAttitude)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(0.), 0., 0.);
+
+  for (size_t n = 1; n <= RATE; ++n) {
+    propagator.propagate(durationFromSecond(n / RATE), {0., 0., 1.}, 0.);
+  }
+
+  EXPECT_NEAR(propagator.getRollAngle(), 0., 1e-9);
+  EXPECT_NEAR(propagator.getPitchAngle(), 0., 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, restartOnAttitudeFrame)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(0.), 0., 0.);
+  for (size_t n = 1; n <= 50; ++n) {
+    propagator.propagate(durationFromSecond(n / RATE), {0.5, 0., 0.}, 0.);
+  }
+  EXPECT_NEAR(propagator.getRollAngle(), 0.25, 1e-6);
+
+  // attitude frame stamped between samples, propagation restarts from it
+  propagator.setAttitude(durationFromSecond(0.505), 0.3, 0.);
+  EXPECT_TRUE(propagator.propagate(durationFromSecond(0.51), {0.5, 0., 0.}, 0.));
+  EXPECT_NEAR(propagator.getRollAngle(), 0.3 + 0.5 * 0.005, 1e-6);
+  EXPECT_NEAR(propagator.getPropagationDuration(), 0.005, 1e-9);
+  EXPECT_NEAR(propagator.getAngleVariance(), ANGLE_VARIANCE, 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, samplesOlderThanAttitudeFrameAreIgnored)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(1.), 0.1, 0.);
+
+  EXPECT_FALSE(propagator.propagate(durationFromSecond(0.99), {0.5, 0., 0.}, 0.));
+  EXPECT_FALSE(propagator.propagate(durationFromSecond(1.), {0.5, 0., 0.}, 0.));
+  EXPECT_FALSE(propagator.isAvailable());
+
+  EXPECT_TRUE(propagator.propagate(durationFromSecond(1.01), {0.5, 0., 0.}, 0.));
+  EXPECT_NEAR(propagator.getRollAngle(), 0.105, 1e-6);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, gapStopsPropagationUntilNextAttitudeFrame)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(0.), 0., 0.);
+  EXPECT_TRUE(propagator.propagate(durationFromSecond(0.01), {0., 0., 0.}, 0.));
+
+  EXPECT_FALSE(propagator.propagate(durationFromSecond(0.5), {0., 0., 0.}, 0.));
+  EXPECT_FALSE(propagator.propagate(durationFromSecond(0.51), {0., 0., 0.}, 0.));
+
+  propagator.setAttitude(durationFromSecond(0.515), 0., 0.);
+  EXPECT_TRUE(propagator.propagate(durationFromSecond(0.52), {0., 0., 0.}, 0.));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, interruptStopsPropagationUntilNextAttitudeFrame)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(0.), 0., 0.);
+  EXPECT_TRUE(propagator.propagate(durationFromSecond(0.01), {0., 0., 0.}, 0.));
+
+  propagator.interrupt();
+  EXPECT_FALSE(propagator.isAvailable());
+  EXPECT_FALSE(propagator.propagate(durationFromSecond(0.02), {0., 0., 0.}, 0.));
+
+  propagator.setAttitude(durationFromSecond(0.025), 0., 0.);
+  EXPECT_TRUE(propagator.propagate(durationFromSecond(0.03), {0., 0., 0.}, 0.));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, propagationDurationIsBounded)
+{
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(0.), 0., 0.);
+
+  size_t numberOfPropagations = 0;
+  for (size_t n = 1; n <= 10 * RATE; ++n) {
+    numberOfPropagations += propagator.propagate(
+      durationFromSecond(n / RATE), {0., 0., 0.}, 0.);
+  }
+  EXPECT_EQ(numberOfPropagations, 5 * RATE);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestAttitudePropagator, angleVarianceGrowth)
+{
+  const double angularSpeedBiasVariance = 1.e-8;
+  AttitudePropagator propagator(RATE, ANGLE_VARIANCE, ANGULAR_SPEED_VARIANCE);
+  propagator.setAttitude(durationFromSecond(0.), 0., 0.);
+
+  double previousAngleVariance = ANGLE_VARIANCE;
+  for (size_t n = 1; n <= 2 * RATE; ++n) {
+    propagator.propagate(durationFromSecond(n / RATE), {0., 0., 0.}, angularSpeedBiasVariance);
+    EXPECT_GT(propagator.getAngleVariance(), previousAngleVariance);
+    previousAngleVariance = propagator.getAngleVariance();
+  }
+
+  // white noise integrated over each step plus bias error growing with duration
+  const double duration = 2.;
+  EXPECT_NEAR(
+    propagator.getAngleVariance(),
+    ANGLE_VARIANCE + ANGULAR_SPEED_VARIANCE * duration / RATE +
+    angularSpeedBiasVariance * duration * duration,
+    1e-12);
+}
@@ -88,6 +88,18 @@ TEST_F(TestAttitudeDiagnostic, withUnavailablePitchAngle)
   EXPECT_STREQ(diagnostic.getReport().info.at("pitch").c_str(), "-1.903");
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestAttitudeDiagnostic, reportIsEmptyAfterReset)
+{
+  frame.rollAngle = 0.05;
+  frame.pitchAngle = 0.1;
+  diagnostic.evaluate(frame);
+  diagnostic.reset();
+  EXPECT_TRUE(diagnostic.getReport().diagnostics.empty());
+  EXPECT_STREQ(diagnostic.getReport().info.at("roll").c_str(), "");
+  EXPECT_STREQ(diagnostic.getReport().info.at("pitch").c_str(), "");
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
@@ -75,6 +75,34 @@ TEST_F(TestInertialMeasurementsDiagnostic, checkAngularSpeedFrameOutOfRange)
     "Angular speed data is out of range.");
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestInertialMeasurementsDiagnostic, batchReportKeepsWorstStatuses)
+{
+  romea::core::AccelerationsFrame batchAccelerations[3] = {accelerations, accelerations,
+    accelerations};
+  romea::core::AngularSpeedsFrame batchAngularSpeeds[3] = {angularSpeeds, angularSpeeds,
+    angularSpeeds};
+  batchAccelerations[1].accelerationAlongXAxis = 12;
+  batchAngularSpeeds[2].angularSpeedAroundYAxis = 2 * 360 / 180. * M_PI;
+
+  romea::core::DiagnosticStatus statuses[3];
+  diagnostic.evaluate(batchAccelerations, batchAngularSpeeds, 3, statuses);
+  EXPECT_EQ(statuses[0], romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(statuses[1], romea::core::DiagnosticStatus::ERROR);
+  EXPECT_EQ(statuses[2], romea::core::DiagnosticStatus::ERROR);
+
+  // out of range samples in the middle of a batch are reported
+  romea::core::DiagnosticReport report = diagnostic.getReport();
+  EXPECT_STREQ(report.diagnostics.front().message.c_str(), "Acceleration data is out of range.");
+  EXPECT_STREQ(report.diagnostics.back().message.c_str(), "Angular speed data is out of range.");
+  EXPECT_STREQ(report.info.at("acceleration_x").c_str(), "12");
+
+  diagnostic.evaluate(batchAccelerations, batchAngularSpeeds, 1, statuses);
+  EXPECT_STREQ(
+    diagnostic.getReport().diagnostics.front().message.c_str(),
+    "Acceleration data is OK.");
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
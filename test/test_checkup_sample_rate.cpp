@@ -0,0 +1,150 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <vector>
+
+// romea
+#include <romea_core_common/diagnostic/CheckupRate.hpp>
+#include "romea_core_localisation_imu/CheckupSampleRate.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+void expectSameReports(
+  const romea::core::DiagnosticReport & report,
+  const romea::core::DiagnosticReport & expectedReport)
+{
+  ASSERT_EQ(report.diagnostics.size(), expectedReport.diagnostics.size());
+  auto expectedDiagnostic = expectedReport.diagnostics.begin();
+  for (const auto & diagnostic : report.diagnostics) {
+    EXPECT_EQ(diagnostic.status, expectedDiagnostic->status);
+    EXPECT_EQ(diagnostic.message, expectedDiagnostic->message);
+    ++expectedDiagnostic;
+  }
+  EXPECT_EQ(report.info, expectedReport.info);
+}
+
+}  // namespace
+
+class TestCheckupSampleRate : public ::testing::Test
+{
+public:
+  TestCheckupSampleRate()
+  : diagnostic("imu", 10., 1.)
+  {
+  }
+
+  romea::core::DiagnosticStatus evaluate(const double & stamp)
+  {
+    return diagnostic.evaluate(romea::core::durationFromSecond(stamp));
+  }
+
+  romea::core::CheckupSampleRate diagnostic;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCheckupSampleRate, errorUntilWindowIsFull)
+{
+  for (size_t n = 0; n < 20; ++n) {
+    EXPECT_EQ(evaluate(n / 10.), romea::core::DiagnosticStatus::ERROR);
+  }
+  EXPECT_STREQ(
+    diagnostic.getReport().diagnostics.front().message.c_str(), "imu rate is not available.");
+  EXPECT_STREQ(diagnostic.getReport().info.at("imu_rate").c_str(), "");
+
+  EXPECT_EQ(evaluate(2.0), romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(diagnostic.getReport().diagnostics.front().status, romea::core::DiagnosticStatus::OK);
+  EXPECT_STREQ(diagnostic.getReport().diagnostics.front().message.c_str(), "imu rate is OK.");
+  EXPECT_STREQ(diagnostic.getReport().info.at("imu_rate").c_str(), "10");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCheckupSampleRate, rateTooLow)
+{
+  for (size_t n = 0; n < 21; ++n) {
+    evaluate(n / 5.);
+  }
+  EXPECT_EQ(
+    diagnostic.getReport().diagnostics.front().status, romea::core::DiagnosticStatus::ERROR);
+  EXPECT_STREQ(diagnostic.getReport().diagnostics.front().message.c_str(), "imu rate is too low.");
+  EXPECT_STREQ(diagnostic.getReport().info.at("imu_rate").c_str(), "5");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCheckupSampleRate, heartBeat)
+{
+  EXPECT_FALSE(diagnostic.heartBeatCallback(romea::core::durationFromSecond(0.)));
+
+  for (size_t n = 0; n < 21; ++n) {
+    evaluate(n / 10.);
+  }
+  EXPECT_TRUE(diagnostic.heartBeatCallback(romea::core::durationFromSecond(2.5)));
+  EXPECT_FALSE(diagnostic.heartBeatCallback(romea::core::durationFromSecond(3.5)));
+  EXPECT_EQ(
+    diagnostic.getReport().diagnostics.front().status, romea::core::DiagnosticStatus::ERROR);
+
+  // window is cleared after a timeout
+  EXPECT_EQ(evaluate(4.), romea::core::DiagnosticStatus::ERROR);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestCheckupSampleRate, sameDiagnosticsAsCheckupGreaterThanRate)
+{
+  // consumers of plugin reports rely on messages and info keys of romea_core_common checkup
+  romea::core::CheckupGreaterThanRate expectedDiagnostic("imu", 10., 1.);
+  expectSameReports(diagnostic.getReport(), expectedDiagnostic.getReport());
+
+  // nominal rate, too low rate, silence shorter then longer than heartbeat timeout, restart
+  std::vector<double> stamps;
+  for (size_t n = 0; n < 30; ++n) {
+    stamps.push_back(n / 10.);
+  }
+  for (size_t n = 1; n < 15; ++n) {
+    stamps.push_back(2.9 + n / 5.);
+  }
+  stamps.push_back(6.5);
+  for (size_t n = 0; n < 30; ++n) {
+    stamps.push_back(8. + n / 10.);
+  }
+
+  for (size_t n = 0; n < stamps.size(); ++n) {
+    romea::core::Duration stamp = romea::core::durationFromSecond(stamps[n]);
+    EXPECT_EQ(diagnostic.evaluate(stamp), expectedDiagnostic.evaluate(stamp));
+    expectSameReports(diagnostic.getReport(), expectedDiagnostic.getReport());
+
+    // heartbeats at half, full and one and a half timeout after some samples
+    for (double delay : {0.5, 1.0, 1.5}) {
+      if (n + 1 < stamps.size() && stamps[n + 1] > stamps[n] + delay) {
+        romea::core::Duration heartBeatStamp = romea::core::durationFromSecond(stamps[n] + delay);
+        EXPECT_EQ(
+          diagnostic.heartBeatCallback(heartBeatStamp),
+          expectedDiagnostic.heartBeatCallback(heartBeatStamp));
+        expectSameReports(diagnostic.getReport(), expectedDiagnostic.getReport());
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
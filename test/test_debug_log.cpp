@@ -0,0 +1,214 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <sys/resource.h>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/DebugLog.hpp"
+#include "romea_core_localisation_imu/DebugLogReader.hpp"
+
+class TestDebugLog : public ::testing::Test
+{
+public:
+  TestDebugLog()
+  : filename(::testing::TempDir() + "debug_log.bin")
+  {
+  }
+
+  void TearDown() override
+  {
+    std::remove(filename.c_str());
+  }
+
+  std::vector<romea::core::DebugLogRecord> read()
+  {
+    romea::core::DebugLogReader reader(filename);
+    std::vector<romea::core::DebugLogRecord> records;
+    romea::core::DebugLogRecord record;
+    while (reader.read(record)) {
+      records.push_back(record);
+    }
+    return records;
+  }
+
+  std::string filename;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDebugLog, recordsAreWrittenInOrder)
+{
+  {
+    romea::core::DebugLog log(filename);
+    for (size_t n = 0; n < 1000; ++n) {
+      EXPECT_TRUE(
+        log.log(
+          romea::core::DebugLogRecord::INERTIAL_MEASUREMENTS, 0,
+          romea::core::Duration(n), n, 1., 2., 3., 4., 5.));
+      if (n % 100 == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+    log.log(romea::core::DebugLogRecord::LINEAR_SPEED, 0, romea::core::Duration(1000), 0.5);
+  }
+
+  auto records = read();
+  ASSERT_EQ(records.size(), 1001u);
+  for (size_t n = 0; n < 1000; ++n) {
+    EXPECT_EQ(records[n].type, romea::core::DebugLogRecord::INERTIAL_MEASUREMENTS);
+    EXPECT_EQ(records[n].stamp, static_cast<int64_t>(n));
+    EXPECT_EQ(records[n].values[0], n);
+    EXPECT_EQ(records[n].values[5], 5.);
+  }
+  EXPECT_EQ(records[1000].type, romea::core::DebugLogRecord::LINEAR_SPEED);
+  EXPECT_EQ(records[1000].values[0], 0.5);
+  EXPECT_TRUE(std::isnan(records[1000].values[1]));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDebugLog, dropsAreCountedWhenRingIsFull)
+{
+  const size_t numberOfThreads = 4;
+  const size_t numberOfRecords = 20000;
+  uint64_t numberOfDroppedRecords = 0;
+
+  {
+    romea::core::DebugLog log(filename, 16);
+
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < numberOfThreads; ++t) {
+      producers.emplace_back([&log, t]() {
+          for (size_t n = 0; n < numberOfRecords; ++n) {
+            log.log(
+              romea::core::DebugLogRecord::LINEAR_SPEED, 0,
+              romea::core::Duration(n), static_cast<double>(t));
+          }
+        });
+    }
+    for (auto & producer : producers) {
+      producer.join();
+    }
+    numberOfDroppedRecords = log.getNumberOfDroppedRecords();
+  }
+
+  // every record is either written or reported as dropped, each producer keeps its order
+  auto records = read();
+  uint64_t numberOfWrittenRecords = 0;
+  uint64_t numberOfReportedDrops = 0;
+  std::vector<int64_t> lastStamps(numberOfThreads, -1);
+  for (const auto & record : records) {
+    if (record.type == romea::core::DebugLogRecord::DROPPED_RECORDS) {
+      numberOfReportedDrops += static_cast<uint64_t>(record.values[0]);
+    } else {
+      size_t t = static_cast<size_t>(record.values[0]);
+      ASSERT_LT(t, numberOfThreads);
+      EXPECT_GT(record.stamp, lastStamps[t]);
+      lastStamps[t] = record.stamp;
+      ++numberOfWrittenRecords;
+    }
+  }
+
+  EXPECT_EQ(numberOfReportedDrops, numberOfDroppedRecords);
+  EXPECT_EQ(numberOfWrittenRecords + numberOfReportedDrops, numberOfThreads * numberOfRecords);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDebugLog, writeFailuresAreCountedAsDrops)
+{
+  // file size limit stands for a full disk, writes beyond it fail with EFBIG
+  const size_t numberOfRecords = 100;
+  const size_t numberOfWritableRecords = 10;
+  rlimit previousLimit;
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &previousLimit), 0);
+  rlimit limit = previousLimit;
+  limit.rlim_cur = 12 + numberOfWritableRecords * sizeof(romea::core::DebugLogRecord);
+  auto previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+
+  uint64_t numberOfLoggedRecords = 0;
+  uint64_t numberOfDroppedRecords = 0;
+  {
+    romea::core::DebugLog log(filename);
+    for (size_t n = 0; n < numberOfRecords; ++n) {
+      EXPECT_TRUE(
+        log.log(
+          romea::core::DebugLogRecord::LINEAR_SPEED, 0,
+          romea::core::Duration(n), static_cast<double>(n)));
+      if (n % 4 == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    numberOfLoggedRecords = log.getNumberOfLoggedRecords();
+    numberOfDroppedRecords = log.getNumberOfDroppedRecords();
+  }
+
+  setrlimit(RLIMIT_FSIZE, &previousLimit);
+  std::signal(SIGXFSZ, previousHandler);
+
+  EXPECT_EQ(numberOfLoggedRecords + numberOfDroppedRecords, numberOfRecords);
+  EXPECT_LE(numberOfLoggedRecords, numberOfWritableRecords);
+  EXPECT_GT(numberOfLoggedRecords, 0u);
+
+  // file only holds whole records which have been counted as logged
+  auto records = read();
+  size_t numberOfWrittenRecords = 0;
+  for (const auto & record : records) {
+    if (record.type != romea::core::DebugLogRecord::DROPPED_RECORDS) {
+      EXPECT_EQ(record.stamp, static_cast<int64_t>(record.values[0]));
+      ++numberOfWrittenRecords;
+    }
+  }
+  EXPECT_EQ(numberOfWrittenRecords, numberOfLoggedRecords);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDebugLog, throwWhenFileCannotBeOpened)
+{
+  EXPECT_THROW(romea::core::DebugLog("/nonexistent/debug_log.bin"), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDebugLog, readerRejectOtherFiles)
+{
+  {
+    std::ofstream file(filename);
+    file << "stamp,linear_speed" << std::endl;
+  }
+  EXPECT_THROW(romea::core::DebugLogReader reader(filename), std::runtime_error);
+  EXPECT_THROW(
+    romea::core::DebugLogReader reader("/nonexistent/debug_log.bin"),
+    std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
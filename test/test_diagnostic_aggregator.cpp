@@ -0,0 +1,132 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+// romea
+#include "romea_core_localisation_imu/DiagnosticAggregator.hpp"
+
+namespace
+{
+
+bool waitFor(const std::function<bool()> & predicate)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+}  // namespace
+
+class TestDiagnosticAggregator : public ::testing::Test
+{
+public:
+  TestDiagnosticAggregator()
+  : numberOfEvents(0),
+    numberOfDisorderedEvents(0),
+    lastEventStamp(-1),
+    numberOfReports(0)
+  {
+  }
+
+  std::unique_ptr<romea::core::DiagnosticAggregator> makeAggregator(
+    const romea::core::Duration & period,
+    const size_t & capacity = romea::core::DiagnosticAggregator::DEFAULT_CAPACITY)
+  {
+    return std::make_unique<romea::core::DiagnosticAggregator>(
+      [this](const romea::core::DiagnosticEvent & event) {
+        if (event.stamp <= lastEventStamp.load()) {
+          ++numberOfDisorderedEvents;
+        }
+        lastEventStamp.store(event.stamp);
+        ++numberOfEvents;
+      },
+      [this]() {
+        ++numberOfReports;
+        romea::core::DiagnosticReport report;
+        romea::core::setReportInfo(report, "number_of_events", numberOfEvents.load());
+        return report;
+      },
+      period,
+      capacity);
+  }
+
+  std::atomic<size_t> numberOfEvents;
+  std::atomic<size_t> numberOfDisorderedEvents;
+  std::atomic<int64_t> lastEventStamp;
+  std::atomic<size_t> numberOfReports;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDiagnosticAggregator, eventsAreHandedInOrderBeforeReportIsBuilt)
+{
+  auto aggregator = makeAggregator(romea::core::durationFromSecond(0.005));
+  for (int64_t n = 0; n < 100; ++n) {
+    EXPECT_TRUE(aggregator->push(0, 0, romea::core::Duration(n)));
+  }
+
+  EXPECT_TRUE(
+    waitFor([&aggregator]() {
+      return aggregator->getReport().info["number_of_events"] == "100";
+    }));
+  EXPECT_EQ(numberOfDisorderedEvents.load(), 0u);
+  EXPECT_EQ(aggregator->getNumberOfDroppedEvents(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDiagnosticAggregator, reportIsRebuiltWhenEventsStop)
+{
+  auto aggregator = makeAggregator(romea::core::durationFromSecond(0.005));
+  aggregator->push(0, 0, romea::core::durationFromSecond(10.));
+
+  EXPECT_TRUE(
+    waitFor([this]() {
+      return numberOfEvents.load() == 1 && numberOfReports.load() > 10;
+    }));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestDiagnosticAggregator, dropsAreCountedAndQueuedEventsAreDrainedAtDestruction)
+{
+  auto aggregator = makeAggregator(romea::core::durationFromSecond(60.), 4);
+  for (int64_t n = 0; n < 10; ++n) {
+    aggregator->push(0, 0, romea::core::Duration(n));
+  }
+  EXPECT_EQ(aggregator->getNumberOfDroppedEvents(), 6u);
+
+  aggregator.reset();
+  EXPECT_EQ(numberOfEvents.load(), 4u);
+  EXPECT_EQ(lastEventStamp.load(), 3);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <string>
+
+// romea
+#include "romea_core_localisation_imu/DiagnosticReportCache.hpp"
+
+namespace
+{
+
+romea::core::DiagnosticReport makeReport(const std::string & name, const int & value)
+{
+  romea::core::DiagnosticReport report;
+  report.diagnostics.push_back({romea::core::DiagnosticStatus::OK, name + " is OK."});
+  romea::core::setReportInfo(report, name, value);
+  return report;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportCache, sectionsAreAssembledInOrder)
+{
+  romea::core::DiagnosticReportCache cache(3);
+  cache.updateSection(2, 0, []() {return makeReport("c", 2);});
+  cache.updateSection(0, 0, []() {return makeReport("a", 0);});
+
+  const romea::core::DiagnosticReport & report = cache.getReport();
+  ASSERT_EQ(report.diagnostics.size(), 2u);
+  EXPECT_EQ(report.diagnostics.front().message, "a is OK.");
+  EXPECT_EQ(report.diagnostics.back().message, "c is OK.");
+  EXPECT_EQ(report.info.at("a"), "0");
+  EXPECT_EQ(report.info.at("c"), "2");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticReportCache, sectionsAreOnlyRebuiltWhenVersionChanges)
+{
+  romea::core::DiagnosticReportCache cache(2);
+  int numberOfBuilds = 0;
+  auto builder = [&numberOfBuilds]() {
+      ++numberOfBuilds;
+      return makeReport("a", numberOfBuilds);
+    };
+
+  cache.updateSection(0, 4, builder);
+  cache.updateSection(1, 0, []() {return makeReport("b", 0);});
+  const romea::core::DiagnosticReport * report = &cache.getReport();
+  EXPECT_EQ(report->info.at("a"), "1");
+
+  cache.updateSection(0, 4, builder);
+  EXPECT_EQ(numberOfBuilds, 1);
+  EXPECT_EQ(&cache.getReport(), report);
+  EXPECT_EQ(cache.getReport().info.at("a"), "1");
+
+  cache.updateSection(0, 6, builder);
+  EXPECT_EQ(numberOfBuilds, 2);
+  EXPECT_EQ(cache.getReport().info.at("a"), "2");
+  EXPECT_EQ(cache.getReport().info.at("b"), "0");
+  EXPECT_EQ(cache.getReport().diagnostics.size(), 2u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,103 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <thread>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/DiagnosticStatusMonitor.hpp"
+
+using Transition = romea::core::DiagnosticStatusTransition;
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticStatusMonitor, onlyTransitionsAreRecorded)
+{
+  romea::core::DiagnosticStatusMonitor monitor(2);
+  EXPECT_EQ(monitor.getStatus(Transition::ATTITUDE, 1), romea::core::DiagnosticStatus::STALE);
+
+  monitor.update(
+    Transition::ATTITUDE, 1, romea::core::DiagnosticStatus::OK, romea::core::Duration(1));
+  monitor.update(
+    Transition::ATTITUDE, 1, romea::core::DiagnosticStatus::OK, romea::core::Duration(2));
+  monitor.update(
+    Transition::ATTITUDE, 0, romea::core::DiagnosticStatus::STALE, romea::core::Duration(3));
+  monitor.update(
+    Transition::ATTITUDE, 1, romea::core::DiagnosticStatus::ERROR, romea::core::Duration(4));
+  EXPECT_EQ(monitor.getGeneration(), 2u);
+  EXPECT_EQ(monitor.getStatus(Transition::ATTITUDE, 0), romea::core::DiagnosticStatus::STALE);
+  EXPECT_EQ(monitor.getStatus(Transition::ATTITUDE, 1), romea::core::DiagnosticStatus::ERROR);
+
+  Transition transition;
+  ASSERT_TRUE(monitor.popTransition(transition));
+  EXPECT_EQ(transition.checkup, Transition::ATTITUDE);
+  EXPECT_EQ(transition.imuIndex, 1u);
+  EXPECT_EQ(transition.previousStatus, romea::core::DiagnosticStatus::STALE);
+  EXPECT_EQ(transition.status, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(transition.stamp, romea::core::Duration(1));
+
+  ASSERT_TRUE(monitor.popTransition(transition));
+  EXPECT_EQ(transition.previousStatus, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(transition.status, romea::core::DiagnosticStatus::ERROR);
+  EXPECT_EQ(transition.stamp, romea::core::Duration(4));
+  EXPECT_FALSE(monitor.popTransition(transition));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticStatusMonitor, dropsAreCountedWhenQueueIsFull)
+{
+  romea::core::DiagnosticStatusMonitor monitor(1, 4);
+  for (int64_t n = 0; n < 10; ++n) {
+    monitor.update(
+      Transition::ANGULAR_SPEED_BIAS, 0,
+      n % 2 == 0 ? romea::core::DiagnosticStatus::OK : romea::core::DiagnosticStatus::WARN,
+      romea::core::Duration(n));
+  }
+  EXPECT_EQ(monitor.getGeneration(), 10u);
+  EXPECT_EQ(monitor.getNumberOfDroppedTransitions(), 6u);
+  EXPECT_EQ(
+    monitor.getStatus(Transition::ANGULAR_SPEED_BIAS, 0),
+    romea::core::DiagnosticStatus::WARN);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestDiagnosticStatusMonitor, concurrentUpdatesRecordTransitionOnce)
+{
+  romea::core::DiagnosticStatusMonitor monitor(1);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&monitor]() {
+        for (int64_t n = 0; n < 1000; ++n) {
+          monitor.update(
+            Transition::INERTIAL_MEASUREMENT_RATE, 0,
+            romea::core::DiagnosticStatus::OK, romea::core::Duration(n));
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(monitor.getGeneration(), 1u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,9 +17,15 @@
 #include <gtest/gtest.h>
 
 // std
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
 #include <memory>
 #include <random>
+#include <string>
 #include <utility>
+#include <vector>
 
 // romea
 #include "romea_core_localisation_imu/LocalisationIMUPlugin.hpp"
@@ -54,6 +60,11 @@ public:
   }
 
   void SetUp() override
+  {
+    plugin = makePlugin();
+  }
+
+  std::unique_ptr<romea::core::LocalisationIMUPlugin> makePlugin()
   {
     auto imu = std::make_unique<romea::core::IMUAHRS>(
       10,
@@ -62,7 +73,7 @@ public:
       7.e-09, 1.e-08, 0.000075,
       0.01745);
 
-    plugin = std::make_unique<romea::core::LocalisationIMUPlugin>(std::move(imu));
+    return std::make_unique<romea::core::LocalisationIMUPlugin>(std::move(imu));
   }
 
   const romea::core::Diagnostic & diagnostic(const size_t & index)
@@ -289,6 +300,228 @@ TEST_F(TestIMUPlugin, testTimeout)
 //  }
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestIMUPlugin, testStatusTransitions)
+{
+  using Transition = romea::core::DiagnosticStatusTransition;
+
+  check(
+    romea::core::DiagnosticStatus::OK,     // finalLinearSpeedStatus
+    romea::core::DiagnosticStatus::OK,    // finalAccelerationStatus
+    romea::core::DiagnosticStatus::OK,    // finalAngularSpeedStatus
+    romea::core::DiagnosticStatus::OK,    // finalAttitudeStatus
+    romea::core::DiagnosticStatus::OK);    // finalAngularBiasStatus
+
+  // each checkup goes from STALE to OK through a chain of transitions
+  std::map<uint32_t, romea::core::DiagnosticStatus> statuses;
+  Transition transition;
+  uint64_t numberOfTransitions = 0;
+  while (plugin->popDiagnosticStatusTransition(transition)) {
+    auto it = statuses.emplace(transition.checkup, romea::core::DiagnosticStatus::STALE).first;
+    EXPECT_EQ(transition.previousStatus, it->second);
+    EXPECT_NE(transition.status, transition.previousStatus);
+    it->second = transition.status;
+    ++numberOfTransitions;
+  }
+  EXPECT_EQ(plugin->getDiagnosticStatusGeneration(), numberOfTransitions);
+  ASSERT_EQ(statuses.size(), Transition::NUMBER_OF_CHECKUPS);
+  for (const auto & status : statuses) {
+    EXPECT_EQ(status.second, romea::core::DiagnosticStatus::OK);
+    EXPECT_EQ(
+      plugin->getDiagnosticStatus(Transition::Checkup(status.first)),
+      romea::core::DiagnosticStatus::OK);
+  }
+
+  // nothing changes while system is healthy
+  step(89, romea::core::DiagnosticStatus::OK, romea::core::DiagnosticStatus::OK);
+  EXPECT_EQ(plugin->getDiagnosticStatusGeneration(), numberOfTransitions);
+  EXPECT_FALSE(plugin->popDiagnosticStatusTransition(transition));
+
+  // every checkup is reset by timeout
+  romea::core::Duration stamp = romea::core::durationFromSecond(20.);
+  plugin->makeDiagnosticReport(stamp);
+  size_t numberOfTimeoutTransitions = 0;
+  while (plugin->popDiagnosticStatusTransition(transition)) {
+    EXPECT_EQ(transition.stamp, stamp);
+    ++numberOfTimeoutTransitions;
+  }
+  EXPECT_EQ(numberOfTimeoutTransitions, Transition::NUMBER_OF_CHECKUPS);
+  EXPECT_EQ(
+    plugin->getDiagnosticStatus(Transition::LINEAR_SPEED_RATE),
+    romea::core::DiagnosticStatus::ERROR);
+  EXPECT_EQ(
+    plugin->getDiagnosticStatus(Transition::ATTITUDE),
+    romea::core::DiagnosticStatus::STALE);
+  EXPECT_EQ(
+    plugin->getDiagnosticStatus(Transition::ANGULAR_SPEED_BIAS),
+    romea::core::DiagnosticStatus::WARN);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestIMUPlugin, testBatchMatchesSampleBySample)
+{
+  auto batchPlugin = makePlugin();
+
+  const size_t numberOfSamples = 120;
+  std::vector<romea::core::Duration> stamps(numberOfSamples);
+  std::vector<double> channels[6];
+  for (size_t n = 0; n < numberOfSamples; ++n) {
+    stamps[n] = romea::core::durationFromSecond(0.1 + n / 10.);
+    for (size_t c = 0; c < 3; ++c) {
+      channels[c].push_back(accelerationDistribution(generator) + (c == 2 ? 9.81 : 0.));
+      channels[c + 3].push_back(angularSpeedDistribution(generator));
+    }
+  }
+  // one sample out of range in the middle of a burst
+  channels[5][70] = 2 * M_PI;
+
+  std::vector<romea::core::ObservationAngularSpeed> observations(numberOfSamples);
+  std::unique_ptr<bool[]> validities(new bool[numberOfSamples]);
+
+  // bursts of various sizes, the last one is larger than the internal chunk size
+  const size_t burstSizes[] = {8, 8, 16, 32, 1, 15, 40};
+  size_t begin = 0;
+  for (const size_t & burstSize : burstSizes) {
+    for (size_t n = begin; n < begin + burstSize; ++n) {
+      plugin->processLinearSpeed(stamps[n] - romea::core::durationFromSecond(0.1), 0.);
+      batchPlugin->processLinearSpeed(stamps[n] - romea::core::durationFromSecond(0.1), 0.);
+    }
+
+    romea::core::InertialMeasurementsBatch measurements;
+    measurements.size = burstSize;
+    measurements.stamps = stamps.data() + begin;
+    measurements.accelerationsAlongXAxis = channels[0].data() + begin;
+    measurements.accelerationsAlongYAxis = channels[1].data() + begin;
+    measurements.accelerationsAlongZAxis = channels[2].data() + begin;
+    measurements.angularSpeedsAroundXAxis = channels[3].data() + begin;
+    measurements.angularSpeedsAroundYAxis = channels[4].data() + begin;
+    measurements.angularSpeedsAroundZAxis = channels[5].data() + begin;
+
+    size_t numberOfObservations = batchPlugin->computeAngularSpeeds(
+      measurements, observations.data() + begin, validities.get() + begin);
+
+    size_t expectedNumberOfObservations = 0;
+    for (size_t n = begin; n < begin + burstSize; ++n) {
+      bool validity = plugin->computeAngularSpeed(
+        stamps[n],
+        channels[0][n], channels[1][n], channels[2][n],
+        channels[3][n], channels[4][n], channels[5][n],
+        angularSpeedObs);
+
+      EXPECT_EQ(validities[n], validity);
+      if (validity) {
+        EXPECT_DOUBLE_EQ(observations[n].Y(), angularSpeedObs.Y());
+        EXPECT_DOUBLE_EQ(observations[n].R(), angularSpeedObs.R());
+        ++expectedNumberOfObservations;
+      }
+    }
+    EXPECT_EQ(numberOfObservations, expectedNumberOfObservations);
+    begin += burstSize;
+  }
+
+  EXPECT_FALSE(validities[70]);
+  EXPECT_TRUE(validities[numberOfSamples - 1]);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestIMUPlugin, testDecimation)
+{
+  auto decimatedPlugin = makePlugin();
+  decimatedPlugin->enableDecimation(4);
+
+  const double angularSpeedVariance = 3.4907e-04 / 180. * M_PI * 3.4907e-04 / 180. * M_PI * 10;
+  const size_t numberOfSamples = 200;
+  std::vector<double> angularSpeeds;
+  size_t numberOfRejectedSamples = 0;
+  size_t numberOfDecimatedObservations = 0;
+  romea::core::ObservationAngularSpeed decimatedAngularSpeedObs;
+  for (size_t n = 0; n < numberOfSamples; ++n) {
+    plugin->processLinearSpeed(romea::core::durationFromSecond(n / 10.), 0.);
+    decimatedPlugin->processLinearSpeed(romea::core::durationFromSecond(n / 10.), 0.);
+
+    romea::core::Duration stamp = romea::core::durationFromSecond(0.1 + n / 10.);
+    double values[6];
+    for (size_t c = 0; c < 3; ++c) {
+      values[c] = accelerationDistribution(generator) + (c == 2 ? 9.81 : 0.);
+      values[c + 3] = angularSpeedDistribution(generator);
+    }
+    // one sample out of range among accepted ones
+    if (n == 150) {
+      values[5] = 2 * M_PI;
+    }
+
+    bool validity = plugin->computeAngularSpeed(
+      stamp, values[0], values[1], values[2], values[3], values[4], values[5], angularSpeedObs);
+    bool decimatedValidity = decimatedPlugin->computeAngularSpeed(
+      stamp, values[0], values[1], values[2], values[3], values[4], values[5],
+      decimatedAngularSpeedObs);
+
+    if (!validity) {
+      EXPECT_FALSE(decimatedValidity);
+      ++numberOfRejectedSamples;
+      continue;
+    }
+
+    // every fourth accepted sample carries the average of its group
+    angularSpeeds.push_back(angularSpeedObs.Y());
+    ASSERT_EQ(decimatedValidity, angularSpeeds.size() % 4 == 0);
+    if (decimatedValidity) {
+      double sum = 0.;
+      for (size_t k = angularSpeeds.size() - 4; k < angularSpeeds.size(); ++k) {
+        sum += angularSpeeds[k];
+      }
+      EXPECT_NEAR(decimatedAngularSpeedObs.Y(), sum / 4., 1e-12);
+      EXPECT_NEAR(decimatedAngularSpeedObs.R(), angularSpeedVariance / 4., 1e-15);
+      ++numberOfDecimatedObservations;
+    }
+  }
+  EXPECT_GT(numberOfDecimatedObservations, 20u);
+
+  report = decimatedPlugin->makeDiagnosticReport(romea::core::durationFromSecond(20.));
+  EXPECT_EQ(report.info["decimated_observations"], std::to_string(numberOfDecimatedObservations));
+  EXPECT_EQ(
+    report.info["decimation_averaged_samples"], std::to_string(4 * numberOfDecimatedObservations));
+  EXPECT_EQ(report.info["decimation_rejected_samples"], std::to_string(numberOfRejectedSamples));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestIMUPlugin, testDebugLog)
+{
+  std::string filename = ::testing::TempDir() + "imu_plugin_debug_log.bin";
+  plugin->enableDebugLog(filename);
+  check(
+    romea::core::DiagnosticStatus::OK,     // finalLinearSpeedStatus
+    romea::core::DiagnosticStatus::OK,    // finalAccelerationStatus
+    romea::core::DiagnosticStatus::OK,    // finalAngularSpeedStatus
+    romea::core::DiagnosticStatus::OK,    // finalAttitudeStatus
+    romea::core::DiagnosticStatus::OK);    // finalAngularBiasStatus
+  EXPECT_EQ(report.info["debug_log_dropped_records"], "0");
+  plugin.reset();
+
+  std::ifstream file(filename, std::ios::binary);
+  char header[romea::core::DebugLog::HEADER_SIZE];
+  ASSERT_TRUE(file.read(header, sizeof(header)));
+  EXPECT_EQ(std::string(header, 4), "RIDL");
+  uint32_t recordSize;
+  std::memcpy(&recordSize, header + sizeof(header) - sizeof(recordSize), sizeof(recordSize));
+  ASSERT_EQ(recordSize, sizeof(romea::core::DebugLogRecord));
+  std::map<uint32_t, size_t> numberOfRecords;
+  romea::core::DebugLogRecord record;
+  while (file.read(reinterpret_cast<char *>(&record), sizeof(record))) {
+    ++numberOfRecords[record.type];
+  }
+  std::remove(filename.c_str());
+
+  size_t numberOfSteps = numberOfRecords[romea::core::DebugLogRecord::INERTIAL_MEASUREMENTS];
+  EXPECT_GT(numberOfSteps, 0u);
+  EXPECT_EQ(numberOfRecords[romea::core::DebugLogRecord::LINEAR_SPEED], numberOfSteps);
+  EXPECT_EQ(numberOfRecords[romea::core::DebugLogRecord::ATTITUDE_ANGLES], numberOfSteps);
+  EXPECT_GT(numberOfRecords[romea::core::DebugLogRecord::ANGULAR_SPEED_BIAS], 0u);
+  EXPECT_GT(numberOfRecords[romea::core::DebugLogRecord::ANGULAR_SPEED], 0u);
+  EXPECT_GT(numberOfRecords[romea::core::DebugLogRecord::ATTITUDE], 0u);
+  EXPECT_EQ(numberOfRecords[romea::core::DebugLogRecord::DROPPED_RECORDS], 0u);
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
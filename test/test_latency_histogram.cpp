@@ -0,0 +1,106 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <chrono>
+#include <thread>
+
+// romea
+#include "romea_core_localisation_imu/LatencyHistogram.hpp"
+
+//-----------------------------------------------------------------------------
+TEST(TestLatencyHistogram, emptyHistogram)
+{
+  romea::core::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.getCount(), 0u);
+  EXPECT_EQ(histogram.getPercentile(50.).count(), 0);
+  EXPECT_EQ(histogram.getMaximum().count(), 0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLatencyHistogram, powerOfTwoBuckets)
+{
+  romea::core::LatencyHistogram histogram;
+  histogram.record(romea::core::Duration(0));
+  histogram.record(romea::core::Duration(1));
+  histogram.record(romea::core::Duration(2));
+  histogram.record(romea::core::Duration(3));
+  histogram.record(romea::core::Duration(1000));
+  histogram.record(romea::core::Duration(int64_t(1) << 40));
+
+  EXPECT_EQ(histogram.getCount(), 6u);
+  EXPECT_EQ(histogram.getBucketCount(0), 2u);
+  EXPECT_EQ(histogram.getBucketCount(1), 2u);
+  EXPECT_EQ(histogram.getBucketCount(9), 1u);
+  EXPECT_EQ(histogram.getBucketCount(romea::core::LatencyHistogram::NUMBER_OF_BUCKETS - 1), 1u);
+  EXPECT_EQ(histogram.getMaximum().count(), int64_t(1) << 40);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLatencyHistogram, percentilesAreBucketUpperBounds)
+{
+  romea::core::LatencyHistogram histogram;
+  for (size_t n = 0; n < 99; ++n) {
+    histogram.record(romea::core::Duration(100));
+  }
+  histogram.record(romea::core::Duration(5000));
+
+  // 100 ns lies in bucket [64, 128)
+  EXPECT_EQ(histogram.getPercentile(50.).count(), 128);
+  EXPECT_EQ(histogram.getPercentile(99.).count(), 128);
+  // bounded by maximum latency instead of 8192
+  EXPECT_EQ(histogram.getPercentile(100.).count(), 5000);
+  EXPECT_EQ(histogram.getMaximum().count(), 5000);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLatencyHistogram, readWhileRecording)
+{
+  romea::core::LatencyHistogram histogram;
+  std::thread writer([&histogram]() {
+      for (int64_t n = 0; n < 100000; ++n) {
+        histogram.record(romea::core::Duration(n % 1000));
+      }
+    });
+
+  uint64_t previousCount = 0;
+  while (previousCount < 100000) {
+    uint64_t count = histogram.getCount();
+    EXPECT_GE(count, previousCount);
+    EXPECT_LE(histogram.getPercentile(99.).count(), 1024);
+    previousCount = count;
+  }
+  writer.join();
+  EXPECT_EQ(histogram.getMaximum().count(), 999);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLatencyStage, names)
+{
+  EXPECT_STREQ(
+    romea::core::LatencyStage::toString(romea::core::LatencyStage::INERTIAL_MEASUREMENT_FRAMES),
+    "inertial_measurement_frames");
+  EXPECT_STREQ(romea::core::LatencyStage::toString(romea::core::LatencyStage::REPORT), "report");
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,128 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+// romea
+#include "romea_core_localisation_imu/LinearSpeedBuffer.hpp"
+
+using romea::core::durationFromSecond;
+
+class TestLinearSpeedBuffer : public ::testing::Test
+{
+public:
+  TestLinearSpeedBuffer()
+  : buffer(durationFromSecond(0.3))
+  {
+  }
+
+  romea::core::LinearSpeedBuffer buffer;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLinearSpeedBuffer, emptyBuffer)
+{
+  EXPECT_TRUE(std::isnan(buffer.interpolate(durationFromSecond(1.))));
+
+  // oldest buffered speed is not held backward over overwritten ones
+  double oldest = 2 * romea::core::LinearSpeedBuffer::CAPACITY;
+  EXPECT_TRUE(std::isnan(buffer.interpolate(durationFromSecond((oldest - 0.5) * 0.1))));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLinearSpeedBuffer, interpolateBetweenSpeeds)
+{
+  buffer.push(durationFromSecond(1.0), 0.);
+  buffer.push(durationFromSecond(1.1), 1.);
+  buffer.push(durationFromSecond(1.2), 3.);
+  EXPECT_NEAR(buffer.interpolate(durationFromSecond(1.05)), 0.5, 1e-9);
+  EXPECT_NEAR(buffer.interpolate(durationFromSecond(1.15)), 2.0, 1e-9);
+  EXPECT_NEAR(buffer.interpolate(durationFromSecond(1.1)), 1.0, 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLinearSpeedBuffer, holdSpeedUntilMaximalAge)
+{
+  buffer.push(durationFromSecond(1.0), 2.);
+  EXPECT_DOUBLE_EQ(buffer.interpolate(durationFromSecond(1.2)), 2.);
+  EXPECT_TRUE(std::isnan(buffer.interpolate(durationFromSecond(1.4))));
+  EXPECT_DOUBLE_EQ(buffer.interpolate(durationFromSecond(0.8)), 2.);
+  EXPECT_TRUE(std::isnan(buffer.interpolate(durationFromSecond(0.6))));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLinearSpeedBuffer, noInterpolationOverOdometryGaps)
+{
+  buffer.push(durationFromSecond(1.0), 0.);
+  buffer.push(durationFromSecond(2.0), 1.);
+  EXPECT_TRUE(std::isnan(buffer.interpolate(durationFromSecond(1.1))));
+  EXPECT_TRUE(std::isnan(buffer.interpolate(durationFromSecond(1.5))));
+  EXPECT_DOUBLE_EQ(buffer.interpolate(durationFromSecond(2.0)), 1.);
+  EXPECT_DOUBLE_EQ(buffer.interpolate(durationFromSecond(2.2)), 1.);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLinearSpeedBuffer, oldestSpeedsAreOverwritten)
+{
+  for (size_t n = 0; n < 3 * romea::core::LinearSpeedBuffer::CAPACITY; ++n) {
+    buffer.push(durationFromSecond(n * 0.1), n);
+  }
+  double last = 3 * romea::core::LinearSpeedBuffer::CAPACITY - 1;
+  EXPECT_NEAR(buffer.interpolate(durationFromSecond((last - 0.5) * 0.1)), last - 0.5, 1e-9);
+  EXPECT_TRUE(std::isnan(buffer.interpolate(durationFromSecond(1.))));
+
+  // oldest buffered speed is not held backward over overwritten ones
+  double oldest = 2 * romea::core::LinearSpeedBuffer::CAPACITY;
+  EXPECT_TRUE(std::isnan(buffer.interpolate(durationFromSecond((oldest - 0.5) * 0.1))));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLinearSpeedBuffer, concurrentProducerAndConsumer)
+{
+  // speed equals stamp in second, so any interpolated value must be equal to requested stamp,
+  // a consumer lagging behind overwritten speeds gets NaN
+  const size_t numberOfSpeeds = 200000;
+  std::atomic<size_t> produced(0);
+  std::thread producer([&]() {
+      for (size_t n = 1; n <= numberOfSpeeds; ++n) {
+        buffer.push(durationFromSecond(n * 0.01), n * 0.01);
+        produced.store(n);
+      }
+    });
+
+  size_t numberOfErrors = 0;
+  while (produced.load() < numberOfSpeeds) {
+    double stamp = produced.load() * 0.01 - 0.005;
+    double speed = buffer.interpolate(durationFromSecond(stamp));
+    if (std::isfinite(speed) && std::abs(speed - stamp) > 1e-6) {
+      ++numberOfErrors;
+    }
+  }
+  producer.join();
+  EXPECT_EQ(numberOfErrors, 0u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,146 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <deque>
+#include <random>
+
+// romea
+#include "romea_core_localisation_imu/MovingStatistics.hpp"
+
+using Statistics = romea::core::MovingStatistics<8>;
+
+//-----------------------------------------------------------------------------
+TEST(TestMovingStatistics, matchesNaiveComputation)
+{
+  const size_t windowSize = 50;
+  Statistics statistics(windowSize);
+
+  std::default_random_engine generator(0);
+  std::normal_distribution<double> distribution(0., 0.001);
+  std::deque<Statistics::Row> rows;
+
+  for (size_t n = 0; n < 10 * windowSize + 7; ++n) {
+    Statistics::Row row;
+    for (size_t lane = 0; lane < 8; ++lane) {
+      // large mean on some lanes, like gravity along z axis
+      row.values[lane] = distribution(generator) + (lane == 2 ? 9.81 : 0.) + 1e-5 * n;
+    }
+
+    statistics.update(row);
+    rows.push_back(row);
+    if (rows.size() > windowSize) {
+      rows.pop_front();
+    }
+
+    EXPECT_EQ(statistics.isAvailable(), n + 1 >= windowSize);
+    EXPECT_EQ(statistics.getNumberOfRows(), rows.size());
+
+    for (size_t lane = 0; lane < 8; ++lane) {
+      double mean = 0;
+      for (const auto & r : rows) {
+        mean += r.values[lane] / rows.size();
+      }
+      double variance = 0;
+      for (const auto & r : rows) {
+        variance += (r.values[lane] - mean) * (r.values[lane] - mean) / rows.size();
+      }
+      EXPECT_NEAR(statistics.getMean(lane), mean, 1e-12);
+      EXPECT_NEAR(statistics.getVariance(lane), variance, 1e-12);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestMovingStatistics, reset)
+{
+  Statistics statistics(2);
+  statistics.update({{1., 1., 1., 1., 1., 1., 1., 1.}});
+  statistics.update({{3., 3., 3., 3., 3., 3., 3., 3.}});
+  EXPECT_TRUE(statistics.isAvailable());
+  EXPECT_DOUBLE_EQ(statistics.getMean(0), 2.);
+  EXPECT_DOUBLE_EQ(statistics.getVariance(0), 1.);
+
+  statistics.reset();
+  EXPECT_FALSE(statistics.isAvailable());
+  statistics.update({{5., 5., 5., 5., 5., 5., 5., 5.}});
+  EXPECT_DOUBLE_EQ(statistics.getMean(7), 5.);
+  EXPECT_DOUBLE_EQ(statistics.getVariance(7), 0.);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestMovingStatistics, floatMatchesDouble)
+{
+  const size_t windowSize = 50;
+  Statistics statistics(windowSize);
+  romea::core::MovingStatistics<8, float> floatStatistics(windowSize);
+
+  std::default_random_engine generator(0);
+  std::normal_distribution<double> distribution(0., 0.001);
+  for (size_t n = 0; n < 10 * windowSize + 7; ++n) {
+    Statistics::Row row;
+    romea::core::MovingStatistics<8, float>::Row floatRow;
+    for (size_t lane = 0; lane < 8; ++lane) {
+      row.values[lane] = distribution(generator) + (lane == 2 ? 9.81 : 0.);
+      floatRow.values[lane] = static_cast<float>(row.values[lane]);
+    }
+
+    statistics.update(row);
+    floatStatistics.update(floatRow);
+    for (size_t lane = 0; lane < 8; ++lane) {
+      // float resolution around gravity is 1e-6
+      EXPECT_NEAR(floatStatistics.getMean(lane), statistics.getMean(lane), 1e-6);
+      EXPECT_NEAR(floatStatistics.getVariance(lane), statistics.getVariance(lane), 1e-8);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestMovingStatistics, floatSumsDoNotDriftOverManyWindows)
+{
+  const size_t windowSize = 50;
+  Statistics statistics(windowSize);
+  romea::core::MovingStatistics<8, float> floatStatistics(windowSize);
+
+  // mean moves far from first offset, rounding errors of running sums are flushed each window
+  std::default_random_engine generator(0);
+  std::normal_distribution<double> distribution(0., 0.001);
+  for (size_t n = 0; n < 200 * windowSize; ++n) {
+    Statistics::Row row;
+    romea::core::MovingStatistics<8, float>::Row floatRow;
+    for (size_t lane = 0; lane < 8; ++lane) {
+      row.values[lane] = distribution(generator) + (lane == 2 ? 9.81 : 0.) + 1e-4 * n;
+      floatRow.values[lane] = static_cast<float>(row.values[lane]);
+    }
+
+    statistics.update(row);
+    floatStatistics.update(floatRow);
+  }
+
+  for (size_t lane = 0; lane < 8; ++lane) {
+    EXPECT_NEAR(floatStatistics.getMean(lane), statistics.getMean(lane), 1e-5);
+    EXPECT_NEAR(floatStatistics.getVariance(lane), statistics.getVariance(lane), 1e-8);
+  }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,103 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <thread>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/MPSCQueue.hpp"
+
+struct Value
+{
+  size_t producer;
+  size_t index;
+};
+
+//-----------------------------------------------------------------------------
+TEST(TestMPSCQueue, capacityIsRoundedToPowerOfTwo)
+{
+  EXPECT_EQ(romea::core::MPSCQueue<Value>(0).capacity(), 2u);
+  EXPECT_EQ(romea::core::MPSCQueue<Value>(5).capacity(), 8u);
+  EXPECT_EQ(romea::core::MPSCQueue<Value>(16).capacity(), 16u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestMPSCQueue, pushFailsWhenFull)
+{
+  romea::core::MPSCQueue<Value> queue(4);
+  Value value;
+  EXPECT_FALSE(queue.tryPop(value));
+
+  for (size_t n = 0; n < 4; ++n) {
+    EXPECT_TRUE(queue.tryPush({0, n}));
+  }
+  EXPECT_FALSE(queue.tryPush({0, 4}));
+
+  ASSERT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value.index, 0u);
+  EXPECT_TRUE(queue.tryPush({0, 4}));
+
+  for (size_t n = 1; n < 5; ++n) {
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value.index, n);
+  }
+  EXPECT_FALSE(queue.tryPop(value));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestMPSCQueue, eachProducerKeepsItsOrder)
+{
+  const size_t numberOfProducers = 4;
+  const size_t numberOfValues = 5000;
+  romea::core::MPSCQueue<Value> queue(256);
+
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < numberOfProducers; ++p) {
+    producers.emplace_back([&queue, p]() {
+        for (size_t n = 0; n < numberOfValues; ++n) {
+          while (!queue.tryPush({p, n})) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  std::vector<size_t> nextIndexes(numberOfProducers, 0);
+  size_t numberOfPoppedValues = 0;
+  while (numberOfPoppedValues < numberOfProducers * numberOfValues) {
+    Value value;
+    if (queue.tryPop(value)) {
+      ASSERT_LT(value.producer, numberOfProducers);
+      EXPECT_EQ(value.index, nextIndexes[value.producer]);
+      nextIndexes[value.producer] = value.index + 1;
+      ++numberOfPoppedValues;
+    }
+  }
+
+  for (auto & producer : producers) {
+    producer.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,339 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/LocalisationIMUPlugin.hpp"
+#include "romea_core_localisation_imu/LocalisationMultiIMUPlugin.hpp"
+
+namespace
+{
+
+const double RATE = 100.;
+
+std::unique_ptr<romea::core::IMUAHRS> makeIMU()
+{
+  return std::make_unique<romea::core::IMUAHRS>(
+    RATE,
+    0.0005, 0.02, 10.,
+    3.4907e-04 / 180. * M_PI, 3.4907e-02 / 180. * M_PI, 300. / 180. * M_PI,
+    7.e-09, 1.e-08, 0.000075,
+    0.01745);
+}
+
+std::unique_ptr<romea::core::LocalisationMultiIMUPlugin> makeMultiPlugin(
+  const size_t & numberOfIMUs)
+{
+  std::vector<std::unique_ptr<romea::core::IMUAHRS>> imus;
+  for (size_t n = 0; n < numberOfIMUs; ++n) {
+    imus.push_back(makeIMU());
+  }
+  return std::make_unique<romea::core::LocalisationMultiIMUPlugin>(std::move(imus));
+}
+
+bool hasDiagnostic(const romea::core::DiagnosticReport & report, const std::string & message)
+{
+  for (const auto & diagnostic : report.diagnostics) {
+    if (diagnostic.message == message) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+class TestMultiIMUPlugin : public ::testing::Test
+{
+public:
+  TestMultiIMUPlugin()
+  : generator(0),
+    accelerationDistribution(0, 0.0005 * std::sqrt(RATE)),
+    angularSpeedDistribution(0, 3.4907e-04 * std::sqrt(RATE) / 180. * M_PI)
+  {
+  }
+
+  struct Sample
+  {
+    romea::core::Duration stamp;
+    double values[6];
+  };
+
+  Sample makeSample(const size_t & n)
+  {
+    Sample sample;
+    sample.stamp = romea::core::durationFromSecond(n / RATE);
+    sample.values[0] = accelerationDistribution(generator);
+    sample.values[1] = accelerationDistribution(generator);
+    sample.values[2] = 9.81 + accelerationDistribution(generator);
+    sample.values[3] = angularSpeedDistribution(generator);
+    sample.values[4] = angularSpeedDistribution(generator);
+    sample.values[5] = 0.001 + angularSpeedDistribution(generator);
+    return sample;
+  }
+
+  std::default_random_engine generator;
+  std::normal_distribution<double> accelerationDistribution;
+  std::normal_distribution<double> angularSpeedDistribution;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMultiIMUPlugin, eachIMUMatchesSingleIMUPlugin)
+{
+  const size_t numberOfIMUs = 3;
+  auto multiPlugin = makeMultiPlugin(numberOfIMUs);
+  std::vector<std::unique_ptr<romea::core::LocalisationIMUPlugin>> plugins;
+  for (size_t i = 0; i < numberOfIMUs; ++i) {
+    plugins.push_back(std::make_unique<romea::core::LocalisationIMUPlugin>(makeIMU()));
+  }
+
+  size_t numberOfObservations = 0;
+  for (size_t n = 0; n < 10 * RATE; ++n) {
+    if (n % 10 == 0) {
+      romea::core::Duration stamp = romea::core::durationFromSecond(n / RATE);
+      multiPlugin->processLinearSpeed(stamp, 0.);
+      for (auto & plugin : plugins) {
+        plugin->processLinearSpeed(stamp, 0.);
+      }
+    }
+
+    for (size_t i = 0; i < numberOfIMUs; ++i) {
+      Sample sample = makeSample(n);
+      const double * v = sample.values;
+      romea::core::ObservationAngularSpeed expected;
+      romea::core::ObservationAngularSpeed angularSpeed;
+      bool expectedValidity = plugins[i]->computeAngularSpeed(
+        sample.stamp, v[0], v[1], v[2], v[3], v[4], v[5], expected);
+      bool validity = multiPlugin->computeAngularSpeed(
+        i, sample.stamp, v[0], v[1], v[2], v[3], v[4], v[5], angularSpeed);
+
+      ASSERT_EQ(validity, expectedValidity);
+      if (validity) {
+        EXPECT_DOUBLE_EQ(angularSpeed.Y(), expected.Y());
+        EXPECT_DOUBLE_EQ(angularSpeed.R(), expected.R());
+        ++numberOfObservations;
+      }
+    }
+  }
+  EXPECT_GT(numberOfObservations, 0u);
+
+  auto report = multiPlugin->makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  ASSERT_EQ(report.diagnostics.size(), 1 + 5 * numberOfIMUs);
+  EXPECT_EQ(report.diagnostics.back().message, "imu2: Angular speed bias is OK.");
+  EXPECT_EQ(report.info.count("imu1_angular_speed_bias"), 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMultiIMUPlugin, timeoutOnlyAffectsSilentIMU)
+{
+  auto plugin = makeMultiPlugin(2);
+  romea::core::ObservationAngularSpeed angularSpeed;
+  for (size_t n = 0; n < 3 * RATE; ++n) {
+    Sample sample = makeSample(n);
+    const double * v = sample.values;
+    plugin->computeAngularSpeed(
+      0, sample.stamp, v[0], v[1], v[2], v[3], v[4], v[5], angularSpeed);
+    if (n < RATE) {
+      plugin->computeAngularSpeed(
+        1, sample.stamp, v[0], v[1], v[2], v[3], v[4], v[5], angularSpeed);
+    }
+  }
+
+  auto report = plugin->makeDiagnosticReport(romea::core::durationFromSecond(3.));
+  bool isIMU0RateOk = false;
+  bool isIMU1RateOk = false;
+  for (const auto & diagnostic : report.diagnostics) {
+    if (diagnostic.message == "imu0: inertial_measurements rate is OK.") {
+      isIMU0RateOk = true;
+    }
+    if (diagnostic.message == "imu1: inertial_measurements rate is OK.") {
+      isIMU1RateOk = true;
+    }
+  }
+  EXPECT_TRUE(isIMU0RateOk);
+  EXPECT_FALSE(isIMU1RateOk);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMultiIMUPlugin, eightIMUsProcessedConcurrently)
+{
+  const size_t numberOfIMUs = 8;
+  auto plugin = makeMultiPlugin(numberOfIMUs);
+
+  std::vector<Sample> samples;
+  for (size_t n = 0; n < 10 * RATE; ++n) {
+    samples.push_back(makeSample(n));
+  }
+
+  std::vector<size_t> numberOfObservations(numberOfIMUs, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numberOfIMUs; ++i) {
+    threads.emplace_back([&, i]() {
+        romea::core::ObservationAngularSpeed angularSpeed;
+        for (size_t n = 0; n < samples.size(); ++n) {
+          // linear speeds are published by IMU 0 thread, the only producer
+          if (i == 0 && n % 10 == 0) {
+            plugin->processLinearSpeed(samples[n].stamp, 0.);
+          }
+          const double * v = samples[n].values;
+          if (plugin->computeAngularSpeed(
+              i, samples[n].stamp, v[0], v[1], v[2], v[3], v[4], v[5], angularSpeed))
+          {
+            ++numberOfObservations[i];
+          }
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  // other threads may run ahead of linear speeds published by IMU 0 thread
+  EXPECT_GT(numberOfObservations[0], 0u);
+
+  auto report = plugin->makeDiagnosticReport(samples.back().stamp);
+  EXPECT_EQ(report.diagnostics.size(), 1 + 5 * numberOfIMUs);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMultiIMUPlugin, diagnosticReportsAskedConcurrently)
+{
+  const size_t numberOfIMUs = 2;
+  const size_t numberOfReportThreads = 4;
+  auto plugin = makeMultiPlugin(numberOfIMUs);
+
+  // reports are asked by several threads while samples are processed
+  std::atomic<int64_t> lastStamp(0);
+  std::atomic<bool> isRunning(true);
+  std::vector<size_t> numberOfBadReports(numberOfReportThreads, 0);
+  std::vector<std::thread> reportThreads;
+  for (size_t t = 0; t < numberOfReportThreads; ++t) {
+    reportThreads.emplace_back([&, t]() {
+        while (isRunning.load()) {
+          // sections appear with first samples and bias ones once rate window is full,
+          // so only duplicated sections and upper bound are checked
+          auto report = plugin->makeDiagnosticReport(romea::core::Duration(lastStamp.load()));
+          std::set<std::string> messages;
+          for (const auto & diagnostic : report.diagnostics) {
+            if (!messages.insert(diagnostic.message).second) {
+              ++numberOfBadReports[t];
+            }
+          }
+          if (report.diagnostics.size() > 1 + 5 * numberOfIMUs) {
+            ++numberOfBadReports[t];
+          }
+        }
+      });
+  }
+
+  romea::core::ObservationAngularSpeed angularSpeed;
+  for (size_t n = 0; n < 10 * RATE; ++n) {
+    Sample sample = makeSample(n);
+    if (n % 10 == 0) {
+      plugin->processLinearSpeed(sample.stamp, 0.);
+    }
+    for (size_t i = 0; i < numberOfIMUs; ++i) {
+      const double * v = sample.values;
+      plugin->computeAngularSpeed(i, sample.stamp, v[0], v[1], v[2], v[3], v[4], v[5],
+        angularSpeed);
+    }
+    lastStamp.store(sample.stamp.count());
+  }
+
+  isRunning.store(false);
+  for (auto & thread : reportThreads) {
+    thread.join();
+  }
+  for (size_t t = 0; t < numberOfReportThreads; ++t) {
+    EXPECT_EQ(numberOfBadReports[t], 0u);
+  }
+
+  auto report = plugin->makeDiagnosticReport(romea::core::Duration(lastStamp.load()));
+  EXPECT_TRUE(hasDiagnostic(report, "imu1: inertial_measurements rate is OK."));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestMultiIMUPlugin, diagnosticsAggregatedInBackground)
+{
+  const size_t numberOfIMUs = 2;
+  auto plugin = makeMultiPlugin(numberOfIMUs);
+  plugin->enableDiagnosticAggregation(romea::core::durationFromSecond(0.005));
+
+  size_t numberOfObservations = 0;
+  romea::core::ObservationAngularSpeed angularSpeed;
+  for (size_t n = 0; n < 10 * RATE; ++n) {
+    Sample sample = makeSample(n);
+    if (n % 10 == 0) {
+      plugin->processLinearSpeed(sample.stamp, 0.);
+      // give aggregator thread time to follow sample stream
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    for (size_t i = 0; i < numberOfIMUs; ++i) {
+      const double * v = sample.values;
+      if (plugin->computeAngularSpeed(
+          i, sample.stamp, v[0], v[1], v[2], v[3], v[4], v[5], angularSpeed))
+      {
+        ++numberOfObservations;
+      }
+    }
+  }
+  EXPECT_GT(numberOfObservations, 0u);
+
+  romea::core::Duration stamp = romea::core::durationFromSecond(10.);
+  romea::core::DiagnosticReport report = plugin->makeDiagnosticReport(stamp);
+  EXPECT_EQ(report.diagnostics.size(), 1 + 5 * numberOfIMUs);
+  EXPECT_TRUE(hasDiagnostic(report, "imu1: inertial_measurements rate is OK."));
+  EXPECT_EQ(report.info["diagnostic_dropped_events"], "0");
+
+  // wall clock time does not move the sample time base forward
+  for (size_t n = 0; n < 30; ++n) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    report = plugin->makeDiagnosticReport(stamp);
+  }
+  EXPECT_TRUE(hasDiagnostic(report, "imu1: inertial_measurements rate is OK."));
+
+  // sensors are silent, timeouts are detected at caller stamps by aggregator thread
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (hasDiagnostic(report, "imu1: inertial_measurements rate is OK.") &&
+    std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stamp += romea::core::durationFromSecond(0.1);
+    report = plugin->makeDiagnosticReport(stamp);
+  }
+  EXPECT_FALSE(hasDiagnostic(report, "imu0: inertial_measurements rate is OK."));
+  EXPECT_FALSE(hasDiagnostic(report, "imu1: inertial_measurements rate is OK."));
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
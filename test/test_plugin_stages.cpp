@@ -0,0 +1,622 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/LocalisationIMUPlugin.hpp"
+#include "romea_core_localisation_imu/LocalisationMultiIMUPlugin.hpp"
+
+namespace
+{
+
+const double RATE = 100.;
+
+// angular speeds are forwarded without any checkup or bias correction
+struct RawStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool ATTITUDE_CHECKUP = false;
+  static constexpr bool ATTITUDE_RATE_CHECKUP = false;
+  static constexpr bool INERTIAL_MEASUREMENT_CHECKUP = false;
+  static constexpr bool INERTIAL_MEASUREMENT_RATE_CHECKUP = false;
+  static constexpr bool LINEAR_SPEED_RATE_CHECKUP = false;
+  static constexpr bool ANGULAR_SPEED_BIAS_ESTIMATION = false;
+  static constexpr bool DEBUG_LOG = false;
+};
+
+// fully featured pipeline without debug log
+struct NoDebugLogStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool DEBUG_LOG = false;
+};
+
+// fully featured pipeline with recursive bias filter
+struct RecursiveBiasStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool RECURSIVE_ANGULAR_SPEED_BIAS_ESTIMATION = true;
+};
+
+// attitude propagated with raw angular speeds between attitude frames received at any rate
+struct RawAttitudePropagationStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool ATTITUDE_RATE_CHECKUP = false;
+  static constexpr bool ANGULAR_SPEED_BIAS_ESTIMATION = false;
+  static constexpr bool ATTITUDE_PROPAGATION = true;
+  static constexpr bool DEBUG_LOG = false;
+};
+
+// fully featured pipeline with attitude propagation
+struct AttitudePropagationStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool ATTITUDE_PROPAGATION = true;
+};
+
+// attitude propagated with bias corrected angular speeds between attitude frames received at
+// any rate
+struct SlowAttitudePropagationStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool ATTITUDE_RATE_CHECKUP = false;
+  static constexpr bool ATTITUDE_PROPAGATION = true;
+};
+
+// fully featured pipeline with pre-integrated angular speeds
+struct AngularSpeedIntegrationStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool ANGULAR_SPEED_INTEGRATION = true;
+};
+
+// fully featured pipeline with spike rejection
+struct SpikeRejectionStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool SPIKE_REJECTION = true;
+};
+
+// fully featured pipeline with stage timings
+struct TimedStages : romea::core::LocalisationIMUPluginStages
+{
+  static constexpr bool LATENCY_HISTOGRAMS = true;
+};
+
+std::unique_ptr<romea::core::IMUAHRS> makeIMU()
+{
+  return std::make_unique<romea::core::IMUAHRS>(
+    RATE,
+    0.0005, 0.02, 10.,
+    3.4907e-04 / 180. * M_PI, 3.4907e-02 / 180. * M_PI, 300. / 180. * M_PI,
+    7.e-09, 1.e-08, 0.000075,
+    0.01745);
+}
+
+}  // namespace
+
+class TestPluginStages : public ::testing::Test
+{
+public:
+  TestPluginStages()
+  : generator(0),
+    accelerationDistribution(0, 0.0005 * std::sqrt(RATE)),
+    angularSpeedDistribution(0, 3.4907e-04 * std::sqrt(RATE) / 180. * M_PI)
+  {
+  }
+
+  struct Sample
+  {
+    romea::core::Duration stamp;
+    double values[6];
+  };
+
+  Sample makeSample(const size_t & n)
+  {
+    Sample sample;
+    sample.stamp = romea::core::durationFromSecond(n / RATE);
+    sample.values[0] = accelerationDistribution(generator);
+    sample.values[1] = accelerationDistribution(generator);
+    sample.values[2] = 9.81 + accelerationDistribution(generator);
+    sample.values[3] = angularSpeedDistribution(generator);
+    sample.values[4] = angularSpeedDistribution(generator);
+    sample.values[5] = 0.001 + angularSpeedDistribution(generator);
+    return sample;
+  }
+
+  // inertial measurements columns, batches point into them
+  struct Columns
+  {
+    romea::core::InertialMeasurementsBatch makeBatch(const size_t & begin, const size_t & size)
+    {
+      return {size, &stamps[begin],
+        &values[0][begin], &values[1][begin], &values[2][begin],
+        &values[3][begin], &values[4][begin], &values[5][begin]};
+    }
+
+    std::vector<romea::core::Duration> stamps;
+    std::vector<double> values[6];
+  };
+
+  Columns makeColumns(const size_t & numberOfSamples)
+  {
+    Columns columns;
+    for (size_t n = 0; n < numberOfSamples; ++n) {
+      Sample sample = makeSample(n + 1);
+      columns.stamps.push_back(sample.stamp);
+      for (size_t c = 0; c < 6; ++c) {
+        columns.values[c].push_back(sample.values[c]);
+      }
+    }
+    return columns;
+  }
+
+  template<typename Plugin>
+  bool computeAngularSpeed(
+    Plugin & plugin,
+    const Sample & sample,
+    romea::core::ObservationAngularSpeed & angularSpeed)
+  {
+    const double * v = sample.values;
+    return plugin.computeAngularSpeed(
+      sample.stamp, v[0], v[1], v[2], v[3], v[4], v[5], angularSpeed);
+  }
+
+  std::default_random_engine generator;
+  std::normal_distribution<double> accelerationDistribution;
+  std::normal_distribution<double> angularSpeedDistribution;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, rawStagesForwardEverySample)
+{
+  romea::core::BasicLocalisationIMUPlugin<RawStages> plugin(makeIMU());
+
+  for (size_t n = 0; n < 100; ++n) {
+    Sample sample = makeSample(n);
+    romea::core::ObservationAngularSpeed angularSpeed;
+    ASSERT_TRUE(computeAngularSpeed(plugin, sample, angularSpeed));
+    EXPECT_NEAR(angularSpeed.Y(), sample.values[5], 1e-12);
+  }
+
+  // out of range attitude is not checked
+  romea::core::ObservationAttitude attitude;
+  EXPECT_TRUE(plugin.computeAttitude(romea::core::durationFromSecond(1.), 1.5, 0., 0., attitude));
+
+  auto report = plugin.makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  EXPECT_TRUE(report.diagnostics.empty());
+  EXPECT_EQ(plugin.getDiagnosticStatusGeneration(), 0u);
+  EXPECT_EQ(
+    plugin.getDiagnosticStatus(romea::core::DiagnosticStatusTransition::ANGULAR_SPEED_BIAS),
+    romea::core::DiagnosticStatus::STALE);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, rawStagesWithSeveralIMUs)
+{
+  std::vector<std::unique_ptr<romea::core::IMUAHRS>> imus;
+  imus.push_back(makeIMU());
+  imus.push_back(makeIMU());
+  romea::core::BasicLocalisationMultiIMUPlugin<RawStages> plugin(std::move(imus));
+
+  romea::core::ObservationAngularSpeed angularSpeed;
+  EXPECT_TRUE(plugin.computeAngularSpeed(
+      1, romea::core::durationFromSecond(0.), 0., 0., 9.81, 0., 0., 0.5, angularSpeed));
+  EXPECT_NEAR(angularSpeed.Y(), 0.5, 1e-12);
+  EXPECT_TRUE(plugin.makeDiagnosticReport(romea::core::durationFromSecond(1.)).diagnostics.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, disabledDebugLogKeepsDefaultBehaviour)
+{
+  romea::core::LocalisationIMUPlugin expectedPlugin(makeIMU());
+  romea::core::BasicLocalisationIMUPlugin<NoDebugLogStages> plugin(makeIMU());
+
+  size_t numberOfObservations = 0;
+  for (size_t n = 0; n < 10 * RATE; ++n) {
+    if (n % 10 == 0) {
+      expectedPlugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+      plugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+    }
+
+    Sample sample = makeSample(n);
+    romea::core::ObservationAngularSpeed expected;
+    bool expectedValidity = computeAngularSpeed(expectedPlugin, sample, expected);
+    romea::core::ObservationAngularSpeed angularSpeed;
+    bool validity = computeAngularSpeed(plugin, sample, angularSpeed);
+
+    ASSERT_EQ(validity, expectedValidity);
+    if (validity) {
+      EXPECT_DOUBLE_EQ(angularSpeed.Y(), expected.Y());
+      ++numberOfObservations;
+    }
+  }
+  EXPECT_GT(numberOfObservations, 0u);
+
+  auto expectedReport = expectedPlugin.makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  auto report = plugin.makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  ASSERT_EQ(report.diagnostics.size(), expectedReport.diagnostics.size());
+  EXPECT_EQ(report.info, expectedReport.info);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, recursiveBiasEstimation)
+{
+  romea::core::LocalisationIMUPlugin movingAveragePlugin(makeIMU());
+  romea::core::BasicLocalisationIMUPlugin<RecursiveBiasStages> plugin(makeIMU());
+  const double angularSpeedVariance = makeIMU()->getAngularSpeedVariance();
+
+  size_t firstMovingAverageObservation = 0;
+  size_t firstObservation = 0;
+  for (size_t n = 1; n < 10 * RATE; ++n) {
+    if (n % 10 == 0) {
+      movingAveragePlugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+      plugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+    }
+
+    Sample sample = makeSample(n);
+    romea::core::ObservationAngularSpeed movingAverageAngularSpeed;
+    if (computeAngularSpeed(movingAveragePlugin, sample, movingAverageAngularSpeed) &&
+      firstMovingAverageObservation == 0)
+    {
+      firstMovingAverageObservation = n;
+    }
+
+    romea::core::ObservationAngularSpeed angularSpeed;
+    if (computeAngularSpeed(plugin, sample, angularSpeed)) {
+      if (firstObservation == 0) {
+        firstObservation = n;
+      }
+
+      // observation variance accounts for bias uncertainty
+      EXPECT_GT(angularSpeed.R(), angularSpeedVariance);
+      EXPECT_NEAR(angularSpeed.Y(), sample.values[5] - 0.001, 5 * std::sqrt(angularSpeed.R()));
+    }
+  }
+
+  // no need to wait for a full 5 s bias window
+  ASSERT_GT(firstObservation, 0u);
+  ASSERT_GT(firstMovingAverageObservation, 0u);
+  EXPECT_LT(firstObservation + 4 * RATE, firstMovingAverageObservation);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, attitudePropagationBetweenAttitudeFrames)
+{
+  romea::core::BasicLocalisationIMUPlugin<RawAttitudePropagationStages> plugin(makeIMU());
+  const double angleVariance = makeIMU()->getAngleVariance();
+  const double rollRate = 0.02;
+
+  size_t numberOfPropagatedAttitudes = 0;
+  romea::core::ObservationAttitude attitude;
+  for (size_t n = 0; n < 4 * RATE; ++n) {
+    // attitude frames at 10 Hz
+    if (n % 10 == 0) {
+      ASSERT_TRUE(plugin.computeAttitude(
+          romea::core::durationFromSecond(n / RATE), rollRate * n / RATE, 0.01, 0., attitude));
+    }
+
+    Sample sample = makeSample(n);
+    sample.values[3] += rollRate;
+    romea::core::ObservationAngularSpeed angularSpeed;
+    computeAngularSpeed(plugin, sample, angularSpeed);
+
+    if (plugin.getPropagatedAttitude(attitude)) {
+      ++numberOfPropagatedAttitudes;
+      EXPECT_NEAR(attitude.Y(romea::core::ObservationAttitude::ROLL), rollRate * n / RATE, 1e-4);
+      EXPECT_NEAR(attitude.Y(romea::core::ObservationAttitude::PITCH), 0.01, 1e-4);
+      EXPECT_GT(attitude.R()(0, 0), angleVariance);
+      EXPECT_DOUBLE_EQ(attitude.R()(1, 1), attitude.R()(0, 0));
+      EXPECT_DOUBLE_EQ(attitude.R()(0, 1), 0.);
+    }
+  }
+
+  // samples are accepted once their rate is estimated, those stamped like attitude frames are
+  // not propagated
+  EXPECT_GT(numberOfPropagatedAttitudes, RATE);
+  EXPECT_LE(numberOfPropagatedAttitudes, 4 * RATE * 9 / 10);
+
+  romea::core::LocalisationIMUPlugin defaultPlugin(makeIMU());
+  EXPECT_FALSE(defaultPlugin.getPropagatedAttitude(attitude));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, attitudePropagationWaitsForAngularSpeedBias)
+{
+  romea::core::BasicLocalisationIMUPlugin<AttitudePropagationStages> plugin(makeIMU());
+  // same stream, attitudes are asked without their validities
+  romea::core::BasicLocalisationIMUPlugin<AttitudePropagationStages> attitudeOnlyPlugin(makeIMU());
+
+  size_t firstObservation = 0;
+  size_t firstPropagatedAttitude = 0;
+  romea::core::ObservationAttitude attitude;
+  for (size_t n = 1; n < 10 * RATE; ++n) {
+    if (n % 10 == 0) {
+      plugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+      attitudeOnlyPlugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+    }
+
+    // attitude frames at inertial measurement rate, half a period before each sample
+    plugin.computeAttitude(
+      romea::core::durationFromSecond((n - 0.5) / RATE), 0.05, -0.02, 0., attitude);
+    attitudeOnlyPlugin.computeAttitude(
+      romea::core::durationFromSecond((n - 0.5) / RATE), 0.05, -0.02, 0., attitude);
+
+    Sample sample = makeSample(n);
+    const double * v = sample.values;
+    romea::core::InertialMeasurementsBatch measurements;
+    measurements.size = 1;
+    measurements.stamps = &sample.stamp;
+    measurements.accelerationsAlongXAxis = &v[0];
+    measurements.accelerationsAlongYAxis = &v[1];
+    measurements.accelerationsAlongZAxis = &v[2];
+    measurements.angularSpeedsAroundXAxis = &v[3];
+    measurements.angularSpeedsAroundYAxis = &v[4];
+    measurements.angularSpeedsAroundZAxis = &v[5];
+
+    romea::core::ObservationAngularSpeed angularSpeed;
+    romea::core::ObservationAttitude propagatedAttitude;
+    bool validity;
+    bool attitudeValidity;
+    plugin.computeAngularSpeeds(
+      measurements, &angularSpeed, &validity, &propagatedAttitude, &attitudeValidity);
+
+    romea::core::ObservationAngularSpeed otherAngularSpeed;
+    romea::core::ObservationAttitude unvalidatedAttitude;
+    bool otherValidity;
+    attitudeOnlyPlugin.computeAngularSpeeds(
+      measurements, &otherAngularSpeed, &otherValidity, &unvalidatedAttitude);
+
+    if (validity && firstObservation == 0) {
+      firstObservation = n;
+    }
+    if (attitudeValidity) {
+      if (firstPropagatedAttitude == 0) {
+        firstPropagatedAttitude = n;
+      }
+      EXPECT_NEAR(propagatedAttitude.Y(romea::core::ObservationAttitude::ROLL), 0.05, 1e-5);
+      EXPECT_NEAR(propagatedAttitude.Y(romea::core::ObservationAttitude::PITCH), -0.02, 1e-5);
+      EXPECT_EQ(unvalidatedAttitude.Y(), propagatedAttitude.Y());
+    }
+  }
+
+  // angular speeds are only propagated once their bias is known
+  ASSERT_GT(firstObservation, 0u);
+  EXPECT_EQ(firstPropagatedAttitude, firstObservation);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, batchedAttitudePropagationMatchesSampleBySample)
+{
+  romea::core::BasicLocalisationIMUPlugin<SlowAttitudePropagationStages> plugin(makeIMU());
+  romea::core::BasicLocalisationIMUPlugin<SlowAttitudePropagationStages> batchPlugin(makeIMU());
+
+  const size_t batchSize = 10;
+  const size_t numberOfSamples = 10 * RATE;
+  Columns columns = makeColumns(numberOfSamples);
+
+  // biases change at each standstill sample, each one is corrected by its own biases
+  size_t numberOfPropagatedAttitudes = 0;
+  std::vector<romea::core::ObservationAngularSpeed> angularSpeeds(batchSize);
+  std::vector<romea::core::ObservationAttitude> attitudes(batchSize);
+  bool validities[batchSize];
+  bool attitudeValidities[batchSize];
+  for (size_t begin = 0; begin < numberOfSamples; begin += batchSize) {
+    const romea::core::Duration stamp =
+      columns.stamps[begin] - romea::core::durationFromSecond(0.5 / RATE);
+    romea::core::ObservationAttitude attitude;
+    plugin.processLinearSpeed(stamp, 0.);
+    plugin.computeAttitude(stamp, 0.05, -0.02, 0., attitude);
+    batchPlugin.processLinearSpeed(stamp, 0.);
+    batchPlugin.computeAttitude(stamp, 0.05, -0.02, 0., attitude);
+
+    batchPlugin.computeAngularSpeeds(
+      columns.makeBatch(begin, batchSize), angularSpeeds.data(), validities,
+      attitudes.data(), attitudeValidities);
+
+    for (size_t k = 0; k < batchSize; ++k) {
+      romea::core::ObservationAngularSpeed angularSpeed;
+      romea::core::ObservationAttitude propagatedAttitude;
+      bool validity;
+      bool attitudeValidity;
+      plugin.computeAngularSpeeds(
+        columns.makeBatch(begin + k, 1), &angularSpeed, &validity,
+        &propagatedAttitude, &attitudeValidity);
+
+      ASSERT_EQ(attitudeValidities[k], attitudeValidity);
+      if (attitudeValidity) {
+        ++numberOfPropagatedAttitudes;
+        EXPECT_EQ(attitudes[k].Y(), propagatedAttitude.Y());
+      }
+    }
+  }
+  EXPECT_GT(numberOfPropagatedAttitudes, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, deltaAnglesMatchAngularSpeedObservations)
+{
+  romea::core::BasicLocalisationIMUPlugin<AngularSpeedIntegrationStages> plugin(makeIMU());
+  const double angularSpeedVariance = makeIMU()->getAngularSpeedVariance();
+
+  size_t numberOfObservations = 0;
+  size_t numberOfIntegratedSamples = 0;
+  double observedAngle = 0.;
+  double integratedAngle = 0.;
+  romea::core::DeltaAngles deltaAngles;
+  for (size_t n = 1; n < 10 * RATE; ++n) {
+    if (n % 10 == 0) {
+      plugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+    }
+
+    Sample sample = makeSample(n);
+    romea::core::ObservationAngularSpeed angularSpeed;
+    if (computeAngularSpeed(plugin, sample, angularSpeed)) {
+      // first integrated sample is held over one sampling period as well
+      observedAngle += angularSpeed.Y() / RATE;
+      ++numberOfObservations;
+    }
+
+    // delta angles popped at 20 Hz
+    if (n % 5 == 0 && plugin.popDeltaAngles(deltaAngles)) {
+      // moving average bias has no variance, only white noise is integrated
+      EXPECT_LE(deltaAngles.numberOfSamples, 5u);
+      EXPECT_NEAR(
+        deltaAngles.R(2, 2),
+        angularSpeedVariance * deltaAngles.numberOfSamples / (RATE * RATE),
+        1e-20);
+      numberOfIntegratedSamples += deltaAngles.numberOfSamples;
+      integratedAngle += deltaAngles.Y(2);
+    }
+  }
+
+  // last samples are popped in two parts, cut between two samples
+  const romea::core::Duration stamp = romea::core::durationFromSecond((10 * RATE - 3.5) / RATE);
+  ASSERT_TRUE(plugin.popDeltaAngles(stamp, deltaAngles));
+  EXPECT_EQ(deltaAngles.stopStamp, stamp);
+  numberOfIntegratedSamples += deltaAngles.numberOfSamples;
+  integratedAngle += deltaAngles.Y(2);
+  while (plugin.popDeltaAngles(deltaAngles)) {
+    numberOfIntegratedSamples += deltaAngles.numberOfSamples;
+    integratedAngle += deltaAngles.Y(2);
+  }
+
+  ASSERT_GT(numberOfObservations, 0u);
+  EXPECT_EQ(numberOfIntegratedSamples, numberOfObservations);
+  EXPECT_NEAR(integratedAngle, observedAngle, 1e-9);
+
+  romea::core::LocalisationIMUPlugin defaultPlugin(makeIMU());
+  EXPECT_FALSE(defaultPlugin.popDeltaAngles(deltaAngles));
+  EXPECT_FALSE(defaultPlugin.popDeltaAngles(romea::core::durationFromSecond(1.), deltaAngles));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, batchedDeltaAnglesMatchSampleBySample)
+{
+  romea::core::BasicLocalisationIMUPlugin<AngularSpeedIntegrationStages> plugin(makeIMU());
+  romea::core::BasicLocalisationIMUPlugin<AngularSpeedIntegrationStages> batchPlugin(makeIMU());
+
+  const size_t batchSize = 10;
+  const size_t numberOfSamples = 10 * RATE;
+  Columns columns = makeColumns(numberOfSamples);
+
+  // biases change at each standstill sample, each one is corrected by its own biases
+  size_t numberOfPoppedDeltaAngles = 0;
+  std::vector<romea::core::ObservationAngularSpeed> angularSpeeds(batchSize);
+  bool validities[batchSize];
+  for (size_t begin = 0; begin < numberOfSamples; begin += batchSize) {
+    const romea::core::Duration stamp =
+      columns.stamps[begin] - romea::core::durationFromSecond(0.5 / RATE);
+    plugin.processLinearSpeed(stamp, 0.);
+    batchPlugin.processLinearSpeed(stamp, 0.);
+
+    batchPlugin.computeAngularSpeeds(
+      columns.makeBatch(begin, batchSize), angularSpeeds.data(), validities);
+    for (size_t k = 0; k < batchSize; ++k) {
+      plugin.computeAngularSpeeds(
+        columns.makeBatch(begin + k, 1), angularSpeeds.data(), validities);
+    }
+
+    romea::core::DeltaAngles deltaAngles;
+    romea::core::DeltaAngles batchDeltaAngles;
+    const bool isPopped = plugin.popDeltaAngles(deltaAngles);
+    ASSERT_EQ(batchPlugin.popDeltaAngles(batchDeltaAngles), isPopped);
+    if (isPopped) {
+      ++numberOfPoppedDeltaAngles;
+      EXPECT_EQ(batchDeltaAngles.numberOfSamples, deltaAngles.numberOfSamples);
+      EXPECT_EQ(batchDeltaAngles.Y, deltaAngles.Y);
+    }
+  }
+  EXPECT_GT(numberOfPoppedDeltaAngles, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, spikesAreReplacedBeforeRangeCheckup)
+{
+  romea::core::BasicLocalisationIMUPlugin<SpikeRejectionStages> plugin(makeIMU());
+  romea::core::LocalisationIMUPlugin defaultPlugin(makeIMU());
+
+  romea::core::ObservationAngularSpeed angularSpeed;
+  romea::core::ObservationAngularSpeed defaultAngularSpeed;
+  for (size_t n = 1; n < 10 * RATE; ++n) {
+    if (n % 10 == 0) {
+      plugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+      defaultPlugin.processLinearSpeed(romea::core::durationFromSecond(n / RATE), 0.);
+    }
+
+    Sample sample = makeSample(n);
+    EXPECT_EQ(
+      computeAngularSpeed(defaultPlugin, sample, defaultAngularSpeed),
+      computeAngularSpeed(plugin, sample, angularSpeed));
+  }
+
+  // angular speed spike beyond sensor range
+  Sample sample = makeSample(10 * RATE);
+  sample.values[5] = 10.;
+  EXPECT_TRUE(computeAngularSpeed(plugin, sample, angularSpeed));
+  EXPECT_NEAR(angularSpeed.Y(), 0., 0.01);
+  EXPECT_FALSE(computeAngularSpeed(defaultPlugin, sample, defaultAngularSpeed));
+
+  auto report = plugin.makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  EXPECT_EQ(report.info["angular_speed_spikes"], "1");
+  EXPECT_EQ(report.info["acceleration_spikes"], "0");
+
+  auto defaultReport = defaultPlugin.makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  EXPECT_EQ(defaultReport.info.count("angular_speed_spikes"), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPluginStages, latencyHistograms)
+{
+  using romea::core::LatencyStage;
+  romea::core::BasicLocalisationIMUPlugin<TimedStages> plugin(makeIMU());
+
+  const size_t numberOfSamples = 10 * RATE;
+  romea::core::ObservationAngularSpeed angularSpeed;
+  romea::core::ObservationAttitude attitude;
+  for (size_t n = 0; n < numberOfSamples; ++n) {
+    Sample sample = makeSample(n);
+    computeAngularSpeed(plugin, sample, angularSpeed);
+    plugin.computeAttitude(sample.stamp, 0., 0., 0., attitude);
+  }
+
+  // rate checkups reject samples until rate is estimated, other stages only see accepted ones
+  EXPECT_EQ(
+    plugin.getLatencyHistogram(LatencyStage::INERTIAL_MEASUREMENT_RATE_CHECKUP).getCount(),
+    numberOfSamples);
+  EXPECT_EQ(
+    plugin.getLatencyHistogram(LatencyStage::ATTITUDE_RATE_CHECKUP).getCount(),
+    numberOfSamples);
+  EXPECT_GT(plugin.getLatencyHistogram(LatencyStage::ANGULAR_SPEED_BIAS_ESTIMATION).getCount(), 0u);
+  EXPECT_GT(plugin.getLatencyHistogram(LatencyStage::ATTITUDE_CHECKUP).getCount(), 0u);
+  EXPECT_EQ(plugin.getLatencyHistogram(LatencyStage::REPORT).getCount(), 0u);
+
+  plugin.makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  auto report = plugin.makeDiagnosticReport(romea::core::durationFromSecond(10.));
+  EXPECT_EQ(plugin.getLatencyHistogram(LatencyStage::HEART_BEATS).getCount(), 2u);
+  EXPECT_EQ(plugin.getLatencyHistogram(LatencyStage::REPORT).getCount(), 2u);
+  EXPECT_EQ(report.info.count("latency_inertial_measurement_frames_p50_ns"), 1u);
+  EXPECT_EQ(report.info.count("latency_angular_speed_bias_estimation_p99_ns"), 1u);
+  EXPECT_EQ(report.info.count("latency_attitude_checkup_max_ns"), 1u);
+  EXPECT_EQ(report.info.count("latency_report_p50_ns"), 1u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
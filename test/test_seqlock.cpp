@@ -0,0 +1,77 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <atomic>
+#include <thread>
+
+// romea
+#include "romea_core_localisation_imu/SeqLock.hpp"
+
+struct Values
+{
+  double a;
+  double b;
+  int c;
+};
+
+//-----------------------------------------------------------------------------
+TEST(TestSeqLock, storeAndLoad)
+{
+  romea::core::SeqLock<Values> seqlock({1., 2., 3});
+  EXPECT_DOUBLE_EQ(seqlock.load().a, 1.);
+  EXPECT_DOUBLE_EQ(seqlock.load().b, 2.);
+  EXPECT_EQ(seqlock.load().c, 3);
+
+  seqlock.update([](Values & values) {values.c = 4;});
+  EXPECT_DOUBLE_EQ(seqlock.load().a, 1.);
+  EXPECT_EQ(seqlock.load().c, 4);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSeqLock, readersNeverSeeTornValues)
+{
+  romea::core::SeqLock<Values> seqlock({0., 0., 0});
+  std::atomic<bool> stop(false);
+  std::atomic<size_t> numberOfTornValues(0);
+
+  std::thread reader([&]() {
+      while (!stop.load()) {
+        Values values = seqlock.load();
+        if (values.a != values.b || values.a != values.c) {
+          ++numberOfTornValues;
+        }
+      }
+    });
+
+  for (int n = 0; n < 200000; ++n) {
+    seqlock.store({static_cast<double>(n), static_cast<double>(n), n});
+  }
+  stop.store(true);
+  reader.join();
+
+  EXPECT_EQ(numberOfTornValues.load(), 0u);
+  EXPECT_EQ(seqlock.load().c, 199999);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,177 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/LocalisationIMUPlugin.hpp"
+#include "romea_core_localisation_imu/SessionReader.hpp"
+#include "romea_core_localisation_imu/SessionWriter.hpp"
+
+using romea::core::durationFromSecond;
+
+class TestSession : public ::testing::Test
+{
+public:
+  TestSession()
+  : filename(::testing::TempDir() + "session.bin")
+  {
+  }
+
+  void TearDown() override
+  {
+    std::remove(filename.c_str());
+  }
+
+  void write(const size_t & numberOfSamples)
+  {
+    romea::core::SessionWriter writer(filename);
+    for (size_t n = 0; n < numberOfSamples; ++n) {
+      double t = n * 0.01;
+      writer.addInertialMeasurements(
+        durationFromSecond(t), 1e-4 * (n % 3), 0., 9.81, 1e-6 * (n % 2), 0., 0.001);
+      if (n % 2 == 0) {
+        writer.addAttitude(durationFromSecond(t), 0.01, -0.01, t);
+      }
+      if (n % 10 == 0) {
+        writer.addLinearSpeed(durationFromSecond(t), 0.);
+      }
+    }
+    writer.close();
+  }
+
+  std::string filename;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSession, writeAndRead)
+{
+  write(1000);
+  romea::core::SessionReader reader(filename);
+  ASSERT_EQ(reader.getNumberOfInertialMeasurements(), 1000u);
+  ASSERT_EQ(reader.getNumberOfAttitudes(), 500u);
+  ASSERT_EQ(reader.getNumberOfLinearSpeeds(), 100u);
+
+  auto measurements = reader.getInertialMeasurements();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(measurements.accelerationsAlongXAxis) % 64, 0u);
+  for (size_t n = 0; n < 1000; ++n) {
+    EXPECT_EQ(measurements.stamps[n], durationFromSecond(n * 0.01));
+    EXPECT_DOUBLE_EQ(measurements.accelerationsAlongXAxis[n], 1e-4 * (n % 3));
+    EXPECT_DOUBLE_EQ(measurements.angularSpeedsAroundXAxis[n], 1e-6 * (n % 2));
+    EXPECT_DOUBLE_EQ(measurements.angularSpeedsAroundZAxis[n], 0.001);
+  }
+
+  auto attitudes = reader.getAttitudes(10, 20);
+  ASSERT_EQ(attitudes.size, 10u);
+  EXPECT_EQ(attitudes.stamps[0], durationFromSecond(0.2));
+  EXPECT_DOUBLE_EQ(attitudes.courseAngles[0], 0.2);
+
+  auto linearSpeeds = reader.getLinearSpeeds(95);
+  ASSERT_EQ(linearSpeeds.size, 5u);
+  EXPECT_EQ(linearSpeeds.stamps[4], durationFromSecond(9.9));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSession, emptySession)
+{
+  write(0);
+  romea::core::SessionReader reader(filename);
+  EXPECT_EQ(reader.getNumberOfInertialMeasurements(), 0u);
+  EXPECT_EQ(reader.getInertialMeasurements().size, 0u);
+  EXPECT_EQ(reader.getLinearSpeeds().size, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSession, rejectInvalidFiles)
+{
+  EXPECT_THROW(romea::core::SessionReader reader(filename), std::runtime_error);
+
+  write(100);
+  std::vector<char> content;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), content.size() - 64);
+  }
+  EXPECT_THROW(romea::core::SessionReader reader(filename), std::runtime_error);
+
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    content[0] = 'X';
+    file.write(content.data(), content.size());
+  }
+  EXPECT_THROW(romea::core::SessionReader reader(filename), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSession, pluginConsumesMappedBatches)
+{
+  write(2000);
+  romea::core::SessionReader reader(filename);
+
+  auto imu = std::make_unique<romea::core::IMUAHRS>(
+    100,
+    0.0005, 0.02, 10.,
+    3.4907e-04 / 180. * M_PI, 3.4907e-02 / 180. * M_PI, 300. / 180. * M_PI,
+    7.e-09, 1.e-08, 0.000075,
+    0.01745);
+  romea::core::LocalisationIMUPlugin plugin(std::move(imu));
+
+  // replay session by chunks of one second, odometry first
+  auto linearSpeeds = reader.getLinearSpeeds();
+  std::vector<romea::core::ObservationAngularSpeed> angularSpeeds(100);
+  std::unique_ptr<bool[]> validities(new bool[100]);
+  size_t numberOfObservations = 0;
+  size_t linearSpeedIndex = 0;
+  for (size_t begin = 0; begin < reader.getNumberOfInertialMeasurements(); begin += 100) {
+    auto measurements = reader.getInertialMeasurements(begin, begin + 100);
+    while (linearSpeedIndex < linearSpeeds.size &&
+      linearSpeeds.stamps[linearSpeedIndex] <= measurements.stamps[measurements.size - 1])
+    {
+      plugin.processLinearSpeed(
+        linearSpeeds.stamps[linearSpeedIndex],
+        linearSpeeds.linearSpeeds[linearSpeedIndex]);
+      ++linearSpeedIndex;
+    }
+
+    numberOfObservations += plugin.computeAngularSpeeds(
+      measurements, angularSpeeds.data(), validities.get());
+  }
+
+  // constant angular speed is removed once bias has been estimated
+  EXPECT_GT(numberOfObservations, 0u);
+  EXPECT_NEAR(angularSpeeds.back().Y(), 0., 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
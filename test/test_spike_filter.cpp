@@ -0,0 +1,204 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <random>
+
+// romea
+#include "romea_core_localisation_imu/SpikeFilter.hpp"
+
+using romea::core::AccelerationsFrame;
+using romea::core::AngularSpeedsFrame;
+using romea::core::SpikeFilter;
+
+class TestSpikeFilter : public ::testing::Test
+{
+public:
+  TestSpikeFilter()
+  : accelerationStd(0.01),
+    angularSpeedStd(0.001),
+    filter(accelerationStd, angularSpeedStd),
+    generator(0),
+    accelerationDistribution(0., accelerationStd),
+    angularSpeedDistribution(0., angularSpeedStd)
+  {
+  }
+
+  AccelerationsFrame makeAccelerations()
+  {
+    return {accelerationDistribution(generator),
+      accelerationDistribution(generator),
+      9.81 + accelerationDistribution(generator)};
+  }
+
+  AngularSpeedsFrame makeAngularSpeeds()
+  {
+    return {angularSpeedDistribution(generator),
+      angularSpeedDistribution(generator),
+      angularSpeedDistribution(generator)};
+  }
+
+  double accelerationStd;
+  double angularSpeedStd;
+  SpikeFilter filter;
+  std::default_random_engine generator;
+  std::normal_distribution<double> accelerationDistribution;
+  std::normal_distribution<double> angularSpeedDistribution;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSpikeFilter, samplesPassThroughUntilWindowIsFull)
+{
+  for (size_t n = 0; n < SpikeFilter::WINDOW_SIZE; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = {0., 0., n == 2 ? 1. : 0.};
+    EXPECT_FALSE(filter.filter(accelerations, angularSpeeds));
+    EXPECT_DOUBLE_EQ(angularSpeeds.angularSpeedAroundZAxis, n == 2 ? 1. : 0.);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSpikeFilter, noiseIsNotFiltered)
+{
+  for (size_t n = 0; n < 100000; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    AccelerationsFrame filteredAccelerations = accelerations;
+    AngularSpeedsFrame filteredAngularSpeeds = angularSpeeds;
+    ASSERT_FALSE(filter.filter(filteredAccelerations, filteredAngularSpeeds));
+    EXPECT_EQ(filteredAccelerations.accelerationAlongZAxis, accelerations.accelerationAlongZAxis);
+    EXPECT_EQ(filteredAngularSpeeds.angularSpeedAroundZAxis, angularSpeeds.angularSpeedAroundZAxis);
+  }
+
+  romea::core::DiagnosticReport report = filter.getReport();
+  EXPECT_EQ(report.info["acceleration_spikes"], "0");
+  EXPECT_EQ(report.info["angular_speed_spikes"], "0");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSpikeFilter, spikesAreReplacedByMedian)
+{
+  for (size_t n = 0; n < 10; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    filter.filter(accelerations, angularSpeeds);
+  }
+
+  uint32_t version = filter.getReportVersion();
+  AccelerationsFrame accelerations = makeAccelerations();
+  AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+  const double accelerationAlongXAxis = accelerations.accelerationAlongXAxis;
+  angularSpeeds.angularSpeedAroundYAxis += 5.;
+  EXPECT_TRUE(filter.filter(accelerations, angularSpeeds));
+
+  // only the spiking channel is replaced
+  EXPECT_NEAR(angularSpeeds.angularSpeedAroundYAxis, 0., 3 * angularSpeedStd);
+  EXPECT_DOUBLE_EQ(accelerations.accelerationAlongXAxis, accelerationAlongXAxis);
+  EXPECT_NE(filter.getReportVersion(), version);
+
+  accelerations = makeAccelerations();
+  angularSpeeds = makeAngularSpeeds();
+  accelerations.accelerationAlongZAxis = -50.;
+  EXPECT_TRUE(filter.filter(accelerations, angularSpeeds));
+  EXPECT_NEAR(accelerations.accelerationAlongZAxis, 9.81, 3 * accelerationStd);
+
+  romea::core::DiagnosticReport report = filter.getReport();
+  EXPECT_EQ(report.info["acceleration_spikes"], "1");
+  EXPECT_EQ(report.info["angular_speed_spikes"], "1");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSpikeFilter, stepsAreFollowedAfterHalfWindow)
+{
+  for (size_t n = 0; n < 10; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    filter.filter(accelerations, angularSpeeds);
+  }
+
+  // step of one rad/s, first samples look like spikes until they are the majority of window
+  for (size_t n = 0; n < 10; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    angularSpeeds.angularSpeedAroundZAxis += 1.;
+    EXPECT_EQ(filter.filter(accelerations, angularSpeeds), n < SpikeFilter::WINDOW_SIZE / 2);
+    if (n >= SpikeFilter::WINDOW_SIZE / 2) {
+      EXPECT_NEAR(angularSpeeds.angularSpeedAroundZAxis, 1., 6 * angularSpeedStd);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSpikeFilter, consecutiveSpikesAreReplaced)
+{
+  for (size_t n = 0; n < 10; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    filter.filter(accelerations, angularSpeeds);
+  }
+
+  for (size_t n = 0; n < 2; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    angularSpeeds.angularSpeedAroundXAxis = n == 0 ? 3. : -3.;
+    EXPECT_TRUE(filter.filter(accelerations, angularSpeeds));
+    EXPECT_NEAR(angularSpeeds.angularSpeedAroundXAxis, 0., 3 * angularSpeedStd);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSpikeFilter, windowIsRefilledAfterReset)
+{
+  for (size_t n = 0; n < 10; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    filter.filter(accelerations, angularSpeeds);
+  }
+
+  // samples received after a gap are not compared to samples received before it
+  filter.reset();
+  for (size_t n = 0; n < 10; ++n) {
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    angularSpeeds.angularSpeedAroundZAxis += 1.;
+    EXPECT_FALSE(filter.filter(accelerations, angularSpeeds));
+    EXPECT_NEAR(angularSpeeds.angularSpeedAroundZAxis, 1., 6 * angularSpeedStd);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestSpikeFilter, sampleFillingWindowIsChecked)
+{
+  // at startup and after a reset, spikes are caught as soon as a full window is available
+  for (size_t reset = 0; reset < 2; ++reset) {
+    for (size_t n = 0; n + 1 < SpikeFilter::WINDOW_SIZE; ++n) {
+      AccelerationsFrame accelerations = makeAccelerations();
+      AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+      EXPECT_FALSE(filter.filter(accelerations, angularSpeeds));
+    }
+
+    AccelerationsFrame accelerations = makeAccelerations();
+    AngularSpeedsFrame angularSpeeds = makeAngularSpeeds();
+    angularSpeeds.angularSpeedAroundYAxis += 5.;
+    EXPECT_TRUE(filter.filter(accelerations, angularSpeeds));
+    EXPECT_NEAR(angularSpeeds.angularSpeedAroundYAxis, 0., 3 * angularSpeedStd);
+    filter.reset();
+  }
+}
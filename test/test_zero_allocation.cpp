@@ -0,0 +1,185 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// gtest
+#include <gtest/gtest.h>
+
+// std
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/LocalisationIMUPlugin.hpp"
+
+// local
+#include "allocation_counter.hpp"
+
+class TestZeroAllocation : public ::testing::Test
+{
+public:
+  TestZeroAllocation()
+  : rate(100.),
+    generator(0),
+    accelerationDistribution(0, 0.0005 * std::sqrt(rate)),
+    angularSpeedDistribution(0, 3.4907e-04 * std::sqrt(rate) / 180. * M_PI),
+    attitudeDistribution(0, 0.01745),
+    n(0),
+    plugin(nullptr)
+  {
+  }
+
+  void SetUp() override
+  {
+    auto imu = std::make_unique<romea::core::IMUAHRS>(
+      rate,
+      0.0005, 0.02, 10.,
+      3.4907e-04 / 180. * M_PI, 3.4907e-02 / 180. * M_PI, 300. / 180. * M_PI,
+      7.e-09, 1.e-08, 0.000075,
+      0.01745);
+
+    plugin = std::make_unique<romea::core::LocalisationIMUPlugin>(std::move(imu));
+  }
+
+  romea::core::Duration stamp()const
+  {
+    return romea::core::durationFromSecond(n / rate);
+  }
+
+  bool step()
+  {
+    if (n % 10 == 0) {
+      plugin->processLinearSpeed(stamp(), 0.);
+    }
+
+    bool hasAngularSpeed = plugin->computeAngularSpeed(
+      stamp(),
+      accelerationDistribution(generator),
+      accelerationDistribution(generator),
+      accelerationDistribution(generator) + 9.81,
+      angularSpeedDistribution(generator),
+      angularSpeedDistribution(generator),
+      angularSpeedDistribution(generator),
+      angularSpeedObs);
+
+    bool hasAttitude = plugin->computeAttitude(
+      stamp(),
+      attitudeDistribution(generator),
+      attitudeDistribution(generator),
+      attitudeDistribution(generator),
+      attitudeObs);
+
+    ++n;
+    return hasAngularSpeed && hasAttitude;
+  }
+
+  void warmUp()
+  {
+    while (!step()) {
+      ASSERT_LT(n, 20 * rate);
+    }
+  }
+
+  double rate;
+  std::default_random_engine generator;
+  std::normal_distribution<double> accelerationDistribution;
+  std::normal_distribution<double> angularSpeedDistribution;
+  std::normal_distribution<double> attitudeDistribution;
+  size_t n;
+
+  romea::core::ObservationAngularSpeed angularSpeedObs;
+  romea::core::ObservationAttitude attitudeObs;
+  std::unique_ptr<romea::core::LocalisationIMUPlugin> plugin;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestZeroAllocation, overAlignedAllocationsAreCounted)
+{
+  struct alignas(64) Row
+  {
+    double values[8];
+  };
+
+  size_t numberOfAllocationsBefore = getNumberOfAllocations();
+  auto row = std::make_unique<Row>();
+  auto rows = std::make_unique<Row[]>(3);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(row.get()) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(rows.get()) % 64, 0u);
+  EXPECT_EQ(getNumberOfAllocations() - numberOfAllocationsBefore, 2u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestZeroAllocation, steadyStateSamplePathsDoNotAllocate)
+{
+  warmUp();
+
+  size_t numberOfAllocationsBefore = getNumberOfAllocations();
+  for (size_t k = 0; k < 10 * rate; ++k) {
+    EXPECT_TRUE(step());
+  }
+  EXPECT_EQ(getNumberOfAllocations() - numberOfAllocationsBefore, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestZeroAllocation, steadyStateBatchPathDoesNotAllocate)
+{
+  warmUp();
+
+  const size_t burstSize = 40;
+  std::vector<romea::core::Duration> stamps(burstSize);
+  std::vector<double> channels[6];
+  for (auto & channel : channels) {
+    channel.resize(burstSize);
+  }
+  std::vector<romea::core::ObservationAngularSpeed> observations(burstSize);
+  std::unique_ptr<bool[]> validities(new bool[burstSize]);
+
+  romea::core::InertialMeasurementsBatch measurements;
+  measurements.size = burstSize;
+  measurements.stamps = stamps.data();
+  measurements.accelerationsAlongXAxis = channels[0].data();
+  measurements.accelerationsAlongYAxis = channels[1].data();
+  measurements.accelerationsAlongZAxis = channels[2].data();
+  measurements.angularSpeedsAroundXAxis = channels[3].data();
+  measurements.angularSpeedsAroundYAxis = channels[4].data();
+  measurements.angularSpeedsAroundZAxis = channels[5].data();
+
+  size_t numberOfAllocationsBefore = getNumberOfAllocations();
+  for (size_t burst = 0; burst < 20; ++burst) {
+    for (size_t k = 0; k < burstSize; ++k, ++n) {
+      stamps[k] = stamp();
+      channels[0][k] = accelerationDistribution(generator);
+      channels[1][k] = accelerationDistribution(generator);
+      channels[2][k] = accelerationDistribution(generator) + 9.81;
+      channels[3][k] = angularSpeedDistribution(generator);
+      channels[4][k] = angularSpeedDistribution(generator);
+      channels[5][k] = angularSpeedDistribution(generator);
+    }
+    plugin->processLinearSpeed(stamps.back(), 0.);
+    EXPECT_EQ(
+      plugin->computeAngularSpeeds(measurements, observations.data(), validities.get()),
+      burstSize);
+  }
+  EXPECT_EQ(getNumberOfAllocations() - numberOfAllocationsBefore, 0u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,586 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Replay recorded IMU, odometry and attitude streams through LocalisationIMUPlugin
+// as fast as possible, write emitted observations and diagnostics, report throughput.
+
+// std
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_localisation_imu/DebugLogReader.hpp"
+#include "romea_core_localisation_imu/LocalisationIMUPlugin.hpp"
+#include "romea_core_localisation_imu/SessionReader.hpp"
+#include "romea_core_localisation_imu/SessionWriter.hpp"
+
+namespace
+{
+
+using romea::core::DebugLogRecord;
+using romea::core::DiagnosticStatus;
+using romea::core::Duration;
+
+const char USAGE[] =
+  "usage: romea_core_localisation_imu_replay --imu-config FILE [inputs] [options]\n"
+  "\n"
+  "inputs, either a binary debug log recorded by LocalisationIMUPlugin::enableDebugLog:\n"
+  "  --debug-log FILE               records are replayed in recorded order\n"
+  "  --imu-index INDEX              IMU replayed from a multi IMU debug log (default 0)\n"
+  "or a session file written by SessionWriter (or by --write-session):\n"
+  "  --session FILE                 streams are merged in stamp order\n"
+  "or CSV files (first column is stamp in seconds), merged in stamp order:\n"
+  "  --inertial-measurements FILE   stamp,ax,ay,az,wx,wy,wz\n"
+  "  --linear-speeds FILE           stamp,linear_speed\n"
+  "  --attitudes FILE               stamp,roll,pitch,course\n"
+  "\n"
+  "options:\n"
+  "  --output PREFIX                write PREFIX_angular_speeds.csv, PREFIX_attitudes.csv\n"
+  "                                 and PREFIX_diagnostics.csv\n"
+  "  --diagnostic-period SECONDS    diagnostic report period in stamp time (default 1)\n"
+  "  --write-session FILE           also convert replayed inputs into a session file\n"
+  "  --compare-float TOLERANCE      also replay through a plugin estimating biases in float and\n"
+  "                                 fail when angular speeds differ by more than TOLERANCE rad/s\n"
+  "\n"
+  "imu config file contains key=value lines: rate, acceleration_noise_density,\n"
+  "acceleration_bias_stability, acceleration_range, angular_speed_noise_density,\n"
+  "angular_speed_bias_stability, angular_speed_range, magnetic_noise_density,\n"
+  "magnetic_bias_stability, magnetic_range, angle_std\n";
+
+// default pipeline with angular speed bias windows stored as float
+struct FloatStages : romea::core::LocalisationIMUPluginStages
+{
+  using Scalar = float;
+};
+
+const char * IMU_PARAMETERS[] = {
+  "rate",
+  "acceleration_noise_density",
+  "acceleration_bias_stability",
+  "acceleration_range",
+  "angular_speed_noise_density",
+  "angular_speed_bias_stability",
+  "angular_speed_range",
+  "magnetic_noise_density",
+  "magnetic_bias_stability",
+  "magnetic_range",
+  "angle_std"};
+
+// replayed samples are stored as debug log records whatever their source
+using Sample = DebugLogRecord;
+
+class SampleSource
+{
+public:
+  virtual ~SampleSource() = default;
+  virtual bool read(Sample & sample) = 0;
+};
+
+class DebugLogSampleSource : public SampleSource
+{
+public:
+  DebugLogSampleSource(const std::string & filename, const uint32_t & imuIndex)
+  : reader_(filename),
+    imuIndex_(imuIndex)
+  {
+  }
+
+  bool read(Sample & sample) override
+  {
+    while (reader_.read(sample)) {
+      if (sample.type == DebugLogRecord::LINEAR_SPEED ||
+        (sample.source == imuIndex_ &&
+        (sample.type == DebugLogRecord::INERTIAL_MEASUREMENTS ||
+        sample.type == DebugLogRecord::ATTITUDE_ANGLES)))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  romea::core::DebugLogReader reader_;
+  uint32_t imuIndex_;
+};
+
+class SessionSampleSource : public SampleSource
+{
+public:
+  SessionSampleSource(
+    std::shared_ptr<const romea::core::SessionReader> reader,
+    const DebugLogRecord::Type & type)
+  : reader_(std::move(reader)),
+    type_(type),
+    index_(0)
+  {
+  }
+
+  bool read(Sample & sample) override
+  {
+    sample = Sample();
+    sample.type = type_;
+    std::fill(std::begin(sample.values), std::end(sample.values),
+      std::numeric_limits<double>::quiet_NaN());
+
+    if (type_ == DebugLogRecord::INERTIAL_MEASUREMENTS) {
+      auto batch = reader_->getInertialMeasurements(index_, index_ + 1);
+      if (batch.size == 0) {
+        return false;
+      }
+      sample.stamp = batch.stamps[0].count();
+      sample.values[0] = batch.accelerationsAlongXAxis[0];
+      sample.values[1] = batch.accelerationsAlongYAxis[0];
+      sample.values[2] = batch.accelerationsAlongZAxis[0];
+      sample.values[3] = batch.angularSpeedsAroundXAxis[0];
+      sample.values[4] = batch.angularSpeedsAroundYAxis[0];
+      sample.values[5] = batch.angularSpeedsAroundZAxis[0];
+    } else if (type_ == DebugLogRecord::ATTITUDE_ANGLES) {
+      auto batch = reader_->getAttitudes(index_, index_ + 1);
+      if (batch.size == 0) {
+        return false;
+      }
+      sample.stamp = batch.stamps[0].count();
+      sample.values[0] = batch.rollAngles[0];
+      sample.values[1] = batch.pitchAngles[0];
+      sample.values[2] = batch.courseAngles[0];
+    } else {
+      auto batch = reader_->getLinearSpeeds(index_, index_ + 1);
+      if (batch.size == 0) {
+        return false;
+      }
+      sample.stamp = batch.stamps[0].count();
+      sample.values[0] = batch.linearSpeeds[0];
+    }
+
+    ++index_;
+    return true;
+  }
+
+private:
+  std::shared_ptr<const romea::core::SessionReader> reader_;
+  DebugLogRecord::Type type_;
+  size_t index_;
+};
+
+class CsvSampleSource : public SampleSource
+{
+public:
+  CsvSampleSource(
+    const std::string & filename,
+    const DebugLogRecord::Type & type,
+    const size_t & numberOfValues)
+  : file_(filename),
+    filename_(filename),
+    type_(type),
+    numberOfValues_(numberOfValues),
+    lineNumber_(0),
+    line_()
+  {
+    if (!file_) {
+      throw std::runtime_error("Unable to open " + filename);
+    }
+  }
+
+  bool read(Sample & sample) override
+  {
+    while (std::getline(file_, line_)) {
+      ++lineNumber_;
+      // skip empty lines, comments and header
+      size_t begin = line_.find_first_not_of(" \t\r");
+      if (begin == std::string::npos || line_[begin] == '#' ||
+        (lineNumber_ == 1 && std::isalpha(static_cast<unsigned char>(line_[begin]))))
+      {
+        continue;
+      }
+
+      const char * cursor = line_.c_str() + begin;
+      sample = Sample();
+      sample.type = type_;
+      sample.stamp = romea::core::durationFromSecond(parse_(cursor)).count();
+      for (size_t n = 0; n < DebugLogRecord::NUMBER_OF_VALUES; ++n) {
+        sample.values[n] = n < numberOfValues_ ?
+          parse_(cursor) : std::numeric_limits<double>::quiet_NaN();
+      }
+      return true;
+    }
+    return false;
+  }
+
+private:
+  double parse_(const char * & cursor)
+  {
+    while (*cursor == ',' || *cursor == ' ' || *cursor == '\t') {
+      ++cursor;
+    }
+
+    char * end;
+    double value = std::strtod(cursor, &end);
+    if (end == cursor) {
+      throw std::runtime_error(
+              "Unable to parse " + filename_ + " line " + std::to_string(lineNumber_));
+    }
+    cursor = end;
+    return value;
+  }
+
+private:
+  std::ifstream file_;
+  std::string filename_;
+  DebugLogRecord::Type type_;
+  size_t numberOfValues_;
+  size_t lineNumber_;
+  std::string line_;
+};
+
+// merge several sources in stamp order, samples with same stamp keep source order
+class SampleStream
+{
+public:
+  void add(std::unique_ptr<SampleSource> source)
+  {
+    Sample sample;
+    if (source->read(sample)) {
+      sources_.push_back(std::move(source));
+      samples_.push_back(sample);
+    }
+  }
+
+  bool read(Sample & sample)
+  {
+    if (sources_.empty()) {
+      return false;
+    }
+
+    size_t next = 0;
+    for (size_t n = 1; n < sources_.size(); ++n) {
+      if (samples_[n].stamp < samples_[next].stamp) {
+        next = n;
+      }
+    }
+
+    sample = samples_[next];
+    if (!sources_[next]->read(samples_[next])) {
+      sources_.erase(sources_.begin() + next);
+      samples_.erase(samples_.begin() + next);
+    }
+    return true;
+  }
+
+private:
+  std::vector<std::unique_ptr<SampleSource>> sources_;
+  std::vector<Sample> samples_;
+};
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<romea::core::IMUAHRS> loadIMU(const std::string & filename)
+{
+  std::ifstream file(filename);
+  if (!file) {
+    throw std::runtime_error("Unable to open " + filename);
+  }
+
+  std::map<std::string, double> parameters;
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t separator = line.find('=');
+    if (line.empty() || line[0] == '#' || separator == std::string::npos) {
+      continue;
+    }
+
+    std::string key = line.substr(0, separator);
+    key.erase(key.find_last_not_of(" \t") + 1);
+    key.erase(0, key.find_first_not_of(" \t"));
+    parameters[key] = std::stod(line.substr(separator + 1));
+  }
+
+  std::vector<double> values;
+  for (const char * name : IMU_PARAMETERS) {
+    auto it = parameters.find(name);
+    if (it == parameters.end()) {
+      throw std::runtime_error(std::string("Missing IMU parameter ") + name + " in " + filename);
+    }
+    values.push_back(it->second);
+  }
+
+  return std::make_unique<romea::core::IMUAHRS>(
+    values[0], values[1], values[2], values[3], values[4], values[5],
+    values[6], values[7], values[8], values[9], values[10]);
+}
+
+//-----------------------------------------------------------------------------
+const char * toString(const DiagnosticStatus & status)
+{
+  switch (status) {
+    case DiagnosticStatus::OK:
+      return "OK";
+    case DiagnosticStatus::WARN:
+      return "WARN";
+    case DiagnosticStatus::ERROR:
+      return "ERROR";
+    default:
+      return "STALE";
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::ostream & writeStamp(std::ostream & os, const Duration & stamp)
+{
+  return os << std::fixed << std::setprecision(9) << romea::core::durationToSecond(stamp) <<
+         std::defaultfloat << std::setprecision(10);
+}
+
+//-----------------------------------------------------------------------------
+std::ofstream openOutput(const std::string & filename, const std::string & header)
+{
+  std::ofstream file(filename);
+  if (!file) {
+    throw std::runtime_error("Unable to open " + filename);
+  }
+  file << header << "\n";
+  return file;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  std::map<std::string, std::string> arguments;
+  for (int n = 1; n < argc; ++n) {
+    std::string argument = argv[n];
+    if (argument.rfind("--", 0) != 0 || n + 1 == argc) {
+      std::cerr << USAGE;
+      return EXIT_FAILURE;
+    }
+    arguments[argument] = argv[++n];
+  }
+
+  if (arguments.count("--imu-config") == 0 ||
+    (arguments.count("--debug-log") == 0 &&
+    arguments.count("--session") == 0 &&
+    arguments.count("--inertial-measurements") == 0))
+  {
+    std::cerr << USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    romea::core::LocalisationIMUPlugin plugin(loadIMU(arguments["--imu-config"]));
+
+    std::unique_ptr<romea::core::BasicLocalisationIMUPlugin<FloatStages>> floatPlugin;
+    double floatTolerance = 0.;
+    if (arguments.count("--compare-float")) {
+      floatPlugin = std::make_unique<romea::core::BasicLocalisationIMUPlugin<FloatStages>>(
+        loadIMU(arguments["--imu-config"]));
+      floatTolerance = std::stod(arguments["--compare-float"]);
+    }
+
+    SampleStream stream;
+    if (arguments.count("--debug-log")) {
+      uint32_t imuIndex = arguments.count("--imu-index") ?
+        static_cast<uint32_t>(std::stoul(arguments["--imu-index"])) : 0;
+      stream.add(std::make_unique<DebugLogSampleSource>(arguments["--debug-log"], imuIndex));
+    }
+    if (arguments.count("--session")) {
+      auto reader = std::make_shared<const romea::core::SessionReader>(arguments["--session"]);
+      stream.add(
+        std::make_unique<SessionSampleSource>(reader, DebugLogRecord::INERTIAL_MEASUREMENTS));
+      stream.add(std::make_unique<SessionSampleSource>(reader, DebugLogRecord::LINEAR_SPEED));
+      stream.add(std::make_unique<SessionSampleSource>(reader, DebugLogRecord::ATTITUDE_ANGLES));
+    }
+    if (arguments.count("--inertial-measurements")) {
+      stream.add(std::make_unique<CsvSampleSource>(
+          arguments["--inertial-measurements"], DebugLogRecord::INERTIAL_MEASUREMENTS, 6));
+    }
+    if (arguments.count("--linear-speeds")) {
+      stream.add(std::make_unique<CsvSampleSource>(
+          arguments["--linear-speeds"], DebugLogRecord::LINEAR_SPEED, 1));
+    }
+    if (arguments.count("--attitudes")) {
+      stream.add(std::make_unique<CsvSampleSource>(
+          arguments["--attitudes"], DebugLogRecord::ATTITUDE_ANGLES, 3));
+    }
+
+    bool hasOutput = arguments.count("--output") != 0;
+    std::ofstream angularSpeedsFile;
+    std::ofstream attitudesFile;
+    std::ofstream diagnosticsFile;
+    if (hasOutput) {
+      const std::string & prefix = arguments["--output"];
+      angularSpeedsFile = openOutput(
+        prefix + "_angular_speeds.csv", "stamp,angular_speed,variance");
+      attitudesFile = openOutput(prefix + "_attitudes.csv", "stamp,roll,pitch,variance");
+      diagnosticsFile = openOutput(prefix + "_diagnostics.csv", "stamp,status,message");
+    }
+
+    std::unique_ptr<romea::core::SessionWriter> sessionWriter;
+    if (arguments.count("--write-session")) {
+      sessionWriter = std::make_unique<romea::core::SessionWriter>(arguments["--write-session"]);
+    }
+
+    Duration diagnosticPeriod = romea::core::durationFromSecond(
+      arguments.count("--diagnostic-period") ? std::stod(arguments["--diagnostic-period"]) : 1.);
+
+    auto writeDiagnostics = [&](const Duration & stamp) {
+        romea::core::DiagnosticReport report = plugin.makeDiagnosticReport(stamp);
+        if (hasOutput) {
+          for (const auto & diagnostic : report.diagnostics) {
+            writeStamp(diagnosticsFile, stamp) << "," << toString(diagnostic.status) << "," <<
+              diagnostic.message << "\n";
+          }
+        }
+      };
+
+    size_t numberOfSamples = 0;
+    size_t numberOfAngularSpeeds = 0;
+    size_t numberOfAttitudes = 0;
+    Duration firstStamp(0);
+    Duration lastStamp(0);
+    Duration nextDiagnosticStamp(0);
+
+    bool isFloatAngularSpeedValid = false;
+    size_t numberOfFloatMismatches = 0;
+    double floatDeviation = 0.;
+
+    romea::core::ObservationAngularSpeed angularSpeed;
+    romea::core::ObservationAngularSpeed floatAngularSpeed;
+    romea::core::ObservationAttitude attitude;
+    auto start = std::chrono::steady_clock::now();
+
+    Sample sample;
+    while (stream.read(sample)) {
+      Duration stamp(sample.stamp);
+      if (numberOfSamples++ == 0) {
+        firstStamp = stamp;
+        nextDiagnosticStamp = stamp + diagnosticPeriod;
+      }
+      lastStamp = stamp;
+
+      if (stamp >= nextDiagnosticStamp) {
+        writeDiagnostics(stamp);
+        nextDiagnosticStamp += diagnosticPeriod * ((stamp - nextDiagnosticStamp) /
+          diagnosticPeriod + 1);
+      }
+
+      const double * values = sample.values;
+      switch (sample.type) {
+        case DebugLogRecord::LINEAR_SPEED:
+          plugin.processLinearSpeed(stamp, values[0]);
+          if (floatPlugin) {
+            floatPlugin->processLinearSpeed(stamp, values[0]);
+          }
+          if (sessionWriter) {
+            sessionWriter->addLinearSpeed(stamp, values[0]);
+          }
+          break;
+        case DebugLogRecord::INERTIAL_MEASUREMENTS:
+          if (sessionWriter) {
+            sessionWriter->addInertialMeasurements(
+              stamp, values[0], values[1], values[2], values[3], values[4], values[5]);
+          }
+          if (floatPlugin) {
+            isFloatAngularSpeedValid = floatPlugin->computeAngularSpeed(
+              stamp, values[0], values[1], values[2], values[3], values[4], values[5],
+              floatAngularSpeed);
+          }
+          if (plugin.computeAngularSpeed(
+              stamp, values[0], values[1], values[2], values[3], values[4], values[5],
+              angularSpeed))
+          {
+            ++numberOfAngularSpeeds;
+            if (hasOutput) {
+              writeStamp(angularSpeedsFile, stamp) << "," << angularSpeed.Y() << "," <<
+                angularSpeed.R() << "\n";
+            }
+            if (isFloatAngularSpeedValid) {
+              floatDeviation = std::max(
+                floatDeviation, std::abs(angularSpeed.Y() - floatAngularSpeed.Y()));
+            } else if (floatPlugin) {
+              ++numberOfFloatMismatches;
+            }
+          } else if (isFloatAngularSpeedValid) {
+            ++numberOfFloatMismatches;
+          }
+          break;
+        case DebugLogRecord::ATTITUDE_ANGLES:
+          if (sessionWriter) {
+            sessionWriter->addAttitude(stamp, values[0], values[1], values[2]);
+          }
+          if (plugin.computeAttitude(stamp, values[0], values[1], values[2], attitude)) {
+            ++numberOfAttitudes;
+            if (hasOutput) {
+              writeStamp(attitudesFile, stamp) << "," <<
+                attitude.Y(romea::core::ObservationAttitude::ROLL) << "," <<
+                attitude.Y(romea::core::ObservationAttitude::PITCH) << "," <<
+                attitude.R()(0, 0) << "\n";
+            }
+          }
+          break;
+        default:
+          break;
+      }
+    }
+
+    if (numberOfSamples != 0) {
+      writeDiagnostics(lastStamp);
+    }
+
+    if (sessionWriter) {
+      sessionWriter->close();
+    }
+
+    std::chrono::duration<double> elapsedDuration = std::chrono::steady_clock::now() - start;
+    double elapsed = elapsedDuration.count();
+    double recorded = romea::core::durationToSecond(lastStamp - firstStamp);
+    std::cout << "replayed samples: " << numberOfSamples << "\n";
+    std::cout << "recorded duration: " << recorded << " s\n";
+    std::cout << "replay duration: " << elapsed << " s\n";
+    std::cout << "throughput: " << numberOfSamples / elapsed << " samples/s\n";
+    std::cout << "real time factor: " << recorded / elapsed << "\n";
+    std::cout << "angular speed observations: " << numberOfAngularSpeeds << "\n";
+    std::cout << "attitude observations: " << numberOfAttitudes << "\n";
+
+    if (floatPlugin) {
+      std::cout << "float validity mismatches: " << numberOfFloatMismatches << "\n";
+      std::cout << "float angular speed deviation: " << floatDeviation << " rad/s\n";
+      if (numberOfFloatMismatches != 0 || floatDeviation > floatTolerance) {
+        std::cerr << "float angular speeds exceed tolerance of " << floatTolerance <<
+          " rad/s" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  } catch (const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}